@@ -146,11 +146,12 @@ std::shared_ptr<CsrHdMatrix<T>> SparseHamiltonian(const VT<PauliTerm<T>> &hams,
     return sp_hams[0];
 }
 
+// Write a * vec into out, which holds a->dim_ elements and does not alias vec.
 template <typename T, typename T2>
-T2 *Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, T2 *vec) {
+void Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, const T2 *vec, T2 *out) {
     auto dim = a->dim_;
-    auto c_vec = reinterpret_cast<CTP<T2>>(vec);
-    auto new_vec = reinterpret_cast<CTP<T2>>(malloc(sizeof(CT<T2>) * dim));
+    auto c_vec = reinterpret_cast<const CT<T2> *>(vec);
+    auto new_vec = reinterpret_cast<CTP<T2>>(out);
     auto data = a->data_;
     auto indptr = a->indptr_;
     auto indices = a->indices_;
@@ -162,7 +163,13 @@ T2 *Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, T2 *vec) {
             }
             new_vec[i] = sum;
         })
-    return reinterpret_cast<T2 *>(new_vec);
+}
+
+template <typename T, typename T2>
+T2 *Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, T2 *vec) {
+    auto new_vec = reinterpret_cast<T2 *>(malloc(sizeof(CT<T2>) * a->dim_));
+    Csr_Dot_Vec<T, T2>(a, vec, new_vec);
+    return new_vec;
 }
 
 template <typename T, typename T2>
@@ -189,11 +196,12 @@ CT<T2> ExpectationOfCsr(std::shared_ptr<CsrHdMatrix<T>> a, T2 *bra, T2 *ket) {
     return {res_real, res_imag};
 }
 
+// Write (a + b) * vec into out, which holds a->dim_ elements and does not alias vec.
 template <typename T, typename T2>
-T2 *Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, std::shared_ptr<CsrHdMatrix<T>> b, T2 *vec) {
+void Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, std::shared_ptr<CsrHdMatrix<T>> b, const T2 *vec, T2 *out) {
     auto dim = a->dim_;
-    auto c_vec = reinterpret_cast<CTP<T2>>(vec);
-    auto new_vec = reinterpret_cast<CTP<T2>>(malloc(sizeof(CT<T2>) * dim));
+    auto c_vec = reinterpret_cast<const CT<T2> *>(vec);
+    auto new_vec = reinterpret_cast<CTP<T2>>(out);
     auto data = a->data_;
     auto indptr = a->indptr_;
     auto indices = a->indices_;
@@ -212,7 +220,13 @@ T2 *Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, std::shared_ptr<CsrHdMatrix<T
             }
             new_vec[i] = sum;
         })
-    return reinterpret_cast<T2 *>(new_vec);
+}
+
+template <typename T, typename T2>
+T2 *Csr_Dot_Vec(std::shared_ptr<CsrHdMatrix<T>> a, std::shared_ptr<CsrHdMatrix<T>> b, T2 *vec) {
+    auto new_vec = reinterpret_cast<T2 *>(malloc(sizeof(CT<T2>) * a->dim_));
+    Csr_Dot_Vec<T, T2>(a, b, vec, new_vec);
+    return new_vec;
 }
 
 template <typename T, typename T2>
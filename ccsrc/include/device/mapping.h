@@ -17,6 +17,7 @@
 #ifndef MINDQUANTUM_DEVICE_MAPPING_HPP_
 #define MINDQUANTUM_DEVICE_MAPPING_HPP_
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <set>
@@ -37,6 +38,26 @@ struct Gate {
     }
 };
 
+/**
+ * @brief Statistics of one independent trial of qubit mapping.
+ */
+struct TrialResult {
+    uint64_t seed;  // seed of random initial mapping of this trial
+    int num_swap;   // number of SWAP gates inserted
+    int num_gates;  // number of gates in physical circuit
+    int depth;      // depth of physical circuit
+};
+
+/**
+ * @brief Get the statistics of a physical circuit
+ *
+ * @param gates physical circuit from left to right
+ * @param num_physical number of physical qubits
+ * @param seed seed of the trial that generates this circuit
+ * @return TrialResult statistics of the physical circuit
+ */
+TrialResult GetTrialResult(const VT<Gate>& gates, int num_physical, uint64_t seed);
+
 std::pair<qbit_t, VT<Gate>> GateToAbstractGate(const VT<std::shared_ptr<BasicGate>>& gates);
 
 /**
@@ -56,13 +77,16 @@ class MQ_SABRE {
     VT<Gate> gates;  // logical circuit
 
     VT<VT<int>> DAG;   // DAG of logical circuit
+    VT<VT<int>> RDAG;  // reverse graph of DAG
+
+    std::shared_ptr<const TopologyCSR> G;  // physical coupling graph
 
-    VT<VT<int>> G;   // physical coupling graph
+    std::shared_ptr<const DistanceMatrix<int>> D;  // nearest neighbor cost, shared with the coupling graph
 
-    VT<VT<int>> D;  // nearest neighbor cost
+    VT<TrialResult> trial_results;  // statistics of every trial of last Solve
 
     VT<VT<int>> Gw;  // interaction weight graph
-    VT<VT<int>> Dw;  // nearest neighbor cost
+    DistanceMatrix<int> Dw;  // nearest neighbor cost
 
     VT<VT<int>> Go;  // interaction order graph  
 
@@ -71,10 +95,12 @@ class MQ_SABRE {
      * @brief calculate center of graph
      *
      * @param graph The graph to be computed
+     * @param n The number of nodes of graph
      * 
      * @return the center node of graph
      */    
-   int CalGraphCenter(const VT<VT<int>>& graph);
+   template <typename Graph>
+   int CalGraphCenter(const Graph& graph, int n);
 
    /**
      * @brief Preliminary matching result between logical and physical lines
@@ -163,9 +189,9 @@ class MQ_SABRE {
     double W;         //  parameter W
     VT<VT<double>> SWAP_success_rate;     //The correct rate of the swap gates
     VT<VT<double>> SWAP_gate_length;      //The length of the swap gates
-    VT<VT<double>> Kesi;                  // The success rate of a CNOT between the physical qubits Qi and Qj
-    VT<VT<double>> T;                     // The length of a CNOT between the physical qubits Qi and Qj
-    VT<VT<double>> DM;  //distance matrix
+    DistanceMatrix<double> Kesi;          // The success rate of a CNOT between the physical qubits Qi and Qj
+    DistanceMatrix<double> T;             // The length of a CNOT between the physical qubits Qi and Qj
+    DistanceMatrix<double> DM;  //distance matrix
  public:
     VT<VT<double>> CNOT_error_rate;       //The error rate of the cnot gates
     VT<VT<double>> CNOT_gate_length;      //The length of the cnot gates
@@ -184,34 +210,53 @@ class MQ_SABRE {
     /**
      * @brief solve qubit mapping problem
      *
-     * @param iter_num iterate times to update random initial mapping
+     * The first trial starts from the initial mapping of interaction graph, every other trial t starts from a random
+     * mapping shuffled with seed + t and refined by a forward and a backward search. Trials run in parallel threads.
+     * If layout_time_limit is positive, layouts without any SWAP gate are searched by PerfectLayout within this time
+     * budget and the one with lowest total DM of its CNOT gates is used directly, no trial is run then.
+     *
      * @param W parameter to hearistic
      * @param alpha1 the coefficient of matrix DM
      * @param alpha2 the coefficient of matrix Kesi
      * @param alpha3 the coefficient of matrix T
+     * @param num_trials number of independent trials
+     * @param seed seed of random initial mapping
+     * @param prefer_depth select the trial with lowest depth instead of fewest SWAP gates
+     * @param layout_time_limit time budget in seconds of searching a layout without SWAP gate, 0 to disable
      * @return pair<vector<Gate>, pair<vector<int>, vector<int>>>
-     *      (gs, (pi0, pi1)), gs is generated physical circuit,
+     *      (gs, (pi0, pi1)) of the best trial, gs is generated physical circuit,
      *                        pi0 is initial mapping from logical to physical
      *                        pi1 is final mapping from logical to physical
      */
-    std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> Solve(double W, double alpha1, double alpha2,double alpha3);
+    std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> Solve(double W, double alpha1, double alpha2, double alpha3,
+                                                              int num_trials = 1, uint64_t seed = 42,
+                                                              bool prefer_depth = false,
+                                                              double layout_time_limit = 0.0);
     inline void SetParameters(double W, double alpha1, double alpha2, double alpha3);
+
+    /**
+     * @brief Get the statistics of every trial of last Solve
+     */
+    const VT<TrialResult>& GetTrialResults() const;
 };
 
 class SABRE {
  private:
     int num_logical;
     int num_physical;
-    VT<Gate> gates;  // logical circuit
-    VT<VT<int>> G;   // physical coupling graph
+    VT<Gate> gates;     // logical circuit
+    VT<bool> is_cnot;   // whether gates[i] is CNOT gate
+    std::shared_ptr<const TopologyCSR> G;  // physical coupling graph
 
     VT<VT<int>> DAG;   // DAG of logical circuit
     VT<VT<int>> RDAG;  // reverse graph of DAG
 
-    VT<VT<int>> D;  // nearest neighbor cost
+    std::shared_ptr<const DistanceMatrix<int>> D;  // nearest neighbor cost, shared with the coupling graph
 
     VT<int> decay;  // decay of each logical qubit
 
+    VT<TrialResult> trial_results;  // statistics of every trial of last Solve
+
     double W;       // parameter between F and E
     double delta1;  // decay of a single gate
     double delta2;  // decay of a CNOT gate
@@ -238,61 +283,51 @@ class SABRE {
      *   If edge (x,z) in G and gate (x,y) in F, then SWAP (x,z) is possible.
      * @param F current front layer
      * @param pi current mapping from logical to physical
-     * @return set<pair<int, int>> set of candidate SWAP list, containing physical id.
+     * @param in_front whether a physical qubit holds a qubit of gates in F
+     * @param SWAPs candidate SWAP list without duplicates, containing physical id.
      */
-    std::set<std::pair<int, int>> ObtainSWAPs(const std::list<int>& F, const VT<int>& pi) const;
+    void ObtainSWAPs(const VT<int>& F, const VT<int>& pi, const VT<bool>& in_front,
+                     VT<std::pair<int, int>>* SWAPs) const;
 
     /**
      * @brief Get the next layer of F in DAG, only considering CNOT gates.
      *   Single gates can always be executed, so there is no need to consider.
      * @param F current front layer
      * @param DAG
-     * @param indeg current in-degree of DAG
-     * @return list<int> the next layer of F, ignoring single gates.
+     * @param indeg current in-degree of DAG, restored before return
+     * @return vector<int> the next layer of F, ignoring single gates.
      */
-    std::list<int> GetNextLayer(const std::list<int>& F, const VT<VT<int>>& DAG, const VT<int>& indeg) const;
+    VT<int> GetNextLayer(const VT<int>& F, const VT<VT<int>>& DAG, VT<int>* indeg) const;
 
     /**
      * @brief Get the extended set E
      *   There are many ways to generate E. Here we just use the next layer of F.
      * @param F current front layer
      * @param DAG
-     * @param indeg current in-degree of DAG
-     * @return list<int> extended set E
+     * @param indeg current in-degree of DAG, restored before return
+     * @return vector<int> extended set E
      */
-    std::list<int> GetExtendedSet(const std::list<int>& F, const VT<VT<int>>& DAG, const VT<int>& indeg) const;
+    VT<int> GetExtendedSet(const VT<int>& F, const VT<VT<int>>& DAG, VT<int>* indeg) const;
 
     /**
      * @brief basic heuristic function
      *      H = \sum_{g\in F} D[pi[g.q1]][pi[g.q2]]
      * @param F set of gates' id
      * @param pi mapping from logical to physical
-     * @return double
-     */
-    double HBasic(const std::list<int>& F, const VT<int>& pi) const;
-
-    /**
-     * @brief heuristic function considering extended set E
-     *   H = 1 / |F| * HBasic(F, pi) + W / |E| * HBasic(E, pi)
-     * @param F current front layer
-     * @param E extended set
-     * @param pi mapping from logical to physical
-     * @return double
+     * @return int
      */
-    double HLookAhead(const std::list<int>& F, const std::list<int>& E, const VT<int>& pi) const;
+    int HBasic(const VT<int>& F, const VT<int>& pi) const;
 
     /**
-     * @brief heuristic function considering trade-off between circuit depth and gates number.
-     *
-     * @param F current front layer
-     * @param E extended set
+     * @brief change of HBasic when logical qubits p and q are swapped.
+     *   Only gates on p or q change their distance, so it does not depend on the size of layer.
+     * @param on gates of the layer acting on every logical qubit
      * @param pi mapping from logical to physical
-     * @param SWAP physical SWAP, using logical id
-     * @param decay decay of logical qubits
-     * @return double
+     * @param p logical qubit
+     * @param q logical qubit
+     * @return int
      */
-    double H(const std::list<int>& F, const std::list<int>& E, const VT<int>& pi, const std::pair<int, int>& SWAP,
-             const VT<double>& decay) const;
+    int HBasicDelta(const VT<VT<int>>& on, const VT<int>& pi, int p, int q) const;
 
  public:
     /**
@@ -325,18 +360,35 @@ class SABRE {
     /**
      * @brief solve qubit mapping problem
      *
+     * Every trial t starts from a random initial mapping shuffled with seed + t, so that a single trial can be
+     * reproduced with its own seed. Trials run in parallel threads.
+     * If layout_time_limit is positive and a layout without any SWAP gate is found by PerfectLayout within this time
+     * budget, it is used directly and no trial is run.
+     *
      * @param iter_num iterate times to update random initial mapping
      * @param W parameter to look-ahead
      * @param delta1 decay of single gate
      * @param delta2 decay of CNOT gate, decay of SWAP will be 3*delta2
+     * @param num_trials number of independent trials
+     * @param seed seed of random initial mapping
+     * @param prefer_depth select the trial with lowest depth instead of fewest SWAP gates
+     * @param layout_time_limit time budget in seconds of searching a layout without SWAP gate, 0 to disable
      * @return pair<vector<Gate>, pair<vector<int>, vector<int>>>
-     *      (gs, (pi0, pi1)), gs is generated physical circuit,
+     *      (gs, (pi0, pi1)) of the best trial, gs is generated physical circuit,
      *                        pi0 is initial mapping from logical to physical
      *                        pi1 is final mapping from logical to physical
      */
-    std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> Solve(int iter_num, double W, double delta1, double delta2);
+    std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> Solve(int iter_num, double W, double delta1, double delta2,
+                                                              int num_trials = 1, uint64_t seed = 42,
+                                                              bool prefer_depth = false,
+                                                              double layout_time_limit = 0.0);
 
     inline void SetParameters(double W, double delta1, double delta2);
+
+    /**
+     * @brief Get the statistics of every trial of last Solve
+     */
+    const VT<TrialResult>& GetTrialResults() const;
 };
 }  // namespace mindquantum::mapping
 #endif
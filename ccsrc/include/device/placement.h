@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDQUANTUM_DEVICE_PLACEMENT_HPP_
+#define MINDQUANTUM_DEVICE_PLACEMENT_HPP_
+
+#include <utility>
+
+#include "device/topology.h"
+
+namespace mindquantum::mapping {
+/**
+ * @brief Find a layout where every pair of interacting logical qubits sits on coupled physical qubits, so that the
+ *   circuit can be executed without any SWAP gate.
+ *
+ * The interaction graph is embedded into the coupling graph by a VF2++ style subgraph monomorphism search. Logical
+ * qubits are matched in BFS order starting from the one with the largest degree, preferring those with most matched
+ * neighbours, and candidates are pruned by degree, by adjacency to matched neighbours and by the number of free
+ * neighbours.
+ *
+ * Without cost the first layout found is returned. With cost the search goes on through all layouts until the
+ * time budget is exhausted, and the one with lowest total cost of its two qubits gates is returned.
+ *
+ * @param num_logical number of logical qubits
+ * @param interactions pairs of logical qubits acted on by one two qubits gate
+ * @param topology compiled coupling graph
+ * @param time_limit time budget of the search in seconds, no search is done if it is not positive
+ * @param cost cost of a two qubits gate between every pair of physical qubits, nullptr to take the first layout
+ * @return VT<int> mapping from logical to physical of size topology.Size(), indices not smaller than num_logical
+ *   take the unused physical qubits in ascending order. Empty if no layout is found within the time budget.
+ */
+VT<int> PerfectLayout(int num_logical, const VT<std::pair<int, int>>& interactions, const TopologyCSR& topology,
+                      double time_limit, const DistanceMatrix<double>* cost = nullptr);
+}  // namespace mindquantum::mapping
+#endif
@@ -17,6 +17,7 @@
 #ifndef MINDQUANTUM_DEVICE_TOPOLOGY_HPP_
 #define MINDQUANTUM_DEVICE_TOPOLOGY_HPP_
 #include <algorithm>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
@@ -75,6 +76,74 @@ struct QubitNode : std::enable_shared_from_this<QubitNode> {
 
 // =============================================================================
 
+// Hop distance of two qubits that are not connected.
+constexpr int unreachable_distance = 1000000000;
+
+// Square matrix of distances between every pair of nodes, stored row major in a flat contiguous vector.
+template <typename T>
+struct DistanceMatrix {
+    int n = 0;
+    VT<T> data = {};
+
+    DistanceMatrix() = default;
+    DistanceMatrix(int n, T value) : n(n), data(static_cast<size_t>(n) * n, value) {
+    }
+
+    // dist[i][j] is the distance from node i to node j.
+    T* operator[](int i) {
+        return data.data() + static_cast<size_t>(i) * n;
+    }
+    const T* operator[](int i) const {
+        return data.data() + static_cast<size_t>(i) * n;
+    }
+};
+
+// Shortest path lengths of a complete directed graph with non-negative weights, where most pairs weigh background and
+// only the others are real edges, computed by Dijkstra from every node in parallel. The result is the same as Floyd
+// algorithm on weight, including the shortest cycle through every node on diagonal.
+template <typename T>
+DistanceMatrix<T> ShortestPaths(const DistanceMatrix<T>& weight, T background);
+
+// Immutable compiled snapshot of a topology in compressed sparse row format, for hot loops of routers and placement
+// algorithms. Qubits are renumbered densely in ascending order of their id.
+struct TopologyCSR {
+    // Contiguous range of neighbours of a qubit.
+    struct Range {
+        const int* first;
+        const int* last;
+        const int* begin() const {
+            return first;
+        }
+        const int* end() const {
+            return last;
+        }
+    };
+
+    VT<qbit_t> ids = {};                   // qubit id of every dense index
+    VT<int> index = {};                    // dense index of every qubit id up to the largest one, -1 if missing
+    VT<int> offsets = {0};                 // neighbours of i are in [offsets[i], offsets[i + 1])
+    VT<int> neighbours = {};               // dense index of neighbours, ascending for every qubit
+    VT<int> edge_of = {};                  // edge index of every entry of neighbours
+    VT<std::pair<int, int>> edges = {};    // edges (i, j) with i < j in ascending order
+
+    int Size() const {
+        return static_cast<int>(ids.size());
+    }
+    int Degree(int i) const {
+        return offsets[i + 1] - offsets[i];
+    }
+    Range Neighbours(int i) const {
+        return {neighbours.data() + offsets[i], neighbours.data() + offsets[i + 1]};
+    }
+    // Index of edge between i and j in edges, -1 if they are not coupled.
+    int EdgeIndex(int i, int j) const;
+    bool IsCoupled(int i, int j) const {
+        return EdgeIndex(i, j) >= 0;
+    }
+};
+
+// =============================================================================
+
 class QubitsTopology {
  public:
     QubitsTopology() = default;
@@ -106,8 +175,22 @@ class QubitsTopology {
     }
     std::unordered_map<qbit_t, QNodePtr> Dict();
 
+    // Hop distances between every pair of qubits indexed by qubit id, unreachable_distance if they are not connected.
+    // Computed by BFS from every qubit in parallel, and cached until a qubit or an edge of any topology changes, so
+    // that routing many circuits on one device only pays for it once.
+    std::shared_ptr<const DistanceMatrix<int>> HopDistances();
+
+    // Compressed sparse row snapshot of this topology, cached in the same way as HopDistances.
+    std::shared_ptr<const TopologyCSR> Compile();
+
  protected:
     std::unordered_map<qbit_t, QNodePtr> qubits;
+
+ private:
+    std::shared_ptr<const DistanceMatrix<int>> hop_distances = nullptr;
+    uint64_t hop_distances_version = 0;
+    std::shared_ptr<const TopologyCSR> csr = nullptr;
+    uint64_t csr_version = 0;
 };
 
 class LinearQubits : public QubitsTopology {
@@ -137,9 +137,9 @@ struct SingleFermionStr {
 
     static std::tuple<tn::Tensor, uint64_t> MulSingleCompressTerm(uint64_t a, uint64_t b);
     static bool InplaceMulCompressTerm(const term_t& term, compress_term_t& fermion);
-    static compress_term_t Mul(const compress_term_t& lhs, const compress_term_t& rhs);
+    static compress_term_t Mul(const term_view_t& lhs, const term_view_t& rhs);
     static bool IsSameString(const key_t& k1, const key_t& k2);
-    static std::string GetString(const compress_term_t& fermion);
+    static std::string GetString(const term_view_t& fermion);
     static term_t ParseToken(const std::string& token);
     static std::vector<uint64_t> NumOneMask(const compress_term_t& fermion);
     static uint64_t PrevOneMask(const std::vector<uint64_t>& one_mask, size_t idx);
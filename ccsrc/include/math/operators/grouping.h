@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MATH_OPERATORS_GROUPING_H_
+#define MATH_OPERATORS_GROUPING_H_
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "math/operators/qubit_operator_view.h"
+
+namespace operators {
+//! Clifford gate of a measurement basis rotation, name is one of H, Sdag, CNOT and CZ.
+struct BasisGate {
+    std::string name;
+    size_t obj;
+    std::vector<size_t> ctrls;
+};
+
+//! Terms of a qubit operator that can be measured with a single basis rotation.
+struct MeasureGroup {
+    //! Index of every term in QubitOperator::get_terms().
+    std::vector<size_t> terms;
+    //! Gates to apply in order before measuring all qubits in Z basis.
+    std::vector<BasisGate> rotation;
+    //! After rotation, every term is the Z parity of these qubits ...
+    std::vector<std::vector<size_t>> z_qubits;
+    //! ... multiplied by this sign, +1 or -1.
+    std::vector<int> signs;
+};
+
+/*!
+ * \brief Partition the terms of a qubit operator into simultaneously measurable groups.
+ *
+ * Terms are packed into X and Z bit masks. If qubit_wise is true, two terms are compatible when they act with the
+ * same pauli operator on every qubit they share, otherwise when they commute. For operators with at most 16384
+ * terms, the conflict graph is built as bitset adjacency in parallel and coloured with DSATUR. Larger operators are
+ * coloured greedily in term order, where a term is checked against a summary of every group, the union basis for
+ * qubit wise groups and the independent generators for commuting groups.
+ */
+std::vector<MeasureGroup> GroupCommutingTerms(const qubit::QubitOperator& ops, bool qubit_wise = true);
+
+//! Conjugate a pauli string given by X and Z bits and sign bit r by a basis gate, as in a stabilizer tableau.
+void ConjugatePauli(const BasisGate& gate, std::vector<uint8_t>* x, std::vector<uint8_t>* z, uint8_t* r);
+
+/*!
+ * \brief Clifford basis rotation that maps independent commuting pauli strings to Z strings.
+ *
+ * Pauli strings are given by their X and Z bits on every qubit and written as a tableau. Hadamards make the X block
+ * full rank, CNOTs reduce it to identity on its pivot qubits, CZs and Sdags clear the Z block, and the last Hadamards
+ * turn the remaining X on pivot qubits into Z. After the rotation, the given strings span the same group as single Z
+ * operators on the pivot qubits, which are written to pivots if it is not null.
+ */
+std::vector<BasisGate> CommutingRotation(std::vector<std::vector<uint8_t>> xs, std::vector<std::vector<uint8_t>> zs,
+                                         std::vector<size_t>* pivots = nullptr);
+}  // namespace operators
+#endif /* MATH_OPERATORS_GROUPING_H_ */
@@ -101,10 +101,12 @@ struct SinglePauliStr {
     static constexpr uint64_t M_B = 6148914691236517205;
     static constexpr uint64_t M_A = M_B << 1;
     static std::tuple<tn::Tensor, uint64_t> MulSingleCompressTerm(uint64_t a, uint64_t b);
+    //! Product of two compressed words, the phase is returned as a power of imaginary unit in [0, 4).
+    static uint64_t MulSingleCompressTerm(uint64_t a, uint64_t b, int* phase);
     static void InplaceMulCompressTerm(const term_t& term, compress_term_t& pauli);
-    static compress_term_t Mul(const compress_term_t& lhs, const compress_term_t& rhs);
+    static compress_term_t Mul(const term_view_t& lhs, const term_view_t& rhs);
     static bool IsSameString(const key_t& k1, const key_t& k2);
-    static std::string GetString(const compress_term_t& pauli);
+    static std::string GetString(const term_view_t& pauli);
     static term_t ParseToken(const std::string& token);
     static term_t py_term_to_term(const py_term_t& term);
     static terms_t py_terms_to_terms(const py_terms_t& terms);
@@ -124,6 +126,9 @@ class QubitOperator {
  private:
     bool Contains(const key_t& term) const;
     void Update(const compress_term_t& pauli);
+    //! Product of two operators with numeric coefficients, generated in parallel and reduced by sorting.
+    //! Terms with coefficient magnitude not above tol are dropped, the default of zero drops exact zeros only.
+    void NumericMulInplace(const QubitOperator& other, double tol = 0);
 
     // -----------------------------------------------------------------------------
 
@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MATH_OPERATORS_SERIALIZATION_H_
+#define MATH_OPERATORS_SERIALIZATION_H_
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "math/operators/fermion_operator_view.h"
+#include "math/operators/qubit_operator_view.h"
+#include "math/operators/utils.h"
+#include "math/tensor/traits.h"
+
+/*!
+ * Binary format of qubit and fermion operators, all integers are in host byte order.
+ *
+ * The file starts with a 64 bytes header, followed by one record per term and an index of the byte offset of every
+ * record. A record is the number of key words and parameters as two uint32, the compressed key of term, the constant
+ * coefficient and then every parameter as name length, flags, name and value. Every field is padded to 8 bytes, so
+ * that keys can be read in place from a memory mapped file.
+ */
+namespace operators::serialization {
+namespace tn = tensor;
+
+enum class OperatorKind : uint8_t {
+    Qubit = 0,
+    Fermion = 1,
+};
+
+struct FileHeader {
+    static constexpr char magic_value[8] = {'M', 'Q', 'O', 'P', 'B', 'I', 'N', '\0'};
+    static constexpr uint32_t current_version = 1;
+    static constexpr uint32_t endian_tag = 0x01020304;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    //! OperatorKind of operator.
+    uint8_t kind;
+    //! tensor::TDtype of coefficients.
+    uint8_t dtype;
+    //! Whether any coefficient has parameters.
+    uint8_t parameterized;
+    uint8_t reserved[5];
+    uint64_t n_terms;
+    uint64_t index_offset;
+    uint64_t reserved_words[3];
+};
+static_assert(sizeof(FileHeader) == 64, "Header of operator file should be 64 bytes.");
+
+/*!
+ * \brief Write terms of an operator to file one by one.
+ *
+ * Only the record offsets are kept in memory, the header is patched when the writer is closed.
+ */
+class OperatorWriter {
+ public:
+    OperatorWriter(const std::string& filename, OperatorKind kind, tn::TDtype dtype);
+    OperatorWriter(const OperatorWriter&) = delete;
+    OperatorWriter& operator=(const OperatorWriter&) = delete;
+    ~OperatorWriter();
+
+    //! Append a term, the coefficient is casted to dtype of file.
+    void Append(const key_t& key, const value_t& value);
+    //! Write index and header, throw std::runtime_error if file can not be written.
+    void Close();
+
+ private:
+    void Write(const void* data, size_t len);
+
+    std::ofstream file;
+    FileHeader header{};
+    std::vector<uint64_t> offsets;
+    uint64_t pos = 0;
+    bool closed = false;
+};
+
+void Save(const qubit::QubitOperator& ops, const std::string& filename);
+void Save(const fermion::FermionOperator& ops, const std::string& filename);
+
+/*!
+ * \brief Read only view of an operator file.
+ *
+ * The file is memory mapped, keys of terms point into the mapping and coefficients are only decoded when asked
+ * for, so that several processes can share one operator file without materializing it. On platforms without mmap,
+ * the file is read into memory instead.
+ */
+class OperatorFile {
+ public:
+    //! A term inside of the file, key points into the mapping.
+    struct Term {
+        const uint64_t* key;
+        size_t n_word;
+        const OperatorFile* file;
+        const char* coeff;
+        size_t n_param;
+
+        key_t Key() const {
+            return key_t(key, key + n_word);
+        }
+        value_t Value() const;
+    };
+
+    class Iterator {
+     public:
+        Iterator(const OperatorFile* file, size_t idx) : file(file), idx(idx) {
+        }
+        Term operator*() const {
+            return (*file)[idx];
+        }
+        Iterator& operator++() {
+            ++idx;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const {
+            return idx == other.idx;
+        }
+        bool operator!=(const Iterator& other) const {
+            return idx != other.idx;
+        }
+
+     private:
+        const OperatorFile* file;
+        size_t idx;
+    };
+
+    explicit OperatorFile(const std::string& filename);
+    OperatorFile(const OperatorFile&) = delete;
+    OperatorFile& operator=(const OperatorFile&) = delete;
+    ~OperatorFile();
+
+    OperatorKind Kind() const {
+        return static_cast<OperatorKind>(header->kind);
+    }
+    tn::TDtype GetDtype() const {
+        return static_cast<tn::TDtype>(header->dtype);
+    }
+    bool Parameterized() const {
+        return header->parameterized != 0;
+    }
+    size_t size() const {
+        return header->n_terms;
+    }
+    //! Term at given index, throw std::out_of_range if index is invalid.
+    Term operator[](size_t idx) const;
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
+    Iterator end() const {
+        return Iterator(this, size());
+    }
+
+    //! Materialize the file as operator, throw std::runtime_error if kind of file is different.
+    qubit::QubitOperator ToQubitOperator() const;
+    fermion::FermionOperator ToFermionOperator() const;
+
+    //! Single term operator at given index, throw std::runtime_error if kind of file is different.
+    qubit::QubitOperator QubitTerm(size_t idx) const;
+    fermion::FermionOperator FermionTerm(size_t idx) const;
+
+ private:
+    //! Unmap the file.
+    void Release();
+
+    const char* data = nullptr;
+    size_t length = 0;
+    const FileHeader* header = nullptr;
+    const uint64_t* index = nullptr;
+    std::vector<uint64_t> buffer;
+    bool mapped = false;
+};
+}  // namespace operators::serialization
+#endif /* MATH_OPERATORS_SERIALIZATION_H_ */
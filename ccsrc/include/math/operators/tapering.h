@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MATH_OPERATORS_TAPERING_H_
+#define MATH_OPERATORS_TAPERING_H_
+#include <vector>
+
+#include "math/operators/grouping.h"
+#include "math/operators/qubit_operator_view.h"
+
+namespace operators {
+//! Z2 symmetries of a qubit operator and the Clifford rotation that maps them onto single qubits.
+struct Z2Symmetries {
+    //! Independent pauli strings that commute with every term of operator and with each other.
+    std::vector<qubit::QubitOperator> generators;
+    //! Gates to apply in order, after which generator i becomes signs[i] times Z on qubits[i].
+    std::vector<BasisGate> rotation;
+    std::vector<size_t> qubits;
+    std::vector<int> signs;
+};
+
+/*!
+ * \brief Find Z2 symmetries of a qubit operator.
+ *
+ * Every term is packed as a binary row of its Z and X masks, so that the kernel of these rows over GF(2) are the pauli
+ * strings that commute with every term. The rows are reduced by Gaussian elimination in parallel blocks, and the
+ * kernel is made commuting with symplectic Gram-Schmidt, which keeps one string of every anticommuting pair.
+ */
+Z2Symmetries FindZ2Symmetries(const qubit::QubitOperator& ops);
+
+/*!
+ * \brief Taper off the qubits of Z2 symmetries from a qubit operator.
+ *
+ * Every term is conjugated by the rotation of symmetries, Z on the qubit of a generator is replaced by the
+ * eigenvalue of this generator in sector, and the remaining qubits are relabeled in order. The operator should
+ * commute with every generator, which holds for the operator that symmetries are found from.
+ *
+ * \param ops Qubit operator to taper.
+ * \param symmetries Result of FindZ2Symmetries.
+ * \param sector Eigenvalue +1 or -1 of every generator.
+ */
+qubit::QubitOperator TaperOperator(const qubit::QubitOperator& ops, const Z2Symmetries& symmetries,
+                                   const std::vector<int>& sector);
+}  // namespace operators
+#endif /* MATH_OPERATORS_TAPERING_H_ */
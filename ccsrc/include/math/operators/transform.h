@@ -16,6 +16,7 @@
 
 #ifndef MATH_OPERATORS_TRANSFORM
 #define MATH_OPERATORS_TRANSFORM
+#include <functional>
 #include <map>
 #include <set>
 #include <unordered_set>
@@ -30,6 +31,17 @@ namespace tn = tensor;
 using fermion_op_t = fermion::FermionOperator;
 using qubit_op_t = qubit::QubitOperator;
 using qlist_t = std::vector<size_t>;
+//! Image of a single fermion ladder operator under a fermion to qubit transform.
+using ladder_image_t = std::function<qubit_op_t(const fermion_op_t::term_t&)>;
+
+/*!
+ * \brief Transform a fermion operator term by term with the image of every ladder operator.
+ *
+ * Terms are split into blocks that are transformed in parallel. Every thread keeps a LRU cache of at most cache_size
+ * ladder operator images, and every block is accumulated into its own qubit operator. Partial operators are merged
+ * in block order, so the result does not depend on the number of threads.
+ */
+qubit_op_t transform_fermion_operator(const fermion_op_t& ops, const ladder_image_t& image, size_t cache_size = 1000);
 qubit_op_t transform_ladder_operator(const fermion::TermValue& value, const qlist_t& x1, const qlist_t& y1,
                                      const qlist_t& z1, const qlist_t& x2, const qlist_t& y2, const qlist_t& z2);
 qubit_op_t jordan_wigner(const fermion_op_t& ops);
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MATH_OPERATORS_TROTTER_H_
+#define MATH_OPERATORS_TROTTER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "math/operators/qubit_operator_view.h"
+
+namespace operators {
+/*!
+ * \brief Gate of a time evolution circuit.
+ *
+ * Name is one of H, RX, RY, RZ, Rxx, Ryy, Rzz, Rxy, Rxz, Ryz and CNOT. Rotation gates carry their angle in coeff, two
+ * qubit rotation gates act with the first pauli operator of their name on objs[0].
+ */
+struct EvolutionGate {
+    std::string name;
+    std::vector<size_t> objs;
+    std::vector<size_t> ctrls;
+    double coeff = 0.0;
+};
+
+/*!
+ * \brief Product formula circuit of exp(-iHt) for a hermitian qubit operator with constant coefficients.
+ *
+ * Terms are sorted in reflected gray code order of their pauli strings, so that adjacent terms share as many basis
+ * changes as possible, and basis changes between adjacent rotations are only emitted on qubits where they differ.
+ * Order is 1, 2 or 4 for Lie-Trotter, Strang and fourth order Suzuki formula, with adjacent rotations of the same
+ * term between steps merged. Terms on one or two qubits are emitted as native rotation gates if native is true,
+ * longer terms as CNOT ladders around RZ. Constant term only adds a global phase and is dropped.
+ */
+std::vector<EvolutionGate> TrotterCircuit(const qubit::QubitOperator& ops, double time, size_t steps, int order = 1,
+                                          bool native = true);
+
+/*!
+ * \brief Randomized qDRIFT circuit of exp(-iHt) for a hermitian qubit operator with constant coefficients.
+ *
+ * Every one of n_samples rotations draws term j with probability |c_j| / lambda, with lambda the sum of |c_j|, and
+ * rotates it for time lambda * t / n_samples. Gates are emitted as in TrotterCircuit.
+ */
+std::vector<EvolutionGate> QDriftCircuit(const qubit::QubitOperator& ops, double time, size_t n_samples,
+                                         uint64_t seed, bool native = true);
+}  // namespace operators
+#endif /* MATH_OPERATORS_TROTTER_H_ */
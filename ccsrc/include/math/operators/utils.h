@@ -16,9 +16,10 @@
 
 #ifndef MATH_OPERATORS_UTILS
 #define MATH_OPERATORS_UTILS
+#include <complex>
+#include <cstddef>
 #include <cstdint>
-#include <list>
-#include <map>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -27,6 +28,8 @@ namespace operators {
 using key_t = std::vector<uint64_t>;
 using value_t = parameter::ParameterResolver;
 using compress_term_t = std::pair<key_t, value_t>;
+//! Term as yielded by iterating QTerm_t, key refers to the stored key and value is a copy of the coefficient.
+using term_view_t = std::pair<const key_t&, value_t>;
 
 struct KeyCompare {
     bool operator()(const key_t& a, const key_t& b) const;
@@ -34,82 +37,193 @@ struct KeyCompare {
 
 // -----------------------------------------------------------------------------
 
+/*!
+ * \brief Terms of an operator, kept in insertion order.
+ *
+ * Terms are stored contiguously in a vector and indexed by an open addressing hash table with linear probing, so
+ * that looking up a term is a hash and a few word compares instead of a walk down a tree of heap nodes. Erased terms
+ * are only marked dead and skipped by iteration, the storage is compacted once dead terms outnumber live ones.
+ *
+ * While every coefficient is a number, coefficients are stored as a complex<double> and the dtype it stands for,
+ * instead of a ParameterResolver per term. The first symbolic coefficient promotes all terms to ParameterResolver.
+ * Iteration therefore yields the stored key together with a copy of the coefficient, coefficients are changed in
+ * place with set, accumulate, transform and cast.
+ */
 class QTerm_t {
- public:
-    void insert(const key_t& key, const value_t& value) {
-        if (m_map.find(key) != m_map.end()) {
-            m_list.erase(m_map[key]);
-            m_map.erase(key);
+    class Iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = term_view_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = term_view_t;
+
+        //! Keeps the term alive for operator->.
+        struct Arrow {
+            term_view_t term;
+            const term_view_t* operator->() const {
+                return &term;
+            }
+        };
+        using pointer = Arrow;
+
+        Iterator(const QTerm_t* owner, size_t pos) : owner_(owner), pos_(pos) {
+            SkipDead();
         }
-        m_list.push_back({key, value});
-        m_map[key] = --m_list.end();
-    }
-    void erase(const key_t& key) {
-        if (m_map.find(key) != m_map.end()) {
-            m_list.erase(m_map[key]);
-            m_map.erase(key);
+        reference operator*() const {
+            return {owner_->m_keys[pos_], owner_->Value(pos_)};
         }
-    }
+        pointer operator->() const {
+            return {**this};
+        }
+        Iterator& operator++() {
+            ++pos_;
+            SkipDead();
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto out = *this;
+            ++(*this);
+            return out;
+        }
+        bool operator==(const Iterator& other) const {
+            return pos_ == other.pos_;
+        }
+        bool operator!=(const Iterator& other) const {
+            return pos_ != other.pos_;
+        }
+
+     private:
+        void SkipDead() {
+            while (pos_ < owner_->m_keys.size() && !owner_->m_alive[pos_]) {
+                ++pos_;
+            }
+        }
+        const QTerm_t* owner_;
+        size_t pos_;
+    };
+
+ public:
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    //! Insert a term, an existing term with same key is replaced and moved to the end.
+    void insert(const key_t& key, const value_t& value);
     void insert(const compress_term_t& t) {
         this->insert(t.first, t.second);
     }
-    value_t& operator[](const key_t& key) {
-        return (*m_map[key]).second;
+    void erase(const key_t& key);
+    bool contains(const key_t& key) const {
+        return Find(key, Hash(key)) != npos;
     }
-
-    typename std::list<std::pair<key_t, value_t>>::iterator begin() {
-        return m_list.begin();
+    //! Coefficient of given key, throw std::out_of_range if key is not present.
+    value_t at(const key_t& key) const;
+    //! Replace the coefficient of given key in place, the term is appended if key is not present.
+    void set(const key_t& key, const value_t& value);
+    /*!
+     * \brief Add value to the coefficient of given key, or subtract it.
+     *
+     * The coefficient is kept as dtype, value only contributes the part that dtype can hold. A term that becomes zero
+     * is erased and a missing key is appended.
+     */
+    void accumulate(const key_t& key, const value_t& value, tensor::TDtype dtype, bool subtract = false);
+    //! Accumulate every term of other, other must not be this.
+    void accumulate(const QTerm_t& other, tensor::TDtype dtype, bool subtract = false);
+    //! Call f on every coefficient, f takes a value_t& and may change it.
+    template <typename F>
+    void transform(F&& f) {
+        for (size_t pos = 0; pos < m_keys.size(); pos++) {
+            if (!m_alive[pos]) {
+                continue;
+            }
+            if (m_symbolic) {
+                f(m_values[pos]);
+                continue;
+            }
+            auto value = Value(pos);
+            f(value);
+            Store(pos, value);
+        }
     }
-
-    typename std::list<std::pair<key_t, value_t>>::iterator end() {
-        return m_list.end();
+    //! Cast every coefficient to dtype.
+    void cast(tensor::TDtype dtype);
+    //! Upper type of dtype and the dtype of every coefficient.
+    tensor::TDtype upper_dtype(tensor::TDtype dtype) const;
+    //! Erase every term whose coefficient is zero.
+    void erase_zeros();
+    //! Whether every coefficient is stored as a number.
+    bool numeric() const {
+        return !m_symbolic;
     }
+    void reserve(size_t n);
+    void clear();
 
-    typename std::list<std::pair<key_t, value_t>>::const_iterator begin() const {
-        return m_list.begin();
+    const_iterator begin() const {
+        return const_iterator(this, 0);
     }
-
-    typename std::list<std::pair<key_t, value_t>>::const_iterator end() const {
-        return m_list.end();
+    const_iterator end() const {
+        return const_iterator(this, m_keys.size());
     }
     size_t size() const {
-        return this->m_map.size();
+        return m_keys.size() - n_dead;
     }
 
-    // -----------------------------------------------------------------------------
+ private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static uint64_t Hash(const key_t& key);
+    size_t Find(const key_t& key, uint64_t hash) const;
+    void Append(const key_t& key, const value_t& value, uint64_t hash);
+    void Kill(size_t pos);
+    void Rehash(size_t n_slots);
+    void Compact();
+    //! Store every coefficient as ParameterResolver.
+    void Promote();
+    value_t Value(size_t pos) const;
+    void Store(size_t pos, const value_t& value);
 
-    QTerm_t() = default;
-    QTerm_t(const QTerm_t& other) {
-        for (auto& p : other.m_list) {
-            insert(p);
-        }
-    }
+    std::vector<key_t> m_keys;
+    //! Coefficients and their dtype while every coefficient is a number.
+    std::vector<std::complex<double>> m_coeffs;
+    std::vector<tensor::TDtype> m_dtypes;
+    //! Coefficients once a symbolic coefficient has been stored.
+    std::vector<value_t> m_values;
+    bool m_symbolic = false;
+    std::vector<uint64_t> m_hash;
+    std::vector<uint8_t> m_alive;
+    //! Position in m_keys plus one of every slot, zero for empty slot.
+    std::vector<uint32_t> m_slots;
+    size_t n_dead = 0;
+};
+
+// -----------------------------------------------------------------------------
 
-    QTerm_t(QTerm_t&& other) {
-        m_list = std::move(other.m_list);
-        m_map = std::move(other.m_map);
+/*!
+ * \brief Add coeff to the term with given key of an operator, or subtract it.
+ *
+ * The term is looked up once and updated in place, terms that become zero are erased and the dtype of operator is
+ * raised to the upper type of coeff.
+ */
+template <typename op_t>
+void AccumulateTerm(op_t* op, const key_t& key, const value_t& coeff, bool subtract = false) {
+    auto upper_t = tensor::upper_type_v(op->dtype, coeff.GetDtype());
+    if (upper_t != op->dtype) {
+        op->CastTo(upper_t);
     }
-    QTerm_t& operator=(const QTerm_t& other) {
-        if (this != &other) {
-            m_list.clear();
-            m_map.clear();
-            for (auto& p : other.m_list) {
-                insert(p);
-            }
-        }
-        return *this;
+    op->terms.accumulate(key, coeff, upper_t, subtract);
+}
+
+//! Add all terms of other operator to op, or subtract them.
+template <typename op_t>
+void AccumulateOperator(op_t* op, const op_t& other, bool subtract = false) {
+    if (op == &other) {
+        auto copy = other;
+        AccumulateOperator(op, copy, subtract);
+        return;
     }
-    QTerm_t& operator=(QTerm_t&& other) {
-        if (this != &other) {
-            m_list = std::move(other.m_list);
-            m_map = std::move(other.m_map);
-        }
-        return *this;
+    auto upper_t = other.terms.upper_dtype(op->dtype);
+    if (upper_t != op->dtype) {
+        op->CastTo(upper_t);
     }
-
- public:
-    std::list<compress_term_t> m_list;
-    std::map<key_t, std::list<compress_term_t>::iterator, KeyCompare> m_map;
-};
+    op->terms.accumulate(other.terms, upper_t, subtract);
+}
 }  // namespace operators
 #endif /* MATH_OPERATORS_UTILS */
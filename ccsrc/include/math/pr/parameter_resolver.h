@@ -17,6 +17,8 @@
 #ifndef MATH_PR_PARAMETER_RESOLVER_HPP_
 #define MATH_PR_PARAMETER_RESOLVER_HPP_
 
+#include <algorithm>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <stdexcept>
@@ -26,6 +28,7 @@
 #include <vector>
 
 #include "config/config.h"
+#include "math/pr/symbol_table.h"
 #include "math/tensor/matrix.h"
 #include "math/tensor/ops.h"
 #include "math/tensor/ops/memory_operator.h"
@@ -49,12 +52,32 @@ std::set<T> operator&(const std::set<T>& s1, const std::set<T>& s2) {
     return out;
 }
 
+//! A parameter of ParameterResolver, the name is interned in SymbolTable.
+struct ParameterTerm {
+    static constexpr uint8_t no_grad_flag = 1;
+    static constexpr uint8_t encoder_flag = 2;
+
+    symbol_t id;
+    tn::Tensor value;
+    uint8_t flags = 0;
+
+    const std::string& name() const {
+        return SymbolTable::Name(id);
+    }
+    bool no_grad() const {
+        return (flags & no_grad_flag) != 0;
+    }
+    bool encoder() const {
+        return (flags & encoder_flag) != 0;
+    }
+};
+
 struct ParameterResolver {
     using data_t = std::map<std::string, tn::Tensor>;
-    data_t data_{};
+    using terms_t = std::vector<ParameterTerm>;
+    //! Parameters sorted by symbol id, gradient and encoder property are stored as flags of every term.
+    terms_t terms_{};
     tn::Tensor const_value = tn::ops::init_with_value(static_cast<double>(0.0));
-    std::set<std::string> no_grad_parameters_{};
-    std::set<std::string> encoder_parameters_{};
     ParameterResolver() = default;
 
     template <typename T,
@@ -66,10 +89,16 @@ struct ParameterResolver {
                                const std::set<std::string>& encoder_parameter = {}) {
         this->const_value = tn::ops::init_with_value(const_value);
         for (auto& [k, v] : data) {
-            data_[k] = tn::ops::init_with_value(v);
+            uint8_t flags = 0;
+            if (no_grad_parameters.count(k) != 0) {
+                flags |= ParameterTerm::no_grad_flag;
+            }
+            if (encoder_parameter.count(k) != 0) {
+                flags |= ParameterTerm::encoder_flag;
+            }
+            terms_.push_back({SymbolTable::Intern(k), tn::ops::init_with_value(v), flags});
         }
-        this->no_grad_parameters_ = no_grad_parameters;
-        this->encoder_parameters_ = encoder_parameter;
+        SortTerms();
     }
 
     explicit ParameterResolver(const std::string& key, const tn::Tensor& const_value = tn::ops::zeros(1),
@@ -80,6 +109,8 @@ struct ParameterResolver {
     explicit ParameterResolver(const tn::Tensor& const_value);
     ParameterResolver(const ParameterResolver& other) = default;
     ParameterResolver& operator=(const ParameterResolver& t) = default;
+    ParameterResolver(ParameterResolver&& other) noexcept = default;
+    ParameterResolver& operator=(ParameterResolver&& t) noexcept = default;
     // -----------------------------------------------------------------------------
     tn::TDtype GetDtype() const;
     size_t Size() const;
@@ -98,6 +129,8 @@ struct ParameterResolver {
     std::set<std::string> GetAllParameters() const;
     std::set<std::string> GetRequiresGradParameters() const;
     std::set<std::string> GetAnsatzParameters() const;
+    std::set<std::string> GetNoGradParameters() const;
+    std::set<std::string> GetEncoderParameters() const;
     bool IsConst() const;
     bool IsNotZero() const;
     std::vector<std::string> subs(const ParameterResolver& other);
@@ -107,7 +140,7 @@ struct ParameterResolver {
             if (a.dim != 1) {
                 throw std::runtime_error("For SetItem of tensor, the given tensor should only has one value.");
             }
-            this->data_[key] = a.astype(this->const_value.dtype);
+            this->FindOrInsert(SymbolTable::Intern(key))->value = a.astype(this->const_value.dtype);
         } else {
             this->SetItem(key, tn::ops::init_with_value(a, this->const_value.device).astype(this->GetDtype()));
         }
@@ -162,7 +195,19 @@ struct ParameterResolver {
 
     bool IsAntiHermitian() const;
 
-    bool HasRequireGradParams();
+    bool HasRequireGradParams() const;
+
+    // -----------------------------------------------------------------------------
+
+    //! Term with given id, nullptr if not exist.
+    const ParameterTerm* Find(symbol_t id) const;
+    ParameterTerm* Find(symbol_t id);
+    //! Term with given name, nullptr if not exist.
+    const ParameterTerm* Find(const std::string& key) const;
+    ParameterTerm* Find(const std::string& key);
+    //! Term with given id, a zero term is inserted at sorted position if not exist.
+    ParameterTerm* FindOrInsert(symbol_t id);
+    void SortTerms();
 
     // -----------------------------------------------------------------------------
 
@@ -185,8 +230,8 @@ struct ParameterResolver {
     template <typename T>
     ParameterResolver& operator*=(const T& value) {
         this->const_value *= value;
-        for (auto& [k, v] : this->data_) {
-            v *= value;
+        for (auto& term : this->terms_) {
+            term.value *= value;
         }
         return *this;
     }
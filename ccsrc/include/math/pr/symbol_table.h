@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MATH_PR_SYMBOL_TABLE_HPP_
+#define MATH_PR_SYMBOL_TABLE_HPP_
+
+#include <cstdint>
+#include <string>
+
+namespace parameter {
+using symbol_t = uint32_t;
+
+/*!
+ * \brief Process wide table that interns parameter names into dense 32 bit ids.
+ *
+ * Ids are handed out in order of first appearance and never released, so two parameter resolvers can compare
+ * and merge their parameters by id without touching the strings. All methods are thread safe.
+ */
+class SymbolTable {
+ public:
+    //! Get the id of given name, register it if not exist.
+    static symbol_t Intern(const std::string& name);
+
+    //! Get the id of given name without registering it, return false if the name is unknown.
+    static bool Lookup(const std::string& name, symbol_t* id);
+
+    //! Get the name of given id, the reference stays valid for the lifetime of the process.
+    static const std::string& Name(symbol_t id);
+};
+}  // namespace parameter
+#endif /* MATH_PR_SYMBOL_TABLE_HPP_ */
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <iterator>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "math/tensor/tensor.h"
@@ -46,12 +47,8 @@ struct Matrix : public Tensor {
         for (auto& row : m) {
             std::copy(row.begin(), row.end(), std::back_inserter(tmp));
         }
-        auto t = Tensor(tmp);
-        this->dtype = t.dtype;
+        Tensor::operator=(Tensor(tmp));
         this->device = device;
-        this->data = t.data;
-        this->dim = t.dim;
-        t.data = nullptr;
     }
     Matrix() = default;
     Matrix(TDtype dtype, TDevice device, void* data, size_t n_row, size_t n_col)
@@ -61,11 +58,7 @@ struct Matrix : public Tensor {
         if (n_col * n_row != other.dim) {
             throw std::runtime_error("Tensor cannot reshape to Matrix with given n_col and n_row.");
         }
-        this->dtype = other.dtype;
-        this->device = other.device;
-        this->data = other.data;
-        this->dim = other.dim;
-        other.data = nullptr;
+        Tensor::operator=(std::move(other));
     }
 };
 }  // namespace tensor
@@ -39,9 +39,8 @@ Tensor real(void* data, size_t len) {
         auto out = ops::cpu::init<real_t>(len);
         auto c_data = reinterpret_cast<to_device_t<dtype>*>(data);
         auto c_out = reinterpret_cast<to_device_t<real_t>*>(out.data);
-        for (size_t i = 0; i < len; i++) {
-            c_out[i] = std::real(c_data[i]);
-        }
+        TENSOR_SIMD_FOR(
+            len, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) { c_out[i] = std::real(c_data[i]); })
         return out;
     }
 }
@@ -58,9 +57,8 @@ Tensor imag(void* data, size_t len) {
         auto out = ops::cpu::init<real_t>(len);
         auto c_data = reinterpret_cast<to_device_t<dtype>*>(data);
         auto c_out = reinterpret_cast<to_device_t<real_t>*>(out.data);
-        for (size_t i = 0; i < len; i++) {
-            c_out[i] = std::imag(c_data[i]);
-        }
+        TENSOR_SIMD_FOR(
+            len, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) { c_out[i] = std::imag(c_data[i]); })
         return out;
     }
 }
@@ -79,9 +77,8 @@ Tensor conj(void* data, size_t len) {
         auto out = ops::cpu::init<dtype>(len);
         auto c_data = reinterpret_cast<to_device_t<dtype>*>(data);
         auto c_out = reinterpret_cast<to_device_t<dtype>*>(out.data);
-        for (size_t i = 0; i < len; i++) {
-            c_out[i] = std::conj(c_data[i]);
-        }
+        TENSOR_SIMD_FOR(
+            len, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) { c_out[i] = std::conj(c_data[i]); })
         return out;
     }
 }
@@ -101,15 +98,28 @@ Tensor vdot(void* bra, size_t len, void* ket) {
     auto c_ket = reinterpret_cast<ket_t*>(ket);
     auto caster_bra = cast_value<bra_t, upper_t>();
     auto caster_ket = cast_value<ket_t, upper_t>();
-    upper_t value = 0;
-    for (size_t i = 0; i < len; i++) {
-        if constexpr (is_complex_v<upper_t>) {
-            value += std::conj(caster_bra(c_bra[i])) * caster_ket(c_ket[i]);
-        } else {
-            value += caster_bra(c_bra[i]) * caster_ket(c_ket[i]);
-        }
+    if constexpr (is_complex_v<upper_t>) {
+        // OpenMP cannot reduce std::complex, so accumulate real and imaginary part separately.
+        typename upper_t::value_type re = 0;
+        typename upper_t::value_type im = 0;
+        THRESHOLD_OMP(
+            MQ_DO_PRAGMA(omp parallel for simd schedule(static) reduction(+ : re, im)), len, omp_threshold,
+            for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) {
+                auto b = caster_bra(c_bra[i]);
+                auto k = caster_ket(c_ket[i]);
+                re += b.real() * k.real() + b.imag() * k.imag();
+                im += b.real() * k.imag() - b.imag() * k.real();
+            })
+        return ops::cpu::init_with_value<upper_t>(upper_t{re, im});
+    } else {
+        upper_t value = 0;
+        THRESHOLD_OMP(
+            MQ_DO_PRAGMA(omp parallel for simd schedule(static) reduction(+ : value)), len, omp_threshold,
+            for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) {
+                value += caster_bra(c_bra[i]) * caster_ket(c_ket[i]);
+            })
+        return ops::cpu::init_with_value<upper_t>(value);
     }
-    return ops::cpu::init_with_value<upper_t>(value);
 }
 
 Tensor vdot(const Tensor& bra, const Tensor& ket);
@@ -201,13 +211,14 @@ Tensor ElementFunc(void* data, size_t len, F&& func) {
     auto c_data = reinterpret_cast<to_device_t<src_dtype>*>(data);
     auto out = init(len, out_dtype);
     auto out_data = reinterpret_cast<to_device_t<out_dtype>*>(out.data);
-    for (size_t i = 0; i < len; i++) {
-        if constexpr (is_complex_dtype_v<src_dtype> && !is_complex_dtype_v<out_dtype>) {
-            out_data[i] = std::real(func(c_data[i]));
-        } else {
-            out_data[i] = func(c_data[i]);
-        }
-    }
+    THRESHOLD_OMP_FOR(
+        len, omp_threshold, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) {
+            if constexpr (is_complex_dtype_v<src_dtype> && !is_complex_dtype_v<out_dtype>) {
+                out_data[i] = std::real(func(c_data[i]));
+            } else {
+                out_data[i] = func(c_data[i]);
+            }
+        })
     return out;
 }
 
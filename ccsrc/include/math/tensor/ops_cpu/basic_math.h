@@ -40,22 +40,26 @@ void InplaceBinary(void* data, size_t len, void* other) {
     using other_t = to_device_t<other_dtype>;
     auto c_data = reinterpret_cast<calc_t*>(data);
     auto c_other = reinterpret_cast<other_t*>(other);
-    auto ops = binary_ops<>();
     auto caster = cast_value<other_t, calc_t>();
-    for (size_t i = 0; i < len; i++) {
-        if constexpr (is_array) {
-            if constexpr (reverse) {
-                c_data[i] = ops(caster(c_other[i]), c_data[i]);
-            } else {
-                c_data[i] = ops(c_data[i], caster(c_other[i]));
-            }
-        } else {
-            if constexpr (reverse) {
-                c_data[i] = ops(caster(c_other[0]), c_data[i]);
-            } else {
-                c_data[i] = ops(c_data[i], caster(c_other[0]));
-            }
-        }
+    if constexpr (is_array) {
+        TENSOR_SIMD_FOR(
+            len, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) {
+                if constexpr (reverse) {
+                    c_data[i] = apply_binary<binary_ops>(caster(c_other[i]), c_data[i]);
+                } else {
+                    c_data[i] = apply_binary<binary_ops>(c_data[i], caster(c_other[i]));
+                }
+            })
+    } else {
+        const calc_t b = caster(c_other[0]);
+        TENSOR_SIMD_FOR(
+            len, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) {
+                if constexpr (reverse) {
+                    c_data[i] = apply_binary<binary_ops>(b, c_data[i]);
+                } else {
+                    c_data[i] = apply_binary<binary_ops>(c_data[i], b);
+                }
+            })
     }
 }
 
@@ -67,23 +71,27 @@ Tensor GenerateBinary(void* data, size_t len, void* other) {
     auto c_des = reinterpret_cast<to_device_t<upper_t>*>(out.data);
     auto c_data = reinterpret_cast<to_device_t<lhs_dtype>*>(data);
     auto c_other = reinterpret_cast<to_device_t<other_dtype>*>(other);
-    auto ops = binary_ops<>();
     auto caster0 = cast_value<to_device_t<lhs_dtype>, to_device_t<upper_t>>();
     auto caster1 = cast_value<to_device_t<other_dtype>, to_device_t<upper_t>>();
-    for (size_t i = 0; i < len; i++) {
-        if constexpr (is_array) {
-            if constexpr (reverse) {
-                c_des[i] = ops(caster1(c_other[i]), caster0(c_data[i]));
-            } else {
-                c_des[i] = ops(caster0(c_data[i]), caster1(c_other[i]));
-            }
-        } else {
-            if constexpr (reverse) {
-                c_des[i] = ops(caster1(c_other[0]), caster0(c_data[i]));
-            } else {
-                c_des[i] = ops(caster0(c_data[i]), caster1(c_other[0]));
-            }
-        }
+    if constexpr (is_array) {
+        TENSOR_SIMD_FOR(
+            len, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) {
+                if constexpr (reverse) {
+                    c_des[i] = apply_binary<binary_ops>(caster1(c_other[i]), caster0(c_data[i]));
+                } else {
+                    c_des[i] = apply_binary<binary_ops>(caster0(c_data[i]), caster1(c_other[i]));
+                }
+            })
+    } else {
+        const auto b = caster1(c_other[0]);
+        TENSOR_SIMD_FOR(
+            len, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) {
+                if constexpr (reverse) {
+                    c_des[i] = apply_binary<binary_ops>(b, caster0(c_data[i]));
+                } else {
+                    c_des[i] = apply_binary<binary_ops>(caster0(c_data[i]), b);
+                }
+            })
     }
     return out;
 }
@@ -34,17 +34,21 @@
 #include "math/tensor/traits.h"
 
 namespace tensor::ops::cpu {
+//! Point t->data at storage of given bytes: the inline buffer if it fits, otherwise the heap.
+void allocate(Tensor* t, size_t bytes);
+
 template <TDtype dtype>
 Tensor init(size_t len) {
     using calc_t = to_device_t<dtype>;
-    void* data = nullptr;
-    if (len != 0) {
-        data = reinterpret_cast<void*>(malloc(sizeof(calc_t) * len));
-    }
-    if (data == nullptr) {
+    if (len == 0) {
         throw std::runtime_error("malloc memory error.");
     }
-    return Tensor{dtype, TDevice::CPU, data, len};
+    Tensor out;
+    out.dtype = dtype;
+    out.device = TDevice::CPU;
+    out.dim = len;
+    allocate(&out, sizeof(calc_t) * len);
+    return out;
 }
 
 Tensor init(size_t len, TDtype dtype);
@@ -60,9 +64,8 @@ Tensor cast_to(const void* data, size_t len) {
     auto out = cpu::init<des>(len);
     auto c_out = reinterpret_cast<d_des*>(out.data);
     auto caster = cast_value<to_device_t<src>, to_device_t<des>>();
-    for (size_t i = 0; i < len; i++) {
-        c_out[i] = caster(c_data[i]);
-    }
+    TENSOR_SIMD_FOR(
+        len, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(len); i++) { c_out[i] = caster(c_data[i]); })
     return out;
 }
 
@@ -115,6 +118,22 @@ Tensor init_with_vector(const std::vector<T>& a) {
     return out;
 }
 
+//! A 1 x len matrix with given values, built without temporary containers.
+template <typename T>
+Matrix init_with_row(const T* a, size_t len) {
+    constexpr auto dtype = to_dtype_v<T>;
+    if (len == 0) {
+        throw std::runtime_error("malloc memory error.");
+    }
+    Tensor out;
+    out.dtype = dtype;
+    out.device = TDevice::CPU;
+    out.dim = len;
+    allocate(&out, sizeof(T) * len);
+    mindquantum::safe_copy(out.data, sizeof(T) * len, a, sizeof(T) * len);
+    return Matrix(std::move(out), 1, len);
+}
+
 // -----------------------------------------------------------------------------
 
 template <TDtype dtype>
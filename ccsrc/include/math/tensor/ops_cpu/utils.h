@@ -18,11 +18,27 @@
 #define MATH_TENSOR_OPS_CPU_UTILS_HPP_
 
 #include <complex>
+#include <cstddef>
+#include <functional>
 #include <type_traits>
 
+#include "config/openmp.h"
+#include "core/mq_base_types.h"
+#include "core/utils.h"
 #include "math/tensor/traits.h"
 
+// Vectorize an element-wise loop, and also split it over threads once the tensor has omp_threshold elements.
+#define TENSOR_SIMD_FOR(n, ...)                                                                                        \
+    if ((n) < ::tensor::omp_threshold) {                                                                               \
+        MQ_DO_PRAGMA(omp simd) __VA_ARGS__                                                                             \
+    } else {                                                                                                           \
+        MQ_DO_PRAGMA(omp parallel for simd schedule(static)) __VA_ARGS__                                               \
+    }
+
 namespace tensor {
+//! Element-wise kernels run in parallel for tensors with at least this many elements.
+static constexpr size_t omp_threshold = static_cast<size_t>(1) << mindquantum::nQubitTh;
+
 template <typename T>
 struct is_complex {
     static constexpr bool v = false;
@@ -53,6 +69,23 @@ struct cast_value {
         }
     }
 };
+
+// -----------------------------------------------------------------------------
+
+/*!
+ * \brief Apply a binary operator on two values of same type.
+ *
+ * Complex multiplication of std::complex recovers inf and nan with a library call, which blocks vectorization,
+ * so it is expanded into real arithmetic here.
+ */
+template <template <typename ops_t = void> class binary_ops, typename T>
+inline T apply_binary(const T& a, const T& b) {
+    if constexpr (is_complex_v<T> && std::is_same_v<binary_ops<>, std::multiplies<>>) {
+        return T{a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+    } else {
+        return binary_ops<>()(a, b);
+    }
+}
 }  // namespace tensor
 
 #endif /* MATH_TENSOR_OPS_CPU_UTILS_HPP_ */
@@ -17,6 +17,7 @@
 #ifndef MATH_TENSOR_TENSOR_HPP_
 #define MATH_TENSOR_TENSOR_HPP_
 
+#include <complex>
 #include <cstddef>
 #include <vector>
 
@@ -24,11 +25,26 @@
 
 namespace tensor {
 struct Tensor {
+    //! Size in bytes of the inline storage, enough for two complex128 elements.
+    static constexpr size_t inline_capacity = 2 * sizeof(std::complex<double>);
+
     TDtype dtype = TDtype::Float64;
     TDevice device = TDevice::CPU;
     void* data = nullptr;
     size_t dim = 0;
 
+    //! Small cpu tensors keep their elements here instead of on the heap, data then points to this buffer.
+    alignas(std::complex<double>) unsigned char inline_data[inline_capacity];
+
+    bool is_inline() const {
+        return data == static_cast<const void*>(inline_data);
+    }
+
+    //! Whether len elements of given dtype fit in the inline storage.
+    static bool fits_inline(size_t len, TDtype dtype) {
+        return len != 0 && len * static_cast<size_t>(bit_size(dtype)) <= inline_capacity;
+    }
+
     // -----------------------------------------------------------------------------
 
     ~Tensor();
@@ -42,8 +58,8 @@ struct Tensor {
     explicit Tensor(const std::vector<std::complex<float>>& a, TDtype dtype = TDtype::Complex64);
     explicit Tensor(const std::vector<std::complex<double>>& a, TDtype dtype = TDtype::Complex128);
     Tensor(TDtype dtype, TDevice device, void* data, size_t dim);
-    Tensor(Tensor&& t);
-    Tensor& operator=(Tensor&& t);
+    Tensor(Tensor&& t) noexcept;
+    Tensor& operator=(Tensor&& t) noexcept;
     Tensor(const Tensor& t);
     Tensor& operator=(const Tensor& t);
 
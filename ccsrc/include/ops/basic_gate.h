@@ -129,7 +129,7 @@ struct Parameterizable : public BasicGate {
         parameterized_ = !std::all_of(this->prs_.begin(), this->prs_.end(),
                                       [](const auto& pr) { return pr.IsConst(); });
         grad_required_ = std::any_of(this->prs_.begin(), this->prs_.end(),
-                                     [](const auto& pr) { return pr.data_.size() != pr.no_grad_parameters_.size(); });
+                                     [](const auto& pr) { return pr.HasRequireGradParams(); });
         jacobi = Jacobi(this->prs_);
     }
     bool Parameterized() override {
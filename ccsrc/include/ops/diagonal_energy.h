@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDQUANTUM_HAMILTONIAN_DIAGONAL_ENERGY_H_
+#define MINDQUANTUM_HAMILTONIAN_DIAGONAL_ENERGY_H_
+#include <array>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "core/mq_base_types.h"
+#include "core/utils.h"
+
+namespace mindquantum {
+// Energy of every computational basis state of a hamiltonian with only pauli Z terms.
+//
+// Only the qubits that terms act on are tabulated: the bits of a basis state on these qubits are packed to the low
+// end (a table driven pext) to index the table, so it has 2^n_used entries wherever the qubits are. The table is
+// built on the first call of Table(), and never if more than kCacheQubits qubits are used.
+template <typename T>
+class DiagonalEnergy {
+ public:
+    static constexpr Index kCacheQubits = 20;
+
+    DiagonalEnergy() : DiagonalEnergy(VT<std::pair<Index, T>>{}) {
+    }
+
+    explicit DiagonalEnergy(const VT<std::pair<Index, T>> &terms) : cache_(std::make_shared<Cache>()) {
+        for (const auto &[mask, coeff] : terms) {
+            used_mask_ |= mask;
+        }
+        n_used_ = CountOne(used_mask_);
+        contiguous_ = (used_mask_ & (used_mask_ + 1)) == 0;
+        if (!contiguous_) {
+            Index offset = 0;
+            for (Index rest = used_mask_; rest != 0; rest >>= 8) {
+                auto &table = byte_index_.emplace_back();
+                for (Index v = 0; v < 256; v++) {
+                    table[v] = PackByte(v, rest & 0xFF) << offset;
+                }
+                offset += POPCNTTABLE[rest & 0xFF];
+            }
+        }
+        for (const auto &[mask, coeff] : terms) {
+            packed_terms_.emplace_back(Pack(mask), coeff);
+        }
+    }
+
+    // Number of qubits that terms act on.
+    Index UsedQubits() const {
+        return n_used_;
+    }
+
+    // Whether energies can be read from Table().
+    bool Cached() const {
+        return n_used_ <= kCacheQubits;
+    }
+
+    // Bits of basis state i on the used qubits, packed to the low end.
+    Index Pack(Index i) const {
+        if (contiguous_) {
+            return i & used_mask_;
+        }
+        Index out = 0;
+        for (size_t b = 0; b < byte_index_.size(); b++) {
+            out |= byte_index_[b][(i >> (8 * b)) & 0xFF];
+        }
+        return out;
+    }
+
+    // Energy table indexed by Pack(i). Built once on first call, safe to call from several threads.
+    const VT<T> &Table() const {
+        if (!Cached()) {
+            throw std::runtime_error("Too many qubits to cache energy of diagonal hamiltonian.");
+        }
+        std::call_once(cache_->built, [&]() {
+            Index dim = static_cast<Index>(1) << n_used_;
+            auto &table = cache_->table;
+            table.resize(dim);
+            auto energy = table.data();
+            auto &terms = packed_terms_;
+            THRESHOLD_OMP_FOR(
+                dim, static_cast<uint64_t>(1) << nQubitTh,
+                for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) {
+                    T e = 0;
+                    for (const auto &[mask, coeff] : terms) {
+                        e += (CountOne(static_cast<Index>(i) & mask) & 1) ? -coeff : coeff;
+                    }
+                    energy[i] = e;
+                })
+        });
+        return cache_->table;
+    }
+
+ private:
+    static Index PackByte(Index v, Index mask) {
+        Index out = 0;
+        Index k = 0;
+        for (Index j = 0; j < 8; j++) {
+            if ((mask >> j) & 1) {
+                out |= ((v >> j) & 1) << k;
+                k++;
+            }
+        }
+        return out;
+    }
+
+    // Copies of a hamiltonian share the table.
+    struct Cache {
+        std::once_flag built;
+        VT<T> table;
+    };
+
+    Index used_mask_ = 0;
+    Index n_used_ = 0;
+    bool contiguous_ = true;
+    VT<std::array<Index, 256>> byte_index_;
+    VT<std::pair<Index, T>> packed_terms_;
+    std::shared_ptr<Cache> cache_;
+};
+}  // namespace mindquantum
+#endif  // MINDQUANTUM_HAMILTONIAN_DIAGONAL_ENERGY_H_
@@ -17,9 +17,11 @@
 #ifndef MINDQUANTUM_HAMILTONIAN_HAMILTONIAN_H_
 #define MINDQUANTUM_HAMILTONIAN_HAMILTONIAN_H_
 #include <memory>
+#include <utility>
 
 #include "core/sparse/algo.h"
 #include "core/utils.h"
+#include "ops/diagonal_energy.h"
 
 namespace mindquantum {
 using mindquantum::sparse::CsrHdMatrix;
@@ -34,12 +36,20 @@ struct Hamiltonian {
     std::shared_ptr<CsrHdMatrix<T>> ham_sparse_main_;
     std::shared_ptr<CsrHdMatrix<T>> ham_sparse_second_;
 
+    // A hamiltonian with only pauli Z terms is diagonal, diag_terms_ stores the Z mask and coefficient of every term.
+    bool is_diagonal_ = false;
+    VT<std::pair<Index, T>> diag_terms_;
+    // Energy of every computational basis state, tabulated lazily over the qubits that terms act on.
+    DiagonalEnergy<T> diag_energy_;
+
     Hamiltonian() = default;
 
     explicit Hamiltonian(const VT<PauliTerm<T>> &ham) : how_to_(ORIGIN), ham_(ham) {
+        InitDiagonal();
     }
 
     Hamiltonian(const VT<PauliTerm<T>> &ham, Index n_qubits) : how_to_(BACKEND), n_qubits_(n_qubits), ham_(ham) {
+        InitDiagonal();
         if (n_qubits_ > 16) {
             std::cout << "Sparsing hamiltonian ..." << std::endl;
         }
@@ -53,6 +63,25 @@ struct Hamiltonian {
     Hamiltonian(std::shared_ptr<CsrHdMatrix<T>> csr_mat, Index n_qubits)
         : n_qubits_(n_qubits), how_to_(FRONTEND), ham_sparse_main_(csr_mat) {
     }
+
+    void InitDiagonal() {
+        is_diagonal_ = false;
+        diag_terms_.clear();
+        diag_energy_ = DiagonalEnergy<T>();
+        for (const auto &[pauli_string, coeff] : ham_) {
+            Index mask = 0;
+            for (const auto &[idx, word] : pauli_string) {
+                if (word != 'Z') {
+                    diag_terms_.clear();
+                    return;
+                }
+                mask ^= static_cast<Index>(1) << idx;
+            }
+            diag_terms_.emplace_back(mask, coeff);
+        }
+        is_diagonal_ = true;
+        diag_energy_ = DiagonalEnergy<T>(diag_terms_);
+    }
 };
 }  // namespace mindquantum
 #endif  // MINDQUANTUM_HAMILTONIAN_HAMILTONIAN_H_
@@ -44,6 +44,16 @@ struct Projector {
             }
         }
     }
+
+    //! Bit mask of qubits that are fixed to 0 or 1 by this projector.
+    Index FixedMask() const {
+        return mask1_ | (~mask2_ & ((static_cast<Index>(1) << n_qubits_) - 1));
+    }
+
+    //! Value that the fixed qubits of a basis index should match to survive this projector.
+    Index Condition() const {
+        return mask1_;
+    }
 };
 }  // namespace mindquantum
 #endif  // MINDQUANTUM_PROJECTOR_PROJECTOR_H_
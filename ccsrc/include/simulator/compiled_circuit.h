@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2022. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_QUANTUMSTATE_COMPILED_CIRCUIT_HPP
+#define INCLUDE_QUANTUMSTATE_COMPILED_CIRCUIT_HPP
+
+#include <complex>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "ops/basic_gate.h"
+
+namespace mindquantum::sim {
+//! Largest number of parameters of a single gate, reached by U3 and Rn.
+constexpr size_t max_gate_params = 3;
+
+//! Whether the gate with given id is derived from Parameterizable.
+bool IsParameterizable(GateID id);
+
+//! Evaluate every parameter of a parameterized gate under given parameter resolver.
+VT<double> GateParameters(const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr);
+
+/*!
+ * \brief Gate parameters of a quantum circuit compiled into an affine map of a dense parameter vector.
+ *
+ * Parameter names are interned to column indices, and every parameter of every parameterized gate is a row of a
+ * sparse coefficient matrix in CSR format with a constant offset. Binding the circuit to a parameter vector x is
+ * then a single sparse matrix vector product, offset + coeff * x, instead of a ParameterResolver combination per
+ * gate.
+ */
+struct CompiledCircuit {
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    //! Parameter name of every column.
+    VS names_;
+    //! Column index of every parameter name.
+    MST<size_t> columns_;
+    //! First row of every gate in circuit, npos for gate without parameter.
+    VT<size_t> gate_rows_;
+    VT<size_t> row_ptr_ = {0};
+    VT<size_t> col_idx_;
+    VT<double> coeff_;
+    VT<double> offset_;
+
+    CompiledCircuit() = default;
+
+    /*!
+     * \brief Compile the parameters of given circuit.
+     *
+     * \param names parameter names that occupy the leading columns, names that only appear in circuit are appended
+     * in order of appearance.
+     */
+    explicit CompiledCircuit(const std::vector<std::shared_ptr<BasicGate>>& circ, const VS& names = {});
+
+    //! Bind a parameter vector ordered as names_, return parameters of all gates.
+    VT<double> Bind(const VT<double>& x) const;
+
+    //! Gather the parameter vector ordered as names_ from a parameter resolver.
+    VT<double> Values(const parameter::ParameterResolver& pr) const;
+};
+
+/*!
+ * \brief Jacobians of all gates in a quantum circuit, flattened against the gradient layout of a simulation.
+ *
+ * Every non zero element of the jacobian of gate k is stored as an entry that maps the intrinsic gradient of gate
+ * parameter row to the gradient of circuit parameter col, where col is taken from the parameter map of the
+ * simulation. With this, accumulating the gradient of a gate is a short loop of multiply add over a dense gradient
+ * array, without any matrix product or parameter name lookup.
+ */
+struct CompiledJacobian {
+    struct Entry {
+        size_t row;
+        size_t col;
+        std::complex<double> coeff;
+    };
+
+    //! Entries of gate k are entries_[gate_ptr_[k]] to entries_[gate_ptr_[k + 1]].
+    VT<size_t> gate_ptr_ = {0};
+    VT<Entry> entries_;
+
+    CompiledJacobian() = default;
+
+    //! Flatten jacobians of gates that require gradient, throw std::out_of_range if a parameter is not in p_map.
+    CompiledJacobian(const std::vector<std::shared_ptr<BasicGate>>& circ, const MST<size_t>& p_map);
+
+    //! grad[col] += intrin_grad[row] * coeff for all entries of gate k.
+    template <typename T>
+    void AddGrad(size_t k, const T* intrin_grad, T* grad) const {
+        for (auto i = gate_ptr_[k]; i < gate_ptr_[k + 1]; i++) {
+            const auto& e = entries_[i];
+            grad[e.col] += intrin_grad[e.row] * static_cast<T>(e.coeff);
+        }
+    }
+
+    //! grad[col] += 2 * real(intrin_grad[row] * coeff) for all entries of gate k, used by hermitian expectations.
+    template <typename T>
+    void AddRealGrad(size_t k, const T* intrin_grad, T* grad) const {
+        for (auto i = gate_ptr_[k]; i < gate_ptr_[k + 1]; i++) {
+            const auto& e = entries_[i];
+            grad[e.col] += 2 * std::real(intrin_grad[e.row] * static_cast<T>(e.coeff));
+        }
+    }
+
+    //! Whether gate k contributes to gradient.
+    bool HasGrad(size_t k) const {
+        return gate_ptr_[k + 1] != gate_ptr_[k];
+    }
+};
+}  // namespace mindquantum::sim
+#endif
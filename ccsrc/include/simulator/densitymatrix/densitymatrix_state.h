@@ -39,6 +39,7 @@
 #include "ops/basic_gate.h"
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
+#include "ops/projector.h"
 #include "simulator/timer.h"
 #include "simulator/utils.h"
 
@@ -143,6 +144,13 @@ class DensityMatrixState {
     virtual py_qs_data_t GetExpectation(const Hamiltonian<calc_type>& ham, const circuit_t& circ,
                                         const parameter::ParameterResolver& pr) const;
 
+    //! Get the probability that the quantum state evolved by given circuit survives given projector.
+    virtual calc_type GetProjectorExpectation(const Projector& proj, const circuit_t& circ,
+                                              const parameter::ParameterResolver& pr) const;
+
+    //! Project the quantum state with given projector and renormalize it, return the success probability.
+    virtual calc_type PostSelect(const Projector& proj);
+
     virtual py_qs_datas_t GetExpectationWithReversibleGradOneOne(const Hamiltonian<calc_type>& ham,
                                                                  const circuit_t& circ, const circuit_t& herm_circ,
                                                                  const parameter::ParameterResolver& pr,
@@ -44,6 +44,7 @@
 #include "ops/basic_gate.h"
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
+#include "simulator/compiled_circuit.h"
 #include "simulator/densitymatrix/densitymatrix_state.h"
 
 namespace mindquantum::sim::densitymatrix::detail {
@@ -524,14 +525,14 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffU3(const qs_data_p_t& dens_matr
         auto theta = u3->theta.Combination(pr).const_value;
         auto phi = u3->phi.Combination(pr).const_value;
         auto lambda = u3->lambda.Combination(pr).const_value;
-        if (u3->theta.data_.size() != u3->theta.no_grad_parameters_.size()) {
+        if (u3->theta.HasRequireGradParams()) {
             grad[0] = qs_policy_t::ExpectDiffU3Theta(dens_matrix, ham_matrix, u3->obj_qubits_, u3->ctrl_qubits_,
                                                      tensor::ops::cpu::to_vector<calc_type>(phi)[0], dim);
         }
-        if (u3->phi.data_.size() != u3->phi.no_grad_parameters_.size()) {
+        if (u3->phi.HasRequireGradParams()) {
             grad[1] = qs_policy_t::ExpectDiffU3Phi(dens_matrix, ham_matrix, u3->obj_qubits_, u3->ctrl_qubits_, dim);
         }
-        if (u3->lambda.data_.size() != u3->lambda.no_grad_parameters_.size()) {
+        if (u3->lambda.HasRequireGradParams()) {
             tensor::Matrix m{U3Matrix(theta, phi, lambda)};
             tensor::Matrix diff_m{U3DiffLambdaMatrix(theta, phi, lambda)};
             grad[2] = qs_policy_t::ExpectDiffSingleQubitMatrix(
@@ -554,17 +555,17 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffRn(const qs_data_p_t& dens_matr
         auto beta = rn->beta.Combination(pr).const_value;
         auto gamma = rn->gamma.Combination(pr).const_value;
         auto m = tensor::ops::cpu::to_vector<py_qs_data_t>(RnMatrix(alpha, beta, gamma));
-        if (rn->alpha.data_.size() != rn->alpha.no_grad_parameters_.size()) {
+        if (rn->alpha.HasRequireGradParams()) {
             auto diff_m = tensor::ops::cpu::to_vector<py_qs_data_t>(RnDiffAlphaMatrix(alpha, beta, gamma));
             grad[0] = qs_policy_t::ExpectDiffMatrixGate(dens_matrix, ham_matrix, rn->obj_qubits_, rn->ctrl_qubits_, m,
                                                         diff_m, dim);
         }
-        if (rn->beta.data_.size() != rn->beta.no_grad_parameters_.size()) {
+        if (rn->beta.HasRequireGradParams()) {
             auto diff_m = tensor::ops::cpu::to_vector<py_qs_data_t>(RnDiffBetaMatrix(alpha, beta, gamma));
             grad[1] = qs_policy_t::ExpectDiffMatrixGate(dens_matrix, ham_matrix, rn->obj_qubits_, rn->ctrl_qubits_, m,
                                                         diff_m, dim);
         }
-        if (rn->gamma.data_.size() != rn->gamma.no_grad_parameters_.size()) {
+        if (rn->gamma.HasRequireGradParams()) {
             auto diff_m = tensor::ops::cpu::to_vector<py_qs_data_t>(RnDiffGammaMatrix(alpha, beta, gamma));
             grad[2] = qs_policy_t::ExpectDiffMatrixGate(dens_matrix, ham_matrix, rn->obj_qubits_, rn->ctrl_qubits_, m,
                                                         diff_m, dim);
@@ -581,11 +582,11 @@ auto DensityMatrixState<qs_policy_t_>::ExpectDiffFSim(const qs_data_p_t& dens_ma
     py_qs_datas_t grad = {0, 0};
     auto fsim = static_cast<FSim*>(gate.get());
     if (fsim->parameterized_) {
-        if (fsim->theta.data_.size() != fsim->theta.no_grad_parameters_.size()) {
+        if (fsim->theta.HasRequireGradParams()) {
             grad[0] = qs_policy_t::ExpectDiffFSimTheta(dens_matrix, ham_matrix, fsim->obj_qubits_, fsim->ctrl_qubits_,
                                                        dim);
         }
-        if (fsim->phi.data_.size() != fsim->phi.no_grad_parameters_.size()) {
+        if (fsim->phi.HasRequireGradParams()) {
             grad[1] = qs_policy_t::ExpectDiffFSimPhi(dens_matrix, ham_matrix, fsim->obj_qubits_, fsim->ctrl_qubits_,
                                                      dim);
         }
@@ -641,6 +642,35 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_typ
     return out;
 }
 
+template <typename qs_policy_t_>
+auto DensityMatrixState<qs_policy_t_>::GetProjectorExpectation(const Projector& proj, const circuit_t& circ,
+                                                               const parameter::ParameterResolver& pr) const
+    -> calc_type {
+    if (proj.n_qubits_ > static_cast<Index>(n_qubits)) {
+        throw std::invalid_argument(
+            fmt::format("Projector with {} qubits is too large for {} qubits simulator.", proj.n_qubits_, n_qubits));
+    }
+    if (circ.empty()) {
+        return qs_policy_t::DiagonalConditionalCollect(qs, proj.FixedMask(), proj.Condition(), dim);
+    }
+    auto sub_seed = static_cast<unsigned int>(static_cast<calc_type>(rng_()) * (1 << 20));
+    auto tmp_sim = derived_t(n_qubits, sub_seed);
+    tmp_sim.CopyQS(qs);
+    tmp_sim.ApplyCircuit(circ, pr);
+    return qs_policy_t::DiagonalConditionalCollect(tmp_sim.qs, proj.FixedMask(), proj.Condition(), dim);
+}
+
+template <typename qs_policy_t_>
+auto DensityMatrixState<qs_policy_t_>::PostSelect(const Projector& proj) -> calc_type {
+    auto prob = GetProjectorExpectation(proj, {}, parameter::ParameterResolver());
+    if (prob < PRECISION) {
+        throw std::runtime_error(
+            fmt::format("Can not post select with projector {}, since its probability is zero.", proj.proj_str_));
+    }
+    qs_policy_t::ConditionalMul(qs, &qs, proj.FixedMask(), proj.Condition(), 1 / prob, 0.0, dim);
+    return prob;
+}
+
 template <typename qs_policy_t_>
 auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneOne(
     const Hamiltonian<calc_type>& ham, const circuit_t& circ, const circuit_t& herm_circ,
@@ -649,6 +679,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneOne(
         std::runtime_error("In density matrix mode, circ and herm_circ must be the same size.");
     }
     py_qs_datas_t f_and_g(1 + p_map.size(), 0);
+    auto jacobian = CompiledJacobian(circ, p_map);
     derived_t sim_qs = *this;
     sim_qs.ApplyCircuit(circ, pr);
     f_and_g[0] = GetStateExpectation(sim_qs.qs, ham, dim);
@@ -657,16 +688,9 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneOne(
     index_t n = circ.size();
     for (const auto& g : herm_circ) {
         --n;
-        if (g->GradRequired()) {
-            auto p_gate = static_cast<Parameterizable*>(circ[n].get());
-            const auto& [title, jac] = p_gate->jacobi;
-            if (title.size() != 0) {
-                auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_ham.qs, circ[n], pr, dim);
-                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
-                for (const auto& [name, idx] : title) {
-                    f_and_g[1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
-                }
-            }
+        if (jacobian.HasGrad(n)) {
+            auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_ham.qs, circ[n], pr, dim);
+            jacobian.AddRealGrad(n, reinterpret_cast<const py_qs_data_t*>(intrin_grad.data), f_and_g.data() + 1);
         }
         sim_ham.ApplyGate(g, pr);
         sim_qs.ApplyGate(g, pr);
@@ -693,6 +717,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneMulti(
         n_thread = n_hams;
     }
     VT<py_qs_datas_t> f_and_g(n_hams, py_qs_datas_t((1 + p_map.size()), 0));
+    auto jacobian = CompiledJacobian(circ, p_map);
     derived_t sim_qs = *this;
     sim_qs.ApplyCircuit(circ, pr);
     int n_group = n_hams / n_thread;
@@ -714,17 +739,11 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithReversibleGradOneMulti(
         index_t n = circ.size();
         for (const auto& g : herm_circ) {
             --n;
-            if (g->GradRequired()) {
-                auto p_gate = static_cast<Parameterizable*>(circ[n].get());
-                const auto& [title, jac] = p_gate->jacobi;
-                if (title.size() != 0) {
-                    for (int j = start; j < end; j++) {
-                        auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_hams[j - start].qs, circ[n], pr, dim);
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
-                        for (const auto& [name, idx] : title) {
-                            f_and_g[j][1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
-                        }
-                    }
+            if (jacobian.HasGrad(n)) {
+                for (int j = start; j < end; j++) {
+                    auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_hams[j - start].qs, circ[n], pr, dim);
+                    jacobian.AddRealGrad(n, reinterpret_cast<const py_qs_data_t*>(intrin_grad.data),
+                                         f_and_g[j].data() + 1);
                 }
             }
             for (int j = start; j < end; j++) {
@@ -810,6 +829,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneOne(const H
         std::runtime_error("In density matrix mode, circ and herm_circ must be the same size.");
     }
     py_qs_datas_t f_and_g(1 + p_map.size(), 0);
+    auto jacobian = CompiledJacobian(circ, p_map);
     derived_t sim_qs = *this;
     sim_qs.ApplyCircuit(circ, pr);
     f_and_g[0] = GetStateExpectation(sim_qs.qs, ham, dim);
@@ -819,20 +839,13 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneOne(const H
     index_t n = circ.size();
     for (const auto& g : herm_circ) {
         --n;
-        if (g->GradRequired()) {
-            auto p_gate = static_cast<Parameterizable*>(circ[n].get());
-            const auto& [title, jac] = p_gate->jacobi;
-            if (title.size() != 0) {
-                for (index_t a = 0; a <= n; a++) {
-                    sim_qs.ApplyGate(circ[a], pr);
-                }
-                auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_ham.qs, circ[n], pr, dim);
-                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
-                for (const auto& [name, idx] : title) {
-                    f_and_g[1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
-                }
-                sim_qs.CopyQS(this->qs);
+        if (jacobian.HasGrad(n)) {
+            for (index_t a = 0; a <= n; a++) {
+                sim_qs.ApplyGate(circ[a], pr);
             }
+            auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_ham.qs, circ[n], pr, dim);
+            jacobian.AddRealGrad(n, reinterpret_cast<const py_qs_data_t*>(intrin_grad.data), f_and_g.data() + 1);
+            sim_qs.CopyQS(this->qs);
         }
         sim_ham.ApplyGate(g, pr);
     }
@@ -858,6 +871,7 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneMulti(
         n_thread = n_hams;
     }
     VT<py_qs_datas_t> f_and_g(n_hams, py_qs_datas_t((1 + p_map.size()), 0));
+    auto jacobian = CompiledJacobian(circ, p_map);
     derived_t sim_qs = *this;
     sim_qs.ApplyCircuit(circ, pr);
     int n_group = n_hams / n_thread;
@@ -880,22 +894,16 @@ auto DensityMatrixState<qs_policy_t_>::GetExpectationWithNoiseGradOneMulti(
         index_t n = circ.size();
         for (const auto& g : herm_circ) {
             --n;
-            if (g->GradRequired()) {
-                auto p_gate = static_cast<Parameterizable*>(circ[n].get());
-                const auto& [title, jac] = p_gate->jacobi;
-                if (title.size() != 0) {
-                    for (index_t a = 0; a <= n; a++) {
-                        sim_qs.ApplyGate(circ[a], pr);
-                    }
-                    for (int j = start; j < end; j++) {
-                        auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_hams[j - start].qs, circ[n], pr, dim);
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
-                        for (const auto& [name, idx] : title) {
-                            f_and_g[j][1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
-                        }
-                    }
-                    sim_qs.CopyQS(this->qs);
+            if (jacobian.HasGrad(n)) {
+                for (index_t a = 0; a <= n; a++) {
+                    sim_qs.ApplyGate(circ[a], pr);
+                }
+                for (int j = start; j < end; j++) {
+                    auto intrin_grad = ExpectDiffGate(sim_qs.qs, sim_hams[j - start].qs, circ[n], pr, dim);
+                    jacobian.AddRealGrad(n, reinterpret_cast<const py_qs_data_t*>(intrin_grad.data),
+                                         f_and_g[j].data() + 1);
                 }
+                sim_qs.CopyQS(this->qs);
             }
             for (int j = start; j < end; j++) {
                 sim_hams[j - start].ApplyGate(g, pr);
@@ -18,6 +18,8 @@
 #define INCLUDE_QUANTUMSTATE_UTILS_HPP
 
 #include <cassert>
+#include <complex>
+#include <utility>
 #include <vector>
 
 #include "core/mq_base_types.h"
@@ -51,6 +53,46 @@ struct DoubleQubitGateMask {
     DoubleQubitGateMask(const qbits_t& obj_qubits, const qbits_t& ctrl_qubits);
 };
 
+/*!
+ * \brief Eigen decomposition of a real symmetric tridiagonal matrix with implicit QL iterations.
+ *
+ * \param diag diagonal elements, overwritten by eigenvalues in ascending order.
+ * \param off off-diagonal elements, off[i] couples row i and row i + 1.
+ * \return eigenvectors, the i-th component of the j-th eigenvector is stored in out[i][j].
+ */
+VVT<double> SymTridiagEigen(VT<double>* diag, VT<double> off);
+
+/*!
+ * \brief Calculate exp(-iTt)e_0, where T is the real symmetric tridiagonal matrix given by diag and off.
+ *
+ * This is the coefficient vector of a short-iterative Lanczos propagation in Krylov basis.
+ */
+VT<std::complex<double>> TridiagExpDotE0(const VT<double>& diag, const VT<double>& off, double t);
+
+/*!
+ * \brief Eigen decomposition of a small dense real symmetric matrix with cyclic Jacobi rotations.
+ *
+ * \param mat the symmetric matrix, only the upper triangle is used.
+ * \param eig_val output eigenvalues in ascending order.
+ * \return eigenvectors, the i-th component of the j-th eigenvector is stored in out[i][j].
+ */
+VVT<double> SymEigen(VVT<double> mat, VT<double>* eig_val);
+
+/*!
+ * \brief Exact minimum of a diagonal hamiltonian sum_i c_i Z_{mask_i}.
+ *
+ * The leading qubits are searched with branch and bound in parallel over the prefix space, and the trailing qubits
+ * of every surviving branch are swept in Gray-code order, so that flipping one qubit only updates the terms that
+ * touch it.
+ *
+ * \param masks qubit mask of every term, mask 0 is a constant term.
+ * \param coeffs coefficient of every term.
+ * \param max_n_states the maximum number of degenerate ground state bitstrings to return.
+ * \return the ground state energy and the sorted ground state bitstrings.
+ */
+std::pair<double, VT<index_t>> GroundStatesOfZZMasks(const VT<index_t>& masks, const VT<double>& coeffs,
+                                                     qbit_t n_qubits, size_t max_n_states);
+
 #define SHIFT_BIT_TWO(obj_low_mask, obj_rev_low_mask, obj_high_mask, obj_rev_high_mask, ori, des)                      \
     do {                                                                                                               \
         (des) = (((ori) & (obj_rev_low_mask)) << 1) + ((ori) & (obj_low_mask));                                        \
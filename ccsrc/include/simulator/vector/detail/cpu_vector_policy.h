@@ -23,6 +23,7 @@
 #include <map>
 #include <memory>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "config/openmp.h"
@@ -31,6 +32,7 @@
 #include "core/utils.h"
 #include "math/tensor/ops_cpu/utils.h"
 #include "math/tensor/traits.h"
+#include "ops/diagonal_energy.h"
 
 namespace mindquantum::sim::vector::detail {
 struct CPUVectorPolicyAvxFloat;
@@ -72,12 +74,24 @@ struct CPUVectorPolicyBase {
     static void ConditionalDiv(const qs_data_p_t& src, qs_data_p_t* des_p, index_t mask, index_t condi,
                                qs_data_t succ_coeff, qs_data_t fail_coeff, index_t dim);
     static void QSMulValue(const qs_data_p_t& src, qs_data_p_t* des_p, qs_data_t value, index_t dim);
+    static void QSAxpy(const qs_data_p_t& src, qs_data_p_t* des_p, qs_data_t value, index_t dim);
     static qs_data_t ConditionalCollect(const qs_data_p_t& qs, index_t mask, index_t condi, bool abs, index_t dim);
     static VT<py_qs_data_t> GetQS(const qs_data_p_t& qs, index_t dim);
     static void SetQS(qs_data_p_t* qs, const VT<qs_data_t>& qs_out, index_t dim);
     static qs_data_p_t ApplyTerms(qs_data_p_t* qs_p, const std::vector<PauliTerm<calc_type>>& ham, index_t dim);
+    //! Write H|qs> into out_p, allocating it when it is null. out_p must not alias qs_p.
+    static void ApplyTerms(qs_data_p_t* qs_p, qs_data_p_t* out_p, const std::vector<PauliTerm<calc_type>>& ham,
+                           index_t dim);
     static py_qs_data_t ExpectationOfTerms(const qs_data_p_t& bra, const qs_data_p_t& ket,
                                            const std::vector<PauliTerm<calc_type>>& ham, index_t dim);
+    //! Scale the quantum state in place by the energy of a diagonal hamiltonian. The energy is read from the table of
+    //! energy when it can be cached, otherwise it's calculated on the fly from Z masks.
+    static void ApplyDiagonal(qs_data_p_t* qs_p, const VT<std::pair<index_t, calc_type>>& terms,
+                              const DiagonalEnergy<calc_type>& energy, index_t dim);
+    //! Calculate <bra|H|ket> for a diagonal hamiltonian in a single fused pass.
+    static py_qs_data_t ExpectationOfDiagonal(const qs_data_p_t& bra, const qs_data_p_t& ket,
+                                              const VT<std::pair<index_t, calc_type>>& terms,
+                                              const DiagonalEnergy<calc_type>& energy, index_t dim);
     static qs_data_p_t Copy(const qs_data_p_t& qs, index_t dim);
     template <index_t mask, index_t condi>
     static py_qs_data_t ConditionVdot(const qs_data_p_t& bra, const qs_data_p_t& ket_p, index_t dim);
@@ -89,6 +103,12 @@ struct CPUVectorPolicyBase {
     static qs_data_p_t CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
                                  const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& b, const qs_data_p_t& vec,
                                  index_t dim);
+    //! Write the sparse matrix product into out_p, allocating it when it is null. out_p must not alias vec.
+    static void CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a, const qs_data_p_t& vec,
+                          qs_data_p_t* out_p, index_t dim);
+    static void CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
+                          const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& b, const qs_data_p_t& vec,
+                          qs_data_p_t* out_p, index_t dim);
     static py_qs_data_t ExpectationOfCsr(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
                                          const qs_data_p_t& bra, const qs_data_p_t& ket, index_t dim);
     static py_qs_data_t ExpectationOfCsr(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
@@ -190,6 +210,9 @@ struct CPUVectorPolicyBase {
     static qs_data_t ExpectDiffGP(const qs_data_p_t& bra, const qs_data_p_t& ket, const qbits_t& objs,
                                   const qbits_t& ctrls, calc_type val, index_t dim);
     static calc_type GroundStateOfZZs(const std::map<index_t, calc_type>& masks_value, qbit_t n_qubits);
+    //! Ground state energy of sum of ZZ terms, and at most max_n_states bitstrings that reach it.
+    static std::pair<calc_type, VT<index_t>> GroundStatesOfZZs(const std::map<index_t, calc_type>& masks_value,
+                                                               qbit_t n_qubits, size_t max_n_states);
 };
 
 template <typename policy_src, typename policy_des>
@@ -41,6 +41,8 @@
 #include "ops/basic_gate.h"
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
+#include "ops/projector.h"
+#include "simulator/compiled_circuit.h"
 #include "simulator/timer.h"
 #include "simulator/utils.h"
 
@@ -103,6 +105,13 @@ class VectorState {
                               const parameter::ParameterResolver& pr = parameter::ParameterResolver(),
                               bool diff = false);
 
+    /*!
+     * \brief Apply a parameterized gate whose parameters are already evaluated.
+     *
+     * \param angles value of every parameter of the gate, in the same order as its prs_.
+     */
+    virtual void ApplyBoundGate(const std::shared_ptr<BasicGate>& gate, const double* angles, bool diff = false);
+
     //! Apply a measurement gate on this quantum state, return the collapsed qubit state
     virtual index_t ApplyMeasure(const std::shared_ptr<BasicGate>& gate);
 
@@ -127,24 +136,50 @@ class VectorState {
                                           const std::shared_ptr<BasicGate>& gate,
                                           const parameter::ParameterResolver& pr, index_t dim) const;
 
-    virtual tensor::Matrix ExpectDiffU3(const qs_data_p_t& bra, const qs_data_p_t& ket,
-                                        const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr,
-                                        index_t dim) const;
+    //! Same as ExpectDiffGate, but with parameters of the gate already evaluated. The gradient of every gate
+    //! parameter is written to grad, which holds max_gate_params values, and the number of parameters is returned.
+    virtual size_t ExpectDiffBoundGate(const qs_data_p_t& bra, const qs_data_p_t& ket,
+                                       const std::shared_ptr<BasicGate>& gate, const double* angles, index_t dim,
+                                       py_qs_data_t* grad) const;
 
-    virtual tensor::Matrix ExpectDiffRn(const qs_data_p_t& bra, const qs_data_p_t& ket,
-                                        const std::shared_ptr<BasicGate>& gate, const parameter::ParameterResolver& pr,
-                                        index_t dim) const;
+    virtual size_t ExpectDiffU3(const qs_data_p_t& bra, const qs_data_p_t& ket, const std::shared_ptr<BasicGate>& gate,
+                                const double* angles, index_t dim, py_qs_data_t* grad) const;
 
-    virtual tensor::Matrix ExpectDiffFSim(const qs_data_p_t& bra, const qs_data_p_t& ket,
-                                          const std::shared_ptr<BasicGate>& gate,
-                                          const parameter::ParameterResolver& pr, index_t dim) const;
+    virtual size_t ExpectDiffRn(const qs_data_p_t& bra, const qs_data_p_t& ket, const std::shared_ptr<BasicGate>& gate,
+                                const double* angles, index_t dim, py_qs_data_t* grad) const;
+
+    virtual size_t ExpectDiffFSim(const qs_data_p_t& bra, const qs_data_p_t& ket,
+                                  const std::shared_ptr<BasicGate>& gate, const double* angles, index_t dim,
+                                  py_qs_data_t* grad) const;
     //! Apply a quantum circuit on this quantum state
     virtual std::map<std::string, int> ApplyCircuit(const circuit_t& circ, const parameter::ParameterResolver& pr
                                                                            = parameter::ParameterResolver());
 
+    //! Apply a quantum circuit with gate parameters bound from compiled circuit, angles = compiled.Bind(x).
+    virtual void ApplyBoundCircuit(const circuit_t& circ, const CompiledCircuit& compiled, const VT<double>& angles);
+
     //! Apply a hamiltonian on this quantum state
     virtual void ApplyHamiltonian(const Hamiltonian<calc_type>& ham);
 
+    //! Evolve this quantum state to exp(-iHt)|psi> with adaptive short-iterative Lanczos method.
+    //! The hamiltonian should be hermitian, tol is the error bound of each Lanczos step.
+    virtual void ApplyHamiltonianEvolution(const Hamiltonian<calc_type>& ham, calc_type t, calc_type tol = 1e-8,
+                                           size_t max_krylov_dim = 16);
+
+    /*!
+     * \brief Solve the lowest k eigenpairs of a hermitian hamiltonian with thick-restart Lanczos method.
+     *
+     * The Lanczos iteration starts from current quantum state, so only the eigenstates that overlap with it can be
+     * found. After solving, this quantum state is set to the ground state.
+     *
+     * \param max_krylov_dim the size of Krylov basis before restart, 0 means max(2k + 10, 20).
+     * \return eigenvalues in ascending order and the corresponding eigenstates.
+     */
+    virtual std::pair<VT<calc_type>, VVT<py_qs_data_t>> SolveLowestEigenStates(const Hamiltonian<calc_type>& ham,
+                                                                                size_t k = 1, calc_type tol = 1e-8,
+                                                                                size_t max_krylov_dim = 0,
+                                                                                size_t max_restart = 300);
+
     //! Get the matrix of quantum circuit.
     virtual VVT<py_qs_data_t> GetCircuitMatrix(const circuit_t& circ, const parameter::ParameterResolver& pr) const;
 
@@ -159,6 +194,17 @@ class VectorState {
                                         const circuit_t& circ_left, const derived_t& simulator_left,
                                         const parameter::ParameterResolver& pr) const;
 
+    //! Get the probability that the quantum state evolved by given circuit survives given projector.
+    virtual calc_type GetProjectorExpectation(const Projector& proj, const circuit_t& circ,
+                                              const parameter::ParameterResolver& pr) const;
+
+    /*!
+     * \brief Project the quantum state with given projector and renormalize it.
+     *
+     * \return the success probability of this post selection.
+     */
+    virtual calc_type PostSelect(const Projector& proj);
+
     //! Get the expectation of hamiltonian
     //! Here a single hamiltonian and single parameter data are needed
     virtual VT<py_qs_data_t> GetExpectationWithGradOneOne(const Hamiltonian<calc_type>& ham, const circuit_t& circ,
@@ -173,6 +219,13 @@ class VectorState {
         const circuit_t& herm_circ, const parameter::ParameterResolver& pr, const MST<size_t>& p_map,
         int n_thread) const;
 
+    //! Get the expectation of hamiltonian
+    //! Here multiple hamiltonian and single parameter vector x ordered as names_ of compiled circuit are needed
+    virtual VVT<py_qs_data_t> GetBoundExpectationWithGradOneMulti(
+        const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ,
+        const circuit_t& herm_circ, const CompiledCircuit& compiled, const CompiledCircuit& herm_compiled,
+        const CompiledJacobian& herm_jacobian, const VT<double>& x, const MST<size_t>& p_map, int n_thread) const;
+
     //! Get the expectation of hamiltonian
     //! Here multiple hamiltonian and multiple parameters are needed
     virtual VT<VVT<py_qs_data_t>> GetExpectationWithGradMultiMulti(
@@ -222,6 +275,11 @@ class VectorState {
     VectorState<policy_des> astype(unsigned seed) const;
 
  protected:
+    //! Calculate H|vec> into a newly allocated quantum state.
+    qs_data_p_t HamiltonianDotVec(const Hamiltonian<calc_type>& ham, const qs_data_p_t& vec) const;
+    //! Calculate H|vec> into out, reusing its buffer when it is not null. out must not alias vec.
+    void HamiltonianDotVec(const Hamiltonian<calc_type>& ham, const qs_data_p_t& vec, qs_data_p_t* out) const;
+
     qs_data_p_t qs = nullptr;  // nullptr represent zero state.
     qbit_t n_qubits = 0;
     index_t dim = 0;
@@ -35,6 +35,7 @@
 #include <string_view>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "core/mq_base_types.h"
@@ -192,12 +193,57 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             bool daggered = static_cast<ISWAPGate*>(gate.get())->daggered_;
             qs_policy_t::ApplyISWAP(&qs, gate->obj_qubits_, gate->ctrl_qubits_, daggered, dim);
         } break;
+        case GateID::SWAPalpha:
+        case GateID::RX:
+        case GateID::RY:
+        case GateID::RZ:
+        case GateID::Rxx:
+        case GateID::Ryy:
+        case GateID::Rzz:
+        case GateID::Rxy:
+        case GateID::Rxz:
+        case GateID::Ryz:
+        case GateID::PS:
+        case GateID::GP:
+        case GateID::U3:
+        case GateID::Rn:
+        case GateID::FSim:
+        case GateID::CUSTOM: {
+            auto angles = GateParameters(gate, pr);
+            ApplyBoundGate(gate, angles.data(), diff);
+        } break;
+        case GateID::M:
+            return this->ApplyMeasure(gate);
+        case GateID::PL:
+            this->ApplyPauliChannel(gate);
+            break;
+        case GateID::DEP:
+            this->ApplyDepolarizingChannel(gate);
+            break;
+        case GateID::AD:
+        case GateID::PD:
+            this->ApplyDampingChannel(gate);
+            break;
+        case GateID::KRAUS:
+            this->ApplyKrausChannel(gate);
+            break;
+        default:
+            throw std::invalid_argument(fmt::format("Apply of gate {} not implement.", id));
+    }
+    return 2;
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::ApplyBoundGate(const std::shared_ptr<BasicGate>& gate, const double* angles,
+                                               bool diff) {
+    auto id = gate->id_;
+    switch (id) {
         case GateID::SWAPalpha: {
             auto g = static_cast<SWAPalphaGate*>(gate.get());
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplySWAPalpha(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::RX: {
@@ -205,7 +251,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRX(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::RY: {
@@ -213,7 +259,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRY(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::RZ: {
@@ -221,7 +267,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRZ(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Rxx: {
@@ -229,7 +275,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRxx(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Ryy: {
@@ -237,7 +283,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRyy(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Rzz: {
@@ -245,7 +291,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRzz(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Rxy: {
@@ -253,7 +299,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRxy(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Rxz: {
@@ -261,7 +307,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRxz(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::Ryz: {
@@ -269,7 +315,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyRyz(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::PS: {
@@ -277,7 +323,7 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyPS(&qs, gate->obj_qubits_, gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::GP: {
@@ -285,81 +331,60 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             if (!g->GradRequired()) {
                 diff = false;
             }
-            auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
+            auto val = static_cast<calc_type>(angles[0]);
             qs_policy_t::ApplyGP(&qs, gate->obj_qubits_[0], gate->ctrl_qubits_, val, dim, diff);
         } break;
         case GateID::U3: {
             if (diff) {
-                std::runtime_error("Can not apply differential format of U3 gate on quantum states currently.");
+                throw std::runtime_error("Can not apply differential format of U3 gate on quantum states currently.");
             }
             auto u3 = static_cast<U3*>(gate.get());
             tensor::Matrix m;
             if (!u3->Parameterized()) {
                 m = u3->base_matrix_;
             } else {
-                auto theta = u3->theta.Combination(pr).const_value;
-                auto phi = u3->phi.Combination(pr).const_value;
-                auto lambda = u3->lambda.Combination(pr).const_value;
-                m = U3Matrix(theta, phi, lambda);
+                m = U3Matrix(tensor::ops::init_with_value(angles[0]), tensor::ops::init_with_value(angles[1]),
+                             tensor::ops::init_with_value(angles[2]));
             }
             qs_policy_t::ApplySingleQubitMatrix(qs, &qs, gate->obj_qubits_[0], gate->ctrl_qubits_,
                                                 tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         } break;
         case GateID::Rn: {
             if (diff) {
-                std::runtime_error("Can not apply differential format of Rn gate on quantum states currently.");
+                throw std::runtime_error("Can not apply differential format of Rn gate on quantum states currently.");
             }
             auto rn = static_cast<Rn*>(gate.get());
             tensor::Matrix m;
             if (!rn->Parameterized()) {
                 m = rn->base_matrix_;
             } else {
-                auto alpha = rn->alpha.Combination(pr).const_value;
-                auto beta = rn->beta.Combination(pr).const_value;
-                auto gamma = rn->gamma.Combination(pr).const_value;
-                m = RnMatrix(alpha, beta, gamma);
+                m = RnMatrix(tensor::ops::init_with_value(angles[0]), tensor::ops::init_with_value(angles[1]),
+                             tensor::ops::init_with_value(angles[2]));
             }
             qs_policy_t::ApplySingleQubitMatrix(qs, &qs, gate->obj_qubits_[0], gate->ctrl_qubits_,
                                                 tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         } break;
         case GateID::FSim: {
             if (diff) {
-                std::runtime_error("Can not apply differential format of FSim gate on quantum states currently.");
+                throw std::runtime_error("Can not apply differential format of FSim gate on quantum states currently.");
             }
             auto fsim = static_cast<FSim*>(gate.get());
             tensor::Matrix m;
             if (!fsim->Parameterized()) {
                 m = fsim->base_matrix_;
             } else {
-                auto theta = fsim->theta.Combination(pr).const_value;
-                auto phi = fsim->phi.Combination(pr).const_value;
-                m = FSimMatrix(theta, phi);
+                m = FSimMatrix(tensor::ops::init_with_value(angles[0]), tensor::ops::init_with_value(angles[1]));
             }
             qs_policy_t::ApplyTwoQubitsMatrix(qs, &qs, gate->obj_qubits_, gate->ctrl_qubits_,
                                               tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         } break;
-        case GateID::M:
-            return this->ApplyMeasure(gate);
-        case GateID::PL:
-            this->ApplyPauliChannel(gate);
-            break;
-        case GateID::DEP:
-            this->ApplyDepolarizingChannel(gate);
-            break;
-        case GateID::AD:
-        case GateID::PD:
-            this->ApplyDampingChannel(gate);
-            break;
-        case GateID::KRAUS:
-            this->ApplyKrausChannel(gate);
-            break;
         case GateID::CUSTOM: {
             auto g = static_cast<CustomGate*>(gate.get());
             tensor::Matrix mat;
             if (!g->Parameterized()) {
                 mat = g->base_matrix_;
             } else {
-                double val = tensor::ops::cpu::to_vector<double>(g->prs_[0].Combination(pr).const_value)[0];
+                double val = angles[0];
                 if (!diff) {
                     mat = g->numba_param_matrix_(val);
                 } else {
@@ -368,12 +393,10 @@ index_t VectorState<qs_policy_t_>::ApplyGate(const std::shared_ptr<BasicGate>& g
             }
             qs_policy_t::ApplyMatrixGate(qs, &qs, gate->obj_qubits_, gate->ctrl_qubits_,
                                          tensor::ops::cpu::to_vector<py_qs_data_t>(mat), dim);
-            break;
-        }
+        } break;
         default:
             throw std::invalid_argument(fmt::format("Apply of gate {} not implement.", id));
     }
-    return 2;
 }
 
 template <typename qs_policy_t_>
@@ -548,7 +571,9 @@ auto VectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham
     auto sub_seed = static_cast<unsigned int>(static_cast<calc_type>(rng_()) * (1 << 20));
     auto ket = derived_t(n_qubits, sub_seed, qs);
     ket.ApplyCircuit(circ, pr);
-    if (ham.how_to_ == ORIGIN) {
+    if (ham.is_diagonal_) {
+        out = qs_policy_t::ExpectationOfDiagonal(ket.qs, ket.qs, ham.diag_terms_, ham.diag_energy_, dim);
+    } else if (ham.how_to_ == ORIGIN) {
         out = qs_policy_t::ExpectationOfTerms(ket.qs, ket.qs, ham.ham_, dim);
     } else if (ham.how_to_ == BACKEND) {
         out = qs_policy_t::ExpectationOfCsr(ham.ham_sparse_main_, ham.ham_sparse_second_, ket.qs, ket.qs, dim);
@@ -569,7 +594,9 @@ auto VectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham
     auto bra = derived_t(n_qubits, sub_seed_bra, qs);
     ket.ApplyCircuit(circ_right, pr);
     bra.ApplyCircuit(circ_left, pr);
-    if (ham.how_to_ == ORIGIN) {
+    if (ham.is_diagonal_) {
+        out = qs_policy_t::ExpectationOfDiagonal(bra.qs, ket.qs, ham.diag_terms_, ham.diag_energy_, dim);
+    } else if (ham.how_to_ == ORIGIN) {
         out = qs_policy_t::ExpectationOfTerms(bra.qs, ket.qs, ham.ham_, dim);
     } else if (ham.how_to_ == BACKEND) {
         out = qs_policy_t::ExpectationOfCsr(ham.ham_sparse_main_, ham.ham_sparse_second_, bra.qs, ket.qs, dim);
@@ -590,7 +617,9 @@ auto VectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham
     ket.ApplyCircuit(circ_right, pr);
     bra.ApplyCircuit(circ_left, pr);
     py_qs_data_t out;
-    if (ham.how_to_ == ORIGIN) {
+    if (ham.is_diagonal_) {
+        out = qs_policy_t::ExpectationOfDiagonal(bra.qs, ket.qs, ham.diag_terms_, ham.diag_energy_, dim);
+    } else if (ham.how_to_ == ORIGIN) {
         out = qs_policy_t::ExpectationOfTerms(bra.qs, ket.qs, ham.ham_, dim);
     } else if (ham.how_to_ == BACKEND) {
         out = qs_policy_t::ExpectationOfCsr(ham.ham_sparse_main_, ham.ham_sparse_second_, bra.qs, ket.qs, dim);
@@ -600,6 +629,33 @@ auto VectorState<qs_policy_t_>::GetExpectation(const Hamiltonian<calc_type>& ham
     return out;
 }
 
+template <typename qs_policy_t_>
+auto VectorState<qs_policy_t_>::GetProjectorExpectation(const Projector& proj, const circuit_t& circ,
+                                                        const parameter::ParameterResolver& pr) const -> calc_type {
+    if (proj.n_qubits_ > static_cast<Index>(n_qubits)) {
+        throw std::invalid_argument(
+            fmt::format("Projector with {} qubits is too large for {} qubits simulator.", proj.n_qubits_, n_qubits));
+    }
+    if (circ.empty()) {
+        return qs_policy_t::ConditionalCollect(qs, proj.FixedMask(), proj.Condition(), true, dim).real();
+    }
+    auto sub_seed = static_cast<unsigned int>(static_cast<calc_type>(rng_()) * (1 << 20));
+    auto ket = derived_t(n_qubits, sub_seed, qs);
+    ket.ApplyCircuit(circ, pr);
+    return qs_policy_t::ConditionalCollect(ket.qs, proj.FixedMask(), proj.Condition(), true, dim).real();
+}
+
+template <typename qs_policy_t_>
+auto VectorState<qs_policy_t_>::PostSelect(const Projector& proj) -> calc_type {
+    auto prob = GetProjectorExpectation(proj, {}, parameter::ParameterResolver());
+    if (prob < PRECISION) {
+        throw std::runtime_error(
+            fmt::format("Can not post select with projector {}, since its probability is zero.", proj.proj_str_));
+    }
+    qs_policy_t::ConditionalMul(qs, &qs, proj.FixedMask(), proj.Condition(), 1 / std::sqrt(prob), 0.0, dim);
+    return prob;
+}
+
 template <typename qs_policy_t_>
 template <typename policy_des, template <typename p_src, typename p_des> class cast_policy>
 auto VectorState<qs_policy_t_>::astype(unsigned seed) const -> VectorState<policy_des> {
@@ -612,150 +668,156 @@ auto VectorState<qs_policy_t_>::ExpectDiffGate(const qs_data_p_t& bra, const qs_
                                                const std::shared_ptr<BasicGate>& gate,
                                                const parameter::ParameterResolver& pr, index_t dim) const
     -> tensor::Matrix {
+    auto angles = GateParameters(gate, pr);
+    py_qs_data_t grad[max_gate_params];
+    auto n_grad = ExpectDiffBoundGate(bra, ket, gate, angles.data(), dim, grad);
+    return tensor::ops::cpu::init_with_row(grad, n_grad);
+}
+
+template <typename qs_policy_t_>
+auto VectorState<qs_policy_t_>::ExpectDiffBoundGate(const qs_data_p_t& bra, const qs_data_p_t& ket,
+                                                    const std::shared_ptr<BasicGate>& gate, const double* angles,
+                                                    index_t dim, py_qs_data_t* grad) const -> size_t {
     auto id = gate->id_;
-    auto g = static_cast<Parameterizable*>(gate.get());
-    auto val = tensor::ops::cpu::to_vector<calc_type>(g->prs_[0].Combination(pr).const_value)[0];
-    VT<py_qs_data_t> grad = {0};
+    auto val = static_cast<calc_type>(angles[0]);
     switch (id) {
         case GateID::RX:
             grad[0] = qs_policy_t::ExpectDiffRX(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::RY:
             grad[0] = qs_policy_t::ExpectDiffRY(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::RZ:
             grad[0] = qs_policy_t::ExpectDiffRZ(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::Rxx:
             grad[0] = qs_policy_t::ExpectDiffRxx(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::Rzz:
             grad[0] = qs_policy_t::ExpectDiffRzz(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::Ryy:
             grad[0] = qs_policy_t::ExpectDiffRyy(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::Rxy:
             grad[0] = qs_policy_t::ExpectDiffRxy(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::Rxz:
             grad[0] = qs_policy_t::ExpectDiffRxz(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::Ryz:
             grad[0] = qs_policy_t::ExpectDiffRyz(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::PS:
             grad[0] = qs_policy_t::ExpectDiffPS(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::GP:
             grad[0] = qs_policy_t::ExpectDiffGP(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::SWAPalpha:
             grad[0] = qs_policy_t::ExpectDiffSWAPalpha(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_, val, dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+            break;
         case GateID::CUSTOM: {
             auto g = static_cast<CustomGate*>(gate.get());
             tensor::Matrix mat = g->numba_param_diff_matrix_(val);
             grad[0] = qs_policy_t::ExpectDiffMatrixGate(bra, ket, gate->obj_qubits_, gate->ctrl_qubits_,
-                                                        tensor::ops::cpu::to_vector<py_qs_data_t>(mat), dim);
-            return tensor::Matrix(VVT<py_qs_data_t>({grad}));
+                                                           tensor::ops::cpu::to_vector<py_qs_data_t>(mat), dim);
+            break;
         }
         case GateID::U3:
-            return ExpectDiffU3(bra, ket, gate, pr, dim);
+            return ExpectDiffU3(bra, ket, gate, angles, dim, grad);
         case GateID::Rn:
-            return ExpectDiffRn(bra, ket, gate, pr, dim);
+            return ExpectDiffRn(bra, ket, gate, angles, dim, grad);
         case GateID::FSim:
-            return ExpectDiffFSim(bra, ket, gate, pr, dim);
+            return ExpectDiffFSim(bra, ket, gate, angles, dim, grad);
         default:
             throw std::invalid_argument(fmt::format("Expectation of gate {} not implement.", id));
     }
+    return 1;
 }
 
 template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::ExpectDiffU3(const qs_data_p_t& bra, const qs_data_p_t& ket,
-                                             const std::shared_ptr<BasicGate>& gate,
-                                             const parameter::ParameterResolver& pr, index_t dim) const
-    -> tensor::Matrix {
-    VT<py_qs_data_t> grad = {0, 0, 0};
+                                             const std::shared_ptr<BasicGate>& gate, const double* angles, index_t dim,
+                                             py_qs_data_t* grad) const -> size_t {
+    std::fill(grad, grad + 3, py_qs_data_t(0));
     auto u3 = static_cast<U3*>(gate.get());
     if (u3->parameterized_) {
         tensor::Matrix m;
-        auto theta = u3->theta.Combination(pr).const_value;
-        auto phi = u3->phi.Combination(pr).const_value;
-        auto lambda = u3->lambda.Combination(pr).const_value;
-        if (u3->theta.data_.size() != u3->theta.no_grad_parameters_.size()) {
+        auto theta = tensor::ops::init_with_value(angles[0]);
+        auto phi = tensor::ops::init_with_value(angles[1]);
+        auto lambda = tensor::ops::init_with_value(angles[2]);
+        if (u3->theta.HasRequireGradParams()) {
             m = U3DiffThetaMatrix(theta, phi, lambda);
             grad[0] = qs_policy_t::ExpectDiffSingleQubitMatrix(bra, ket, u3->obj_qubits_, u3->ctrl_qubits_,
                                                                tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         }
-        if (u3->phi.data_.size() != u3->phi.no_grad_parameters_.size()) {
+        if (u3->phi.HasRequireGradParams()) {
             m = U3DiffPhiMatrix(theta, phi, lambda);
             grad[1] = qs_policy_t::ExpectDiffSingleQubitMatrix(bra, ket, u3->obj_qubits_, u3->ctrl_qubits_,
                                                                tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         }
-        if (u3->lambda.data_.size() != u3->lambda.no_grad_parameters_.size()) {
+        if (u3->lambda.HasRequireGradParams()) {
             m = U3DiffLambdaMatrix(theta, phi, lambda);
             grad[2] = qs_policy_t::ExpectDiffSingleQubitMatrix(bra, ket, u3->obj_qubits_, u3->ctrl_qubits_,
                                                                tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         }
     }
-    return tensor::Matrix(VVT<py_qs_data_t>{grad});
+    return 3;
 }
 
 template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::ExpectDiffRn(const qs_data_p_t& bra, const qs_data_p_t& ket,
-                                             const std::shared_ptr<BasicGate>& gate,
-                                             const parameter::ParameterResolver& pr, index_t dim) const
-    -> tensor::Matrix {
-    VT<py_qs_data_t> grad = {0, 0, 0};
+                                             const std::shared_ptr<BasicGate>& gate, const double* angles, index_t dim,
+                                             py_qs_data_t* grad) const -> size_t {
+    std::fill(grad, grad + 3, py_qs_data_t(0));
     auto rn = static_cast<Rn*>(gate.get());
     if (rn->parameterized_) {
         tensor::Matrix m;
-        auto alpha = rn->alpha.Combination(pr).const_value;
-        auto beta = rn->beta.Combination(pr).const_value;
-        auto gamma = rn->gamma.Combination(pr).const_value;
-        if (rn->alpha.data_.size() != rn->alpha.no_grad_parameters_.size()) {
+        auto alpha = tensor::ops::init_with_value(angles[0]);
+        auto beta = tensor::ops::init_with_value(angles[1]);
+        auto gamma = tensor::ops::init_with_value(angles[2]);
+        if (rn->alpha.HasRequireGradParams()) {
             m = RnDiffAlphaMatrix(alpha, beta, gamma);
             grad[0] = qs_policy_t::ExpectDiffSingleQubitMatrix(bra, ket, rn->obj_qubits_, rn->ctrl_qubits_,
                                                                tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         }
-        if (rn->beta.data_.size() != rn->beta.no_grad_parameters_.size()) {
+        if (rn->beta.HasRequireGradParams()) {
             m = RnDiffBetaMatrix(alpha, beta, gamma);
             grad[1] = qs_policy_t::ExpectDiffSingleQubitMatrix(bra, ket, rn->obj_qubits_, rn->ctrl_qubits_,
                                                                tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         }
-        if (rn->gamma.data_.size() != rn->gamma.no_grad_parameters_.size()) {
+        if (rn->gamma.HasRequireGradParams()) {
             m = RnDiffGammaMatrix(alpha, beta, gamma);
             grad[2] = qs_policy_t::ExpectDiffSingleQubitMatrix(bra, ket, rn->obj_qubits_, rn->ctrl_qubits_,
                                                                tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         }
     }
-    return tensor::Matrix(VVT<py_qs_data_t>{grad});
+    return 3;
 }
 
 template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::ExpectDiffFSim(const qs_data_p_t& bra, const qs_data_p_t& ket,
-                                               const std::shared_ptr<BasicGate>& gate,
-                                               const parameter::ParameterResolver& pr, index_t dim) const
-    -> tensor::Matrix {
-    VT<py_qs_data_t> grad = {0, 0};
+                                               const std::shared_ptr<BasicGate>& gate, const double* angles,
+                                               index_t dim, py_qs_data_t* grad) const -> size_t {
+    std::fill(grad, grad + 2, py_qs_data_t(0));
     auto fsim = static_cast<FSim*>(gate.get());
     if (fsim->parameterized_) {
         tensor::Matrix m;
-        auto theta = fsim->theta.Combination(pr).const_value;
-        auto phi = fsim->phi.Combination(pr).const_value;
-        if (fsim->theta.data_.size() != fsim->theta.no_grad_parameters_.size()) {
+        auto theta = tensor::ops::init_with_value(angles[0]);
+        auto phi = tensor::ops::init_with_value(angles[1]);
+        if (fsim->theta.HasRequireGradParams()) {
             m = FSimDiffThetaMatrix(theta);  // can be optimized.
             grad[0] = qs_policy_t::ExpectDiffTwoQubitsMatrix(bra, ket, fsim->obj_qubits_, fsim->ctrl_qubits_,
                                                              tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         }
-        if (fsim->phi.data_.size() != fsim->phi.no_grad_parameters_.size()) {
+        if (fsim->phi.HasRequireGradParams()) {
             m = FSimDiffPhiMatrix(phi);
             grad[1] = qs_policy_t::ExpectDiffTwoQubitsMatrix(bra, ket, fsim->obj_qubits_, fsim->ctrl_qubits_,
                                                              tensor::ops::cpu::to_vector<py_qs_data_t>(m), dim);
         }
     }
-    return tensor::Matrix(VVT<py_qs_data_t>{grad});
+    return 2;
 }
 
 template <typename qs_policy_t_>
@@ -773,19 +835,286 @@ std::map<std::string, int> VectorState<qs_policy_t_>::ApplyCircuit(const circuit
 }
 
 template <typename qs_policy_t_>
-void VectorState<qs_policy_t_>::ApplyHamiltonian(const Hamiltonian<calc_type>& ham) {
-    qs_data_p_t new_qs;
-    if (ham.how_to_ == ORIGIN) {
-        new_qs = qs_policy_t::ApplyTerms(&qs, ham.ham_, dim);
+void VectorState<qs_policy_t_>::ApplyBoundCircuit(const circuit_t& circ, const CompiledCircuit& compiled,
+                                                  const VT<double>& angles) {
+    auto pr = parameter::ParameterResolver();
+    for (size_t i = 0; i < circ.size(); i++) {
+        if (compiled.gate_rows_[i] == CompiledCircuit::npos) {
+            ApplyGate(circ[i], pr, false);
+        } else {
+            ApplyBoundGate(circ[i], angles.data() + compiled.gate_rows_[i]);
+        }
+    }
+}
+
+template <typename qs_policy_t_>
+auto VectorState<qs_policy_t_>::HamiltonianDotVec(const Hamiltonian<calc_type>& ham, const qs_data_p_t& vec) const
+    -> qs_data_p_t {
+    qs_data_p_t new_qs = nullptr;
+    HamiltonianDotVec(ham, vec, &new_qs);
+    return new_qs;
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::HamiltonianDotVec(const Hamiltonian<calc_type>& ham, const qs_data_p_t& vec,
+                                                  qs_data_p_t* out) const {
+    auto tmp = vec;
+    if (tmp == nullptr) {
+        tmp = qs_policy_t::InitState(dim);
+    }
+    if (ham.is_diagonal_) {
+        qs_policy_t::QSMulValue(tmp, out, 1, dim);
+        qs_policy_t::ApplyDiagonal(out, ham.diag_terms_, ham.diag_energy_, dim);
+    } else if (ham.how_to_ == ORIGIN) {
+        qs_policy_t::ApplyTerms(&tmp, out, ham.ham_, dim);
     } else if (ham.how_to_ == BACKEND) {
-        new_qs = qs_policy_t::CsrDotVec(ham.ham_sparse_main_, ham.ham_sparse_second_, qs, dim);
+        qs_policy_t::CsrDotVec(ham.ham_sparse_main_, ham.ham_sparse_second_, tmp, out, dim);
     } else {
-        new_qs = qs_policy_t::CsrDotVec(ham.ham_sparse_main_, qs, dim);
+        qs_policy_t::CsrDotVec(ham.ham_sparse_main_, tmp, out, dim);
     }
+    if (vec == nullptr) {
+        qs_policy_t::FreeState(&tmp);
+    }
+}
+
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::ApplyHamiltonian(const Hamiltonian<calc_type>& ham) {
+    if (ham.is_diagonal_) {
+        // Diagonal hamiltonian only scales every amplitude, so no new quantum state is allocated.
+        qs_policy_t::ApplyDiagonal(&qs, ham.diag_terms_, ham.diag_energy_, dim);
+        return;
+    }
+    auto new_qs = HamiltonianDotVec(ham, qs);
     qs_policy_t::FreeState(&qs);
     qs = new_qs;
 }
 
+template <typename qs_policy_t_>
+void VectorState<qs_policy_t_>::ApplyHamiltonianEvolution(const Hamiltonian<calc_type>& ham, calc_type t,
+                                                          calc_type tol, size_t max_krylov_dim) {
+    if (max_krylov_dim < 2) {
+        throw std::invalid_argument("max_krylov_dim should be at least 2.");
+    }
+    if (!(tol > 0)) {
+        throw std::invalid_argument("tol should be positive.");
+    }
+    if (t == 0) {
+        return;
+    }
+    if (qs == nullptr) {
+        qs = qs_policy_t::InitState(dim);
+    }
+    double norm = std::sqrt(std::real(qs_policy_t::Vdot(qs, qs, dim)));
+    if (norm == 0) {
+        return;
+    }
+    // Krylov vectors are kept alive across steps, H|v_j> of each step is written into the buffer of v_{j+1} and the
+    // evolved state is accumulated into the buffer that held v_0 of the former step.
+    VT<qs_data_p_t> krylov(max_krylov_dim + 1, nullptr);
+    double direction = t > 0 ? 1.0 : -1.0;
+    double t_left = std::abs(static_cast<double>(t));
+    double dt = t_left;
+    while (t_left > 0) {
+        double step = std::min(dt, t_left);
+        std::swap(krylov[0], qs);
+        qs_policy_t::QSMulValue(krylov[0], &krylov[0], 1.0 / norm, dim);
+
+        VT<double> alpha;
+        VT<double> beta;
+        bool exhausted = false;
+        for (size_t j = 0; j < max_krylov_dim; j++) {
+            HamiltonianDotVec(ham, krylov[j], &krylov[j + 1]);
+            auto& w = krylov[j + 1];
+            double a = std::real(qs_policy_t::Vdot(krylov[j], w, dim));
+            qs_policy_t::QSAxpy(krylov[j], &w, -a, dim);
+            if (j != 0) {
+                qs_policy_t::QSAxpy(krylov[j - 1], &w, -beta.back(), dim);
+            }
+            double b = std::sqrt(std::real(qs_policy_t::Vdot(w, w, dim)));
+            alpha.push_back(a);
+            if (b <= PRECISION * std::max(1.0, std::abs(a))) {
+                // Krylov space is invariant under H, so the propagation is exact for any time.
+                exhausted = true;
+                break;
+            }
+            beta.push_back(b);
+            qs_policy_t::QSMulValue(krylov[j + 1], &krylov[j + 1], 1.0 / b, dim);
+            auto coeff = TridiagExpDotE0(alpha, beta, direction * step);
+            if (b * std::abs(coeff.back()) < tol) {
+                break;
+            }
+        }
+
+        // Shrink the time step until the Lanczos error estimate beta_k |c_k| is under control.
+        double err = 0;
+        VT<std::complex<double>> coeff;
+        if (exhausted) {
+            step = t_left;
+            coeff = TridiagExpDotE0(alpha, beta, direction * step);
+        } else {
+            while (true) {
+                coeff = TridiagExpDotE0(alpha, beta, direction * step);
+                err = beta.back() * std::abs(coeff.back());
+                if (err < tol || step <= PRECISION * t_left) {
+                    break;
+                }
+                step *= 0.5;
+            }
+        }
+
+        auto c0 = norm * coeff[0];
+        qs_policy_t::QSMulValue(krylov[0], &qs, py_qs_data_t(c0.real(), c0.imag()), dim);
+        for (size_t j = 1; j < alpha.size(); j++) {
+            auto c = norm * coeff[j];
+            qs_policy_t::QSAxpy(krylov[j], &qs, py_qs_data_t(c.real(), c.imag()), dim);
+        }
+        t_left -= step;
+        if (err > 0) {
+            dt = step * std::min(2.0, 0.9 * std::pow(tol / err, 1.0 / static_cast<double>(alpha.size())));
+        } else {
+            dt = 2 * step;
+        }
+    }
+    for (auto& v : krylov) {
+        qs_policy_t::FreeState(&v);
+    }
+}
+
+template <typename qs_policy_t_>
+auto VectorState<qs_policy_t_>::SolveLowestEigenStates(const Hamiltonian<calc_type>& ham, size_t k, calc_type tol,
+                                                       size_t max_krylov_dim, size_t max_restart)
+    -> std::pair<VT<calc_type>, VVT<py_qs_data_t>> {
+    if (k == 0 || k > dim) {
+        throw std::invalid_argument("k should be in range [1, " + std::to_string(dim) + "].");
+    }
+    if (!(tol > 0)) {
+        throw std::invalid_argument("tol should be positive.");
+    }
+    size_t m = max_krylov_dim == 0 ? std::max<size_t>(2 * k + 10, 20) : max_krylov_dim;
+    m = std::min<size_t>(m, dim);
+    if (m < std::min<size_t>(k + 2, dim)) {
+        throw std::invalid_argument("max_krylov_dim should be at least k + 2.");
+    }
+    VT<qs_data_p_t> basis(m + 1, nullptr);
+    auto free_basis = [&]() {
+        for (auto& v : basis) {
+            qs_policy_t::FreeState(&v);
+        }
+    };
+    basis[0] = qs == nullptr ? qs_policy_t::InitState(dim) : qs_policy_t::Copy(qs, dim);
+    double norm = std::sqrt(std::real(qs_policy_t::Vdot(basis[0], basis[0], dim)));
+    if (norm == 0) {
+        free_basis();
+        throw std::runtime_error("Initial quantum state of Lanczos method should not be zero.");
+    }
+    qs_policy_t::QSMulValue(basis[0], &basis[0], 1.0 / norm, dim);
+
+    // proj stores the hamiltonian projected into the Krylov basis. After a thick restart it is an arrowhead matrix
+    // followed by the usual tridiagonal part.
+    VVT<double> proj(m, VT<double>(m, 0.0));
+    VT<double> eig_val;
+    VVT<double> eig_vec;
+    size_t n_keep = 0;
+    size_t n_basis = m;
+    for (size_t restart = 0;; restart++) {
+        double beta = 0;
+        bool invariant = false;
+        n_basis = m;
+        for (size_t j = n_keep; j < m; j++) {
+            HamiltonianDotVec(ham, basis[j], &basis[j + 1]);
+            auto& w = basis[j + 1];
+            // Full re-orthogonalization, the second pass of Gram-Schmidt cleans up the rounding error.
+            for (int pass = 0; pass < 2; pass++) {
+                for (size_t i = 0; i <= j; i++) {
+                    auto overlap = qs_policy_t::Vdot(basis[i], w, dim);
+                    qs_policy_t::QSAxpy(basis[i], &w, -overlap, dim);
+                    proj[i][j] = (pass == 0 ? 0.0 : proj[i][j]) + std::real(overlap);
+                    proj[j][i] = proj[i][j];
+                }
+            }
+            beta = std::sqrt(std::real(qs_policy_t::Vdot(w, w, dim)));
+            if (beta <= PRECISION * std::max(1.0, std::abs(proj[j][j]))) {
+                invariant = true;
+                n_basis = j + 1;
+                break;
+            }
+            qs_policy_t::QSMulValue(basis[j + 1], &basis[j + 1], 1.0 / beta, dim);
+            if (j + 1 < m) {
+                proj[j][j + 1] = proj[j + 1][j] = beta;
+            }
+        }
+
+        VVT<double> sub(n_basis, VT<double>(n_basis));
+        for (size_t i = 0; i < n_basis; i++) {
+            std::copy(proj[i].begin(), proj[i].begin() + n_basis, sub[i].begin());
+        }
+        eig_vec = SymEigen(sub, &eig_val);
+        bool converged = invariant;
+        if (!invariant) {
+            converged = true;
+            for (size_t i = 0; i < k; i++) {
+                // Residual norm of Ritz pair is |beta_m u_{m, i}|.
+                if (beta * std::abs(eig_vec[n_basis - 1][i]) > tol * std::max(1.0, std::abs(eig_val[i]))) {
+                    converged = false;
+                    break;
+                }
+            }
+        }
+        if (converged && n_basis < k) {
+            free_basis();
+            throw std::runtime_error("Krylov subspace of initial state is invariant with dimension "
+                                     + std::to_string(n_basis) + ", which is smaller than k.");
+        }
+        if (converged) {
+            break;
+        }
+        if (restart == max_restart) {
+            free_basis();
+            throw std::runtime_error("Lanczos method not converged after " + std::to_string(max_restart)
+                                     + " restarts.");
+        }
+
+        // Thick restart: keep the lowest Ritz vectors and continue the Lanczos iteration from the residual.
+        n_keep = std::min(k + (m - k) / 2, m - 1);
+        VT<qs_data_p_t> ritz(n_keep, nullptr);
+        for (size_t c = 0; c < n_keep; c++) {
+            ritz[c] = qs_policy_t::InitState(dim, false);
+            for (size_t j = 0; j < m; j++) {
+                qs_policy_t::QSAxpy(basis[j], &ritz[c], eig_vec[j][c], dim);
+            }
+        }
+        // The residual moves to slot n_keep, the buffers after it are overwritten by the next Lanczos steps.
+        std::swap(basis[n_keep], basis[m]);
+        for (auto& row : proj) {
+            std::fill(row.begin(), row.end(), 0.0);
+        }
+        for (size_t c = 0; c < n_keep; c++) {
+            qs_policy_t::FreeState(&basis[c]);
+            basis[c] = ritz[c];
+            proj[c][c] = eig_val[c];
+        }
+    }
+
+    VT<calc_type> values(k);
+    VVT<py_qs_data_t> states(k);
+    for (size_t c = 0; c < k; c++) {
+        auto state = qs_policy_t::InitState(dim, false);
+        for (size_t j = 0; j < n_basis; j++) {
+            qs_policy_t::QSAxpy(basis[j], &state, eig_vec[j][c], dim);
+        }
+        values[c] = static_cast<calc_type>(eig_val[c]);
+        states[c] = qs_policy_t::GetQS(state, dim);
+        if (c == 0) {
+            qs_policy_t::FreeState(&qs);
+            qs = state;
+        } else {
+            qs_policy_t::FreeState(&state);
+        }
+    }
+    free_basis();
+    return {values, states};
+}
+
 template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::GetCircuitMatrix(const circuit_t& circ, const parameter::ParameterResolver& pr) const
     -> VVT<py_qs_data_t> {
@@ -815,25 +1144,34 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradOneOne(const Hamiltonian<c
     // auto timer = Timer();
     // timer.Start("First part");
     VT<py_qs_data_t> f_and_g(1 + p_map.size(), 0);
+    auto compiled = CompiledCircuit(circ);
+    auto herm_compiled = CompiledCircuit(herm_circ, compiled.names_);
+    auto herm_jacobian = CompiledJacobian(herm_circ, p_map);
+    auto x = compiled.Values(pr);
+    auto angles = compiled.Bind(x);
+    auto herm_angles = herm_compiled.Bind(x);
+    auto empty_pr = parameter::ParameterResolver();
     VectorState<qs_policy_t> sim_l = *this;
-    sim_l.ApplyCircuit(circ, pr);
+    sim_l.ApplyBoundCircuit(circ, compiled, angles);
     VectorState<qs_policy_t> sim_r = sim_l;
     sim_r.ApplyHamiltonian(ham);
     f_and_g[0] = qs_policy_t::Vdot(sim_l.qs, sim_r.qs, dim);
     // timer.EndAndStartOther("First part", "Second part");
-    for (const auto& g : herm_circ) {
-        sim_l.ApplyGate(g, pr);
-        if (g->GradRequired()) {
-            auto p_gate = static_cast<Parameterizable*>(g.get());
-            if (const auto& [title, jac] = p_gate->jacobi; title.size() != 0) {
-                auto intrin_grad = ExpectDiffGate(sim_l.qs, sim_r.qs, g, pr, dim);
-                auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
-                for (const auto& [name, idx] : title) {
-                    f_and_g[1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
-                }
-            }
+    for (size_t k = 0; k < herm_circ.size(); k++) {
+        const auto& g = herm_circ[k];
+        auto row = herm_compiled.gate_rows_[k];
+        if (row == CompiledCircuit::npos) {
+            sim_l.ApplyGate(g, empty_pr);
+            sim_r.ApplyGate(g, empty_pr);
+            continue;
         }
-        sim_r.ApplyGate(g, pr);
+        sim_l.ApplyBoundGate(g, herm_angles.data() + row);
+        if (herm_jacobian.HasGrad(k)) {
+            py_qs_data_t intrin_grad[max_gate_params];
+            ExpectDiffBoundGate(sim_l.qs, sim_r.qs, g, herm_angles.data() + row, dim, intrin_grad);
+            herm_jacobian.AddRealGrad(k, intrin_grad, f_and_g.data() + 1);
+        }
+        sim_r.ApplyBoundGate(g, herm_angles.data() + row);
     }
     // timer.End("Second part");
     // timer.Analyze();
@@ -885,6 +1223,7 @@ auto VectorState<qs_policy_t_>::LeftSizeGradOneMulti(const std::vector<std::shar
     }
 
     VVT<py_qs_data_t> f_and_g(n_hams, VT<py_qs_data_t>((1 + p_map.size()), 0));
+    auto herm_jacobian = CompiledJacobian(herm_left_circ, p_map);
 
     int n_group = n_hams / n_thread;
     if (n_hams % n_thread) {
@@ -903,18 +1242,14 @@ auto VectorState<qs_policy_t_>::LeftSizeGradOneMulti(const std::vector<std::shar
             sim_rs[j - start].ApplyHamiltonian(*hams[j]);
             f_and_g[j][0] = qs_policy_t::Vdot(sim_l.qs, sim_rs[j - start].qs, dim);
         }
-        for (const auto& g : herm_left_circ) {
+        for (size_t k = 0; k < herm_left_circ.size(); k++) {
+            const auto& g = herm_left_circ[k];
             sim_l.ApplyGate(g, pr);
-            if (g->GradRequired()) {
-                auto p_gate = static_cast<Parameterizable*>(g.get());
-                if (const auto& [title, jac] = p_gate->jacobi; title.size() != 0) {
-                    for (int j = start; j < end; j++) {
-                        auto intrin_grad = ExpectDiffGate(sim_l.qs, sim_rs[j - start].qs, g, pr, dim);
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
-                        for (const auto& [name, idx] : title) {
-                            f_and_g[j][1 + p_map.at(name)] += p_grad[0][idx];
-                        }
-                    }
+            if (herm_jacobian.HasGrad(k)) {
+                for (int j = start; j < end; j++) {
+                    auto intrin_grad = ExpectDiffGate(sim_l.qs, sim_rs[j - start].qs, g, pr, dim);
+                    herm_jacobian.AddGrad(k, reinterpret_cast<const py_qs_data_t*>(intrin_grad.data),
+                                          f_and_g[j].data() + 1);
                 }
             }
             for (int j = start; j < end; j++) {
@@ -929,6 +1264,18 @@ template <typename qs_policy_t_>
 auto VectorState<qs_policy_t_>::GetExpectationWithGradOneMulti(
     const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ, const circuit_t& herm_circ,
     const parameter::ParameterResolver& pr, const MST<size_t>& p_map, int n_thread) const -> VVT<py_qs_data_t> {
+    auto compiled = CompiledCircuit(circ);
+    auto herm_compiled = CompiledCircuit(herm_circ, compiled.names_);
+    auto herm_jacobian = CompiledJacobian(herm_circ, p_map);
+    return GetBoundExpectationWithGradOneMulti(hams, circ, herm_circ, compiled, herm_compiled, herm_jacobian,
+                                               compiled.Values(pr), p_map, n_thread);
+}
+
+template <typename qs_policy_t_>
+auto VectorState<qs_policy_t_>::GetBoundExpectationWithGradOneMulti(
+    const std::vector<std::shared_ptr<Hamiltonian<calc_type>>>& hams, const circuit_t& circ, const circuit_t& herm_circ,
+    const CompiledCircuit& compiled, const CompiledCircuit& herm_compiled, const CompiledJacobian& herm_jacobian,
+    const VT<double>& x, const MST<size_t>& p_map, int n_thread) const -> VVT<py_qs_data_t> {
     auto n_hams = hams.size();
     int max_thread = 15;
     if (n_thread == 0) {
@@ -941,8 +1288,11 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradOneMulti(
         n_thread = n_hams;
     }
     VVT<py_qs_data_t> f_and_g(n_hams, VT<py_qs_data_t>((1 + p_map.size()), 0));
+    auto angles = compiled.Bind(x);
+    auto herm_angles = herm_compiled.Bind(x);
+    auto empty_pr = parameter::ParameterResolver();
     VectorState<qs_policy_t> sim = *this;
-    sim.ApplyCircuit(circ, pr);
+    sim.ApplyBoundCircuit(circ, compiled, angles);
     int n_group = n_hams / n_thread;
     if (n_hams % n_thread) {
         n_group += 1;
@@ -960,22 +1310,27 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradOneMulti(
             sim_rs[j - start].ApplyHamiltonian(*hams[j]);
             f_and_g[j][0] = qs_policy_t::Vdot(sim_l.qs, sim_rs[j - start].qs, dim);
         }
-        for (const auto& g : herm_circ) {
-            sim_l.ApplyGate(g, pr);
-            if (g->GradRequired()) {
-                auto p_gate = static_cast<Parameterizable*>(g.get());
-                if (const auto& [title, jac] = p_gate->jacobi; title.size() != 0) {
-                    for (int j = start; j < end; j++) {
-                        auto intrin_grad = ExpectDiffGate(sim_l.qs, sim_rs[j - start].qs, g, pr, dim);
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
-                        for (const auto& [name, idx] : title) {
-                            f_and_g[j][1 + p_map.at(name)] += 2 * std::real(p_grad[0][idx]);
-                        }
-                    }
+        for (size_t k = 0; k < herm_circ.size(); k++) {
+            const auto& g = herm_circ[k];
+            auto row = herm_compiled.gate_rows_[k];
+            if (row == CompiledCircuit::npos) {
+                sim_l.ApplyGate(g, empty_pr);
+                for (int j = start; j < end; j++) {
+                    sim_rs[j - start].ApplyGate(g, empty_pr);
+                }
+                continue;
+            }
+            auto g_angles = herm_angles.data() + row;
+            sim_l.ApplyBoundGate(g, g_angles);
+            if (herm_jacobian.HasGrad(k)) {
+                for (int j = start; j < end; j++) {
+                    py_qs_data_t intrin_grad[max_gate_params];
+                    ExpectDiffBoundGate(sim_l.qs, sim_rs[j - start].qs, g, g_angles, dim, intrin_grad);
+                    herm_jacobian.AddRealGrad(k, intrin_grad, f_and_g[j].data() + 1);
                 }
             }
             for (int j = start; j < end; j++) {
-                sim_rs[j - start].ApplyGate(g, pr);
+                sim_rs[j - start].ApplyBoundGate(g, g_angles);
             }
         }
     }
@@ -1136,11 +1491,22 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradMultiMulti(
     for (size_t i = 0; i < ans_name.size(); i++) {
         p_map[ans_name[i]] = i + enc_name.size();
     }
+    VS names = enc_name;
+    names.insert(names.end(), ans_name.begin(), ans_name.end());
+    auto compiled = CompiledCircuit(circ, names);
+    auto herm_compiled = CompiledCircuit(herm_circ, compiled.names_);
+    auto herm_jacobian = CompiledJacobian(herm_circ, p_map);
+    if (compiled.names_.size() != n_params) {
+        throw std::runtime_error("parameter " + compiled.names_[n_params] + " not in this parameter resolver.");
+    }
+    auto get_x = [&](size_t n) {
+        VT<double> x(enc_data[n].begin(), enc_data[n].end());
+        x.insert(x.end(), ans_data.begin(), ans_data.end());
+        return x;
+    };
     if (n_prs == 1) {
-        parameter::ParameterResolver pr = parameter::ParameterResolver();
-        pr.SetItems(enc_name, enc_data[0]);
-        pr.SetItems(ans_name, ans_data);
-        output[0] = GetExpectationWithGradOneMulti(hams, circ, herm_circ, pr, p_map, mea_threads);
+        output[0] = GetBoundExpectationWithGradOneMulti(hams, circ, herm_circ, compiled, herm_compiled, herm_jacobian,
+                                                        get_x(0), p_map, mea_threads);
     } else {
         if (batch_threads == 0) {
             throw std::runtime_error("batch_threads cannot be zero.");
@@ -1158,10 +1524,8 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradMultiMulti(
             }
             auto task = [&, start, end]() {
                 for (size_t n = start; n < end; n++) {
-                    parameter::ParameterResolver pr = parameter::ParameterResolver();
-                    pr.SetItems(enc_name, enc_data[n]);
-                    pr.SetItems(ans_name, ans_data);
-                    auto f_g = GetExpectationWithGradOneMulti(hams, circ, herm_circ, pr, p_map, mea_threads);
+                    auto f_g = GetBoundExpectationWithGradOneMulti(hams, circ, herm_circ, compiled, herm_compiled,
+                                                                   herm_jacobian, get_x(n), p_map, mea_threads);
                     output[n] = f_g;
                 }
             };
@@ -1191,6 +1555,7 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftOneMulti(
     }
     auto tmp_pr{pr};
     VVT<py_qs_data_t> f_and_g(n_hams, VT<py_qs_data_t>((1 + p_map.size()), 0));
+    auto jacobian = CompiledJacobian(circ, p_map);
     VectorState<qs_policy_t> sim = *this;
     sim.SetSeed(static_cast<unsigned>(this->rng_() * 10000));
     sim.ApplyCircuit(circ, pr);
@@ -1213,8 +1578,9 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftOneMulti(
             sim_rs[j - start].ApplyHamiltonian(*hams[j]);
             f_and_g[j][0] = qs_policy_t::Vdot(sim_l.qs, sim_rs[j - start].qs, dim);
         }
-        for (auto& gate : circ) {
-            if (gate->GradRequired()) {
+        for (size_t n = 0; n < circ.size(); n++) {
+            auto& gate = circ[n];
+            if (jacobian.HasGrad(n)) {
                 auto p_gate = static_cast<Parameterizable*>(gate.get());
                 calc_type pr_shift = M_PI_2;
                 calc_type coeff = 0.5;
@@ -1230,70 +1596,64 @@ auto VectorState<qs_policy_t_>::GetExpectationWithGradParameterShiftOneMulti(
                     pr_shift = 0.001;
                     coeff = 0.5 / pr_shift;
                 }
-                if (const auto& [title, jac] = p_gate->jacobi; title.size() != 0) {
-                    for (int j = start; j < end; j++) {
-                        VT<py_qs_data_t> intrin_grad_list(p_gate->prs_.size());
-                        for (int k = 0; k < p_gate->prs_.size(); k++) {
-                            p_gate->prs_[k] += -pr_shift;
-                            if (gate->id_ == GateID::U3 || gate->id_ == GateID::FSim) {
-                                parameter::tn::Tensor coeff;
-                                parameter::tn::Tensor tmp;
-                                std::string key;
-                                for (auto& [key_, v] : p_gate->prs_[k].data_) {
-                                    key = key_;
-                                    coeff = v;
-                                    tmp = pr.GetItem(key_);
-                                }
-                                tmp += -pr_shift / coeff;
-                                tmp_pr.SetItem(key, tmp);
+                for (int j = start; j < end; j++) {
+                    VT<py_qs_data_t> intrin_grad_list(p_gate->prs_.size());
+                    for (int k = 0; k < p_gate->prs_.size(); k++) {
+                        p_gate->prs_[k] += -pr_shift;
+                        if (gate->id_ == GateID::U3 || gate->id_ == GateID::FSim) {
+                            parameter::tn::Tensor coeff;
+                            parameter::tn::Tensor tmp;
+                            std::string key;
+                            for (auto& term : p_gate->prs_[k].terms_) {
+                                key = term.name();
+                                coeff = term.value;
+                                tmp = pr.GetItem(key);
                             }
-                            sim_l = *this;
-                            sim_l.SetSeed(static_cast<unsigned>(this->rng_() * 10000));
-                            sim_l.ApplyCircuit(circ, tmp_pr);
-                            sim_rs[j - start] = sim_l;
-                            sim_rs[j - start].SetSeed(static_cast<unsigned>(this->rng_() * 10000));
-                            sim_rs[j - start].ApplyHamiltonian(*hams[j]);
-                            auto expect0 = qs_policy_t::Vdot(sim_l.qs, sim_rs[j - start].qs, dim);
-                            p_gate->prs_[k] += 2 * pr_shift;
-                            if (gate->id_ == GateID::U3 || gate->id_ == GateID::FSim) {
-                                parameter::tn::Tensor coeff;
-                                parameter::tn::Tensor tmp;
-                                std::string key;
-                                for (auto& [key_, v] : p_gate->prs_[k].data_) {
-                                    key = key_;
-                                    coeff = v;
-                                    tmp = pr.GetItem(key_);
-                                }
-                                tmp += pr_shift / coeff;
-                                tmp_pr.SetItem(key, tmp);
-                            }
-                            sim_l = *this;
-                            sim_l.SetSeed(static_cast<unsigned>(this->rng_() * 10000));
-                            sim_l.ApplyCircuit(circ, tmp_pr);
-                            sim_rs[j - start] = sim_l;
-                            sim_rs[j - start].SetSeed(static_cast<unsigned>(this->rng_() * 10000));
-                            sim_rs[j - start].ApplyHamiltonian(*hams[j]);
-                            auto expect1 = qs_policy_t::Vdot(sim_l.qs, sim_rs[j - start].qs, dim);
-                            p_gate->prs_[k] += -pr_shift;
-                            if (gate->id_ == GateID::U3 || gate->id_ == GateID::FSim) {
-                                parameter::tn::Tensor coeff;
-                                parameter::tn::Tensor tmp;
-                                std::string key;
-                                for (auto& [key_, v] : p_gate->prs_[k].data_) {
-                                    key = key_;
-                                    coeff = v;
-                                    tmp = pr.GetItem(key_);
-                                }
-                                tmp_pr.SetItem(key, tmp);
+                            tmp += -pr_shift / coeff;
+                            tmp_pr.SetItem(key, tmp);
+                        }
+                        sim_l = *this;
+                        sim_l.SetSeed(static_cast<unsigned>(this->rng_() * 10000));
+                        sim_l.ApplyCircuit(circ, tmp_pr);
+                        sim_rs[j - start] = sim_l;
+                        sim_rs[j - start].SetSeed(static_cast<unsigned>(this->rng_() * 10000));
+                        sim_rs[j - start].ApplyHamiltonian(*hams[j]);
+                        auto expect0 = qs_policy_t::Vdot(sim_l.qs, sim_rs[j - start].qs, dim);
+                        p_gate->prs_[k] += 2 * pr_shift;
+                        if (gate->id_ == GateID::U3 || gate->id_ == GateID::FSim) {
+                            parameter::tn::Tensor coeff;
+                            parameter::tn::Tensor tmp;
+                            std::string key;
+                            for (auto& term : p_gate->prs_[k].terms_) {
+                                key = term.name();
+                                coeff = term.value;
+                                tmp = pr.GetItem(key);
                             }
-                            intrin_grad_list[k] = {coeff * std::real(expect1 - expect0), 0};
+                            tmp += pr_shift / coeff;
+                            tmp_pr.SetItem(key, tmp);
                         }
-                        auto intrin_grad = tensor::Matrix(VVT<py_qs_data_t>{intrin_grad_list});
-                        auto p_grad = tensor::ops::cpu::to_vector<py_qs_data_t>(tensor::ops::MatMul(intrin_grad, jac));
-                        for (const auto& [name, idx] : title) {
-                            f_and_g[j][1 + p_map.at(name)] += p_grad[0][idx];
+                        sim_l = *this;
+                        sim_l.SetSeed(static_cast<unsigned>(this->rng_() * 10000));
+                        sim_l.ApplyCircuit(circ, tmp_pr);
+                        sim_rs[j - start] = sim_l;
+                        sim_rs[j - start].SetSeed(static_cast<unsigned>(this->rng_() * 10000));
+                        sim_rs[j - start].ApplyHamiltonian(*hams[j]);
+                        auto expect1 = qs_policy_t::Vdot(sim_l.qs, sim_rs[j - start].qs, dim);
+                        p_gate->prs_[k] += -pr_shift;
+                        if (gate->id_ == GateID::U3 || gate->id_ == GateID::FSim) {
+                            parameter::tn::Tensor coeff;
+                            parameter::tn::Tensor tmp;
+                            std::string key;
+                            for (auto& term : p_gate->prs_[k].terms_) {
+                                key = term.name();
+                                coeff = term.value;
+                                tmp = pr.GetItem(key);
+                            }
+                            tmp_pr.SetItem(key, tmp);
                         }
+                        intrin_grad_list[k] = {coeff * std::real(expect1 - expect0), 0};
                     }
+                    jacobian.AddGrad(n, intrin_grad_list.data(), f_and_g[j].data() + 1);
                 }
             }
         }
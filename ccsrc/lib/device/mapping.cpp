@@ -19,18 +19,93 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <numeric>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <queue>
 #include <fmt/core.h>
 
+#include "config/openmp.h"
+
 #include "core/mq_base_types.h"
+#include "core/utils.h"
+#include "device/placement.h"
 #include "device/topology.h"
 #include "ops/basic_gate.h"
 #include "ops/gate_id.h"
 
 namespace mindquantum::mapping {
+namespace {
+// Index of the trial with fewest SWAP gates, or with lowest depth if prefer_depth, earlier trial wins a tie.
+size_t BestTrial(const VT<TrialResult>& results, bool prefer_depth) {
+    auto key = [&](const TrialResult& r) {
+        return prefer_depth ? std::make_pair(r.depth, r.num_swap) : std::make_pair(r.num_swap, r.depth);
+    };
+    size_t best = 0;
+    for (size_t i = 1; i < results.size(); ++i) {
+        if (key(results[i]) < key(results[best])) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+VT<VT<int>> GetGateInfo(const VT<Gate>& gates) {
+    VT<VT<int>> gate_info;
+    for (auto& g : gates) {
+        if (g.type == "SWAP") {
+            gate_info.push_back({-1, g.q1, g.q2});
+        } else {
+            gate_info.push_back({std::stoi(g.tag), g.q1, g.q2});
+        }
+    }
+    return gate_info;
+}
+
+void CheckNumTrials(int num_trials) {
+    if (num_trials < 1) {
+        throw std::runtime_error(fmt::format("Number of trials should be positive, but get {}.", num_trials));
+    }
+}
+
+// Pairs of logical qubits acted on by CNOT gates.
+VT<std::pair<int, int>> GetInteractions(const VT<Gate>& gates) {
+    VT<std::pair<int, int>> interactions;
+    for (auto& g : gates) {
+        if (g.type == "CNOT") {
+            interactions.push_back({g.q1, g.q2});
+        }
+    }
+    return interactions;
+}
+
+// Physical qubits are used as indices of coupling graph, so their id should be dense.
+std::shared_ptr<const TopologyCSR> CompileCouplingGraph(const std::shared_ptr<QubitsTopology>& coupling_graph) {
+    auto topology = coupling_graph->Compile();
+    if (topology->index.size() != topology->ids.size()) {
+        throw std::runtime_error(
+            fmt::format("Qubit id of coupling graph should be 0 to {}.", static_cast<int>(topology->ids.size()) - 1));
+    }
+    return topology;
+}
+}  // namespace
+
 // -----------------------------------------------------------------------------
+TrialResult GetTrialResult(const VT<Gate>& gates, int num_physical, uint64_t seed) {
+    TrialResult result{seed, 0, static_cast<int>(gates.size()), 0};
+    VT<int> level(num_physical, 0);
+    for (auto& g : gates) {
+        if (g.type == "SWAP") {
+            result.num_swap++;
+        }
+        int l = std::max(level[g.q1], level[g.q2]) + 1;
+        level[g.q1] = level[g.q2] = l;
+        result.depth = std::max(result.depth, l);
+    }
+    return result;
+}
+
 VT<VT<int>> GetCircuitDAG(int n, const VT<Gate>& gates) {
     int m = gates.size();
     VT<int> last(n, -1);
@@ -86,8 +161,8 @@ std::pair<qbit_t, VT<Gate>> GateToAbstractGate(const VT<std::shared_ptr<BasicGat
 }
 
 // -----------------------------------------------------------------------------
-int MQ_SABRE::CalGraphCenter(const VT<VT<int>>& graph) {        
-    int n = graph.size();
+template <typename Graph>
+int MQ_SABRE::CalGraphCenter(const Graph& graph, int n) {        
     int center_qubit;
     int tempmin=INT16_MAX;
     for(int i=0; i<n; i++)
@@ -109,8 +184,8 @@ int MQ_SABRE::CalGraphCenter(const VT<VT<int>>& graph) {
 VT<int> MQ_SABRE::InitialMapping(const std::shared_ptr<QubitsTopology>& coupling_graph) {
     VT<int> layout(this->num_physical,-1);
     VT<int> Rlayout(this->num_physical,-1);
-    int Qc = CalGraphCenter(this->D);
-    int qc = CalGraphCenter(this->Gw);
+    int Qc = CalGraphCenter(*this->D, this->num_physical);
+    int qc = CalGraphCenter(this->Gw, this->num_logical);
     layout[qc] = Qc;
     Rlayout[Qc] = 1;
     std::queue<int> qcQueue;    // the queue of logic qubits 
@@ -142,7 +217,7 @@ VT<int> MQ_SABRE::InitialMapping(const std::shared_ptr<QubitsTopology>& coupling
             {
                 if(i!=Qi)
                 {
-                    tempCandidatePysicalQubits[i][0]=D[Qi][i];    // ****** 想想能不能优化
+                    tempCandidatePysicalQubits[i][0]=(*D)[Qi][i];    // ****** 想想能不能优化
                     tempCandidatePysicalQubits[i][1]=i; 
                 }
                 else{
@@ -182,7 +257,7 @@ VT<int> MQ_SABRE::InitialMapping(const std::shared_ptr<QubitsTopology>& coupling
                 {
                     if(i!=Qi)
                     {
-                        tempCandidatePysicalQubits[i][0]=D[Qi][i];    // ****** 想想能不能优化
+                        tempCandidatePysicalQubits[i][0]=(*D)[Qi][i];    // ****** 想想能不能优化
                         tempCandidatePysicalQubits[i][1]=i; 
                     }
                     else
@@ -272,7 +347,7 @@ std::list<int> MQ_SABRE::GetFLayer(std::list<std::pair<int,int>>& E){
 bool MQ_SABRE::IsExecutable(const VT<int>& pi, int g) const {
     if (gates[g].type == "CNOT") {
         int p = pi[gates[g].q1], q = pi[gates[g].q2];
-        return std::any_of(G[p].begin(), G[p].end(), [&](int a) { return a == q; });
+        return G->IsCoupled(p, q);
     } else {
         return true;
     }
@@ -283,11 +358,11 @@ std::set<std::pair<int, int>> MQ_SABRE::ObtainSWAPs(const std::list<int>& F, con
     for (int g : F) {
         int x = pi[gates[g].q1];
         int y = pi[gates[g].q2];
-        for (int z : G[x])
+        for (int z : G->Neighbours(x))
         {
             ret.insert({std::min(x, z), std::max(x, z)});
         }
-        for (int z : G[y])
+        for (int z : G->Neighbours(y))
         {
             ret.insert({std::min(y, z), std::max(y, z)});
         }
@@ -424,17 +499,17 @@ VT<Gate> MQ_SABRE::HeuristicSearch(VT<int>& pi, const VT<VT<int>>& DAG) {
                         int x = minSWAP.first, y = minSWAP.second;
                         int p = pi[gates[*it].q1], q = pi[gates[*it].q2];
                         // return VT<Gate>();
-                        if((p==x&&D[q][y]==1)||(p==y&&D[q][x]==1))    //  add bridge gate
+                        if((p==x&&(*D)[q][y]==1)||(p==y&&(*D)[q][x]==1))    //  add bridge gate
                         {
                             tempflag=1;
-                            if(p==x&&D[q][y]==1)
+                            if(p==x&&(*D)[q][y]==1)
                             {
                                 ans.push_back({"CNOT", q, y, gates[*it].tag});
                                 ans.push_back({"CNOT", y, p, gates[*it].tag});
                                 ans.push_back({"CNOT", q, y, gates[*it].tag});
                                 ans.push_back({"CNOT", y, p, gates[*it].tag});
                             }
-                            else if((p==y&&D[q][x]==1))
+                            else if((p==y&&(*D)[q][x]==1))
                             {
                                 ans.push_back({"CNOT", q, x, gates[*it].tag});
                                 ans.push_back({"CNOT", x, p, gates[*it].tag});
@@ -503,76 +578,57 @@ const std::vector<std::pair<std::pair<int,int>,VT<double>>> CnotErrrorRateAndGat
             }
         }
     }
-    this->G = VT<VT<int>>(this->num_physical, VT<int>(0));
-    for (auto id : coupling_graph->AllQubitID()) 
-    {
-        auto nearby = (*coupling_graph)[id]->neighbour;
-        this->G[id].insert(this->G[id].begin(), nearby.begin(), nearby.end());
-    }
-    // get DAG of logical circuit
+    this->G = CompileCouplingGraph(coupling_graph);
+    // get DAG and RDAG of logical circuit
     this->DAG = GetCircuitDAG(num_logical, gates);
-
-    // get D using Floyd algorithm
-    {
-        int n = num_physical;
-        this->D = VT<VT<int>>(n, VT<int>(n));
-        for (int i = 0; i < n; ++i)
-            for (int j = 0; j < n; ++j)
-                D[i][j] = i == j ? 0 : 1e9;
-        for (int i = 0; i < n; ++i)
-            for (int j : G[i])
-                D[i][j] = D[j][i] = 1;
-        for (int k = 0; k < n; ++k)
-            for (int i = 0; i < n; ++i)
-                for (int j = 0; j < n; ++j)
-                    D[i][j] = std::min(D[i][j], D[i][k] + D[k][j]);
+    this->RDAG = VT<VT<int>>(this->DAG.size());
+    for (int x = 0; x < static_cast<int>(DAG.size()); ++x) {
+        for (int y : DAG[x])
+            RDAG[y].push_back(x);
     }
+
+    // get D by BFS, cached by the coupling graph
+    this->D = coupling_graph->HopDistances();
     // get Kesi by D
     {
         int n = num_physical;
-        this->Kesi= VT<VT<double>>(n, VT<double>(n,0.0));
+        DistanceMatrix<double> weight(n, 0.0);
         for(int i=0;i<n;i++)
         {
             for(int j=0;j<n;j++)
             {
-                Kesi[i][j]=1-SWAP_success_rate[i][j]*SWAP_success_rate[j][i]*(std::max(SWAP_success_rate[i][j],SWAP_success_rate[j][i]));
+                weight[i][j]=1-SWAP_success_rate[i][j]*SWAP_success_rate[j][i]*(std::max(SWAP_success_rate[i][j],SWAP_success_rate[j][i]));
             }
         }
-        for (int k = 0; k < n; ++k)
-            for (int i = 0; i < n; ++i)
-                for (int j = 0; j < n; ++j)
-                    Kesi[i][j] = std::min(Kesi[i][j], Kesi[i][k] + Kesi[k][j]);
+        this->Kesi = ShortestPaths(weight, 1.0);   // pairs without CNOT weigh 1
     }
     //get T by D
     {
         int n = num_physical;
-        this->T= VT<VT<double>>(n, VT<double>(n,0.0));
+        DistanceMatrix<double> weight(n, 0.0);
         for(int i=0;i<n;i++)
         {
             for(int j=0;j<n;j++)
             {
-                T[i][j]= SWAP_gate_length[i][j]+SWAP_gate_length[j][i]+std::min(SWAP_gate_length[i][j],SWAP_gate_length[j][i]);
+                weight[i][j]= SWAP_gate_length[i][j]+SWAP_gate_length[j][i]+std::min(SWAP_gate_length[i][j],SWAP_gate_length[j][i]);
             }
         }
-        for (int k = 0; k < n; ++k)
-            for (int i = 0; i < n; ++i)
-                for (int j = 0; j < n; ++j)
-                    T[i][j] = std::min(T[i][j], T[i][k] + T[k][j]);
+        this->T = ShortestPaths(weight, 0.0);      // pairs without CNOT weigh 0
     }
     // init Gw and Go 
     {
         int n = num_logical;
         this->Go = VT<VT<int>>(n, VT<int>(n,-1));
         this->Gw = VT<VT<int>>(n, VT<int>(n,0));
-        this->Dw = VT<VT<int>>(n, VT<int>(n,0));
+        DistanceMatrix<int> weight(n, 0);
         for (int i = 0; i < static_cast<int>(gates.size()); ++i) 
         {
             if(gates[i].type == "CNOT")
             {
                 int q1 = gates[i].q1;
                 int q2 = gates[i].q2;
-                Dw[q1][q2] += 1;
-                Dw[q2][q1] += 1;
+                weight[q1][q2] += 1;
+                weight[q2][q1] += 1;
                 Gw[q1][q2] += -1;
                 Gw[q2][q1] += -1;
                 if(Go[q1][q2] == -1)
@@ -584,41 +640,76 @@ const std::vector<std::pair<std::pair<int,int>,VT<double>>> CnotErrrorRateAndGat
         }
         for (int i = 0; i < n; ++i)
             for (int j = 0; j < n; ++j)
-                if(i != j && Dw[i][j] == 0)
-                    Dw[i][j] = 1e9;
-        for (int k = 0; k < n; ++k)
-            for (int i = 0; i < n; ++i)
-                for (int j = 0; j < n; ++j)
-                    Dw[i][j] = std::min(Dw[i][j], Dw[i][k] + Dw[k][j]);
+                if(i != j && weight[i][j] == 0)
+                    weight[i][j] = 1e9;
+        this->Dw = ShortestPaths(weight, static_cast<int>(1e9));  // pairs without CNOT weigh 1e9
     }
 
     this->layout = this->InitialMapping(coupling_graph);        //这个应该是物理量子特性，理应归属为类的成员
     // return;
 }
 
-std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> MQ_SABRE::Solve(double W, double alpha1, double alpha2,double alpha3){
+std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> MQ_SABRE::Solve(double W, double alpha1, double alpha2,
+                                                                     double alpha3, int num_trials, uint64_t seed,
+                                                                     bool prefer_depth, double layout_time_limit) {
+    CheckNumTrials(num_trials);
     this->SetParameters(W, alpha1, alpha2, alpha3);     //set parameters
-    this->DM= VT<VT<double>>(num_physical,VT<double>(num_physical,0.0));
+    this->DM= DistanceMatrix<double>(num_physical, 0.0);
     for(int i=0;i<num_physical;i++)
     {
         for(int j=0;j<num_physical;j++)
         {
-            DM[i][j] = alpha1 * D[i][j] + alpha2 * Kesi[i][j]+ alpha3 * T[i][j];
+            DM[i][j] = alpha1 * (*D)[i][j] + alpha2 * Kesi[i][j]+ alpha3 * T[i][j];
         }
     }
-    auto initial_mapping = this->layout;                   // first mapping 
-    auto gates = HeuristicSearch(this->layout,this->DAG);  // final mapping
 
-    // return std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>>();
-    VT<VT<int>> gate_info;
-    for (auto& g : gates) {
-        if (g.type == "SWAP") {
-            gate_info.push_back({-1, g.q1, g.q2});
-        } else {
-            gate_info.push_back({std::stoi(g.tag), g.q1, g.q2});
-        }
-    }
-    return {gate_info, {initial_mapping, this->layout}};
+    // a layout that embeds the interaction graph needs no SWAP gate, so no trial is needed. Among such layouts the
+    // one with lowest error rate and gate length aware distance DM is taken.
+    auto perfect = PerfectLayout(this->num_logical, GetInteractions(this->gates), *this->G, layout_time_limit,
+                                 &this->DM);
+    if (!perfect.empty()) {
+        std::fill(perfect.begin() + this->num_logical, perfect.end(), -1);
+        auto pi = perfect;
+        auto gates = HeuristicSearch(pi, this->DAG);
+        this->trial_results = {GetTrialResult(gates, this->num_physical, seed)};
+        return {GetGateInfo(gates), {perfect, pi}};
+    }
+
+    VT<VT<Gate>> trial_gates(num_trials);
+    VT<VT<int>> initial_mappings(num_trials);
+    VT<VT<int>> final_mappings(num_trials);
+    this->trial_results = VT<TrialResult>(num_trials);
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), num_trials, 2,
+        for (omp::idx_t t = 0; t < static_cast<omp::idx_t>(num_trials); t++) {
+            auto pi = this->layout;                         // first mapping
+            if (t != 0) {
+                // random mapping of logical qubits, refined by a forward and a backward search
+                VT<int> perm(this->num_physical);
+                std::iota(perm.begin(), perm.end(), 0);
+                auto engine = std::mt19937_64(seed + t);
+                std::shuffle(perm.begin(), perm.end(), engine);
+                std::fill(pi.begin(), pi.end(), -1);
+                std::copy(perm.begin(), perm.begin() + this->num_logical, pi.begin());
+                // ancilla qubits allocated by one search are not known by the next one
+                HeuristicSearch(pi, this->DAG);
+                std::fill(pi.begin() + this->num_logical, pi.end(), -1);
+                HeuristicSearch(pi, this->RDAG);
+                std::fill(pi.begin() + this->num_logical, pi.end(), -1);
+            }
+            initial_mappings[t] = pi;
+            trial_gates[t] = HeuristicSearch(pi, this->DAG);  // final mapping
+            final_mappings[t] = pi;
+            trial_results[t] = GetTrialResult(trial_gates[t], this->num_physical, seed + t);
+        })
+    // clang-format on
+
+    auto best = BestTrial(trial_results, prefer_depth);
+    return {GetGateInfo(trial_gates[best]), {initial_mappings[best], final_mappings[best]}};
+}
+
+const VT<TrialResult>& MQ_SABRE::GetTrialResults() const {
+    return trial_results;
 }
 
 inline void MQ_SABRE::SetParameters(double W, double alpha1, double alpha2, double alpha3) {
@@ -629,9 +720,9 @@ inline void MQ_SABRE::SetParameters(double W, double alpha1, double alpha2, doub
 }
 // -----------------------------------------------------------------------------
 bool SABRE::IsExecutable(const VT<int>& pi, int g) const {
-    if (gates[g].type == "CNOT") {
+    if (is_cnot[g]) {
         int p = pi[gates[g].q1], q = pi[gates[g].q2];
-        return std::any_of(G[p].begin(), G[p].end(), [&](int a) { return a == q; });
+        return G->IsCoupled(p, q);
     } else {
         return true;
     }
@@ -645,79 +736,84 @@ VT<int> SABRE::GetReversePi(const VT<int>& pi) const {
     return rpi;
 }
 
-std::set<std::pair<int, int>> SABRE::ObtainSWAPs(const std::list<int>& F, const VT<int>& pi) const {
-    std::set<std::pair<int, int>> ret;
+void SABRE::ObtainSWAPs(const VT<int>& F, const VT<int>& pi, const VT<bool>& in_front,
+                        VT<std::pair<int, int>>* SWAPs) const {
+    SWAPs->clear();
     for (int g : F) {
-        int x = pi[gates[g].q1];
-        int y = pi[gates[g].q2];
-        for (int z : G[x])
-            ret.insert({std::min(x, z), std::max(x, z)});
-        for (int z : G[y])
-            ret.insert({std::min(y, z), std::max(y, z)});
+        for (int x : {pi[gates[g].q1], pi[gates[g].q2]}) {
+            for (int z : G->Neighbours(x)) {
+                if (!in_front[z] || x < z) {  // edges between two qubits of F are only added once
+                    SWAPs->push_back({std::min(x, z), std::max(x, z)});
+                }
+            }
+        }
     }
-    return ret;
 }
 
-std::list<int> SABRE::GetNextLayer(const std::list<int>& F, const VT<VT<int>>& DAG, const VT<int>& indeg) const {
-    VT<int> tmp_deg = indeg;
-    std::list<int> ret;
+VT<int> SABRE::GetNextLayer(const VT<int>& F, const VT<VT<int>>& DAG, VT<int>* indeg) const {
+    auto& deg = *indeg;
+    VT<int> ret;
+    VT<int> touched;
     for (int x : F) {
         for (int y : DAG[x]) {
-            tmp_deg[y]--;
-            if (gates[y].type == "CNOT") {  // y is CNOT gate
-                if (tmp_deg[y] == 0)
+            deg[y]--;
+            touched.push_back(y);
+            if (is_cnot[y]) {  // y is CNOT gate
+                if (deg[y] == 0)
                     ret.push_back(y);
             } else {                    // y is single gate
                 for (int z : DAG[y]) {  // find following gate
-                    tmp_deg[z]--;
-                    if (tmp_deg[z] == 0)
+                    deg[z]--;
+                    touched.push_back(z);
+                    if (deg[z] == 0)
                         ret.push_back(z);
                 }
             }
         }
     }
+    for (int y : touched)
+        deg[y]++;
     return ret;
 }
 
-std::list<int> SABRE::GetExtendedSet(const std::list<int>& F, const VT<VT<int>>& DAG, const VT<int>& indeg) const {
+VT<int> SABRE::GetExtendedSet(const VT<int>& F, const VT<VT<int>>& DAG, VT<int>* indeg) const {
     return GetNextLayer(F, DAG, indeg);
 }
 
-double SABRE::HBasic(const std::list<int>& F, const VT<int>& pi) const {
+int SABRE::HBasic(const VT<int>& F, const VT<int>& pi) const {
     int sum = 0;
     for (int g : F) {
         int q1 = gates[g].q1;
         int q2 = gates[g].q2;
-        sum += D[pi[q1]][pi[q2]];
+        sum += (*D)[pi[q1]][pi[q2]];
     }
     return sum;
 }
 
-double SABRE::HLookAhead(const std::list<int>& F, const std::list<int>& E, const VT<int>& pi) const {
-    double s1 = HBasic(F, pi) / static_cast<double>(F.size());
-    if (E.size() == 0) {
-        return s1;
-    } else {
-        double s2 = HBasic(E, pi) / static_cast<double>(E.size());
-        return s1 + W * s2;  // where 0 <= W <= 1 is a parameter
+int SABRE::HBasicDelta(const VT<VT<int>>& on, const VT<int>& pi, int p, int q) const {
+    auto moved = [&](int r) { return r == p ? pi[q] : (r == q ? pi[p] : pi[r]); };
+    int delta = 0;
+    for (int g : on[p]) {
+        delta += (*D)[moved(gates[g].q1)][moved(gates[g].q2)] - (*D)[pi[gates[g].q1]][pi[gates[g].q2]];
     }
-}
-
-double SABRE::H(const std::list<int>& F, const std::list<int>& E, const VT<int>& pi, const std::pair<int, int>& SWAP,
-                const VT<double>& decay) const {
-    return std::max(decay[SWAP.first], decay[SWAP.second]) * HLookAhead(F, E, pi);
+    for (int g : on[q]) {
+        if (gates[g].q1 != p && gates[g].q2 != p) {  // gates on both p and q have been counted
+            delta += (*D)[moved(gates[g].q1)][moved(gates[g].q2)] - (*D)[pi[gates[g].q1]][pi[gates[g].q2]];
+        }
+    }
+    return delta;
 }
 
 SABRE::SABRE(const VT<std::shared_ptr<BasicGate>>& circ, const std::shared_ptr<QubitsTopology>& coupling_graph) {
     auto tmp = GateToAbstractGate(circ);
     this->num_logical = tmp.first;
     this->gates = tmp.second;
-    this->num_physical = coupling_graph->size();
-    this->G = VT<VT<int>>(this->num_physical, VT<int>(0));
-    for (auto id : coupling_graph->AllQubitID()) {
-        auto nearby = (*coupling_graph)[id]->neighbour;
-        this->G[id].insert(this->G[id].begin(), nearby.begin(), nearby.end());
+    this->is_cnot = VT<bool>(this->gates.size());
+    for (size_t i = 0; i < this->gates.size(); ++i) {
+        this->is_cnot[i] = this->gates[i].type == "CNOT";
     }
+    this->num_physical = coupling_graph->size();
+    this->G = CompileCouplingGraph(coupling_graph);
     // -----------------------------------------------------------------------------
 
     // get DAG and RDAG of logical circuit
@@ -728,21 +824,8 @@ SABRE::SABRE(const VT<std::shared_ptr<BasicGate>>& circ, const std::shared_ptr<Q
             RDAG[y].push_back(x);
     }
 
-    // get D using Floyd algorithm
-    {
-        int n = num_physical;
-        this->D = VT<VT<int>>(n, VT<int>(n));
-        for (int i = 0; i < n; ++i)
-            for (int j = 0; j < n; ++j)
-                D[i][j] = i == j ? 0 : 1e9;
-        for (int i = 0; i < n; ++i)
-            for (int j : G[i])
-                D[i][j] = D[j][i] = 1;
-        for (int k = 0; k < n; ++k)
-            for (int i = 0; i < n; ++i)
-                for (int j = 0; j < n; ++j)
-                    D[i][j] = std::min(D[i][j], D[i][k] + D[k][j]);
-    }
+    // get D by BFS, cached by the coupling graph
+    this->D = coupling_graph->HopDistances();
 }
 
 VT<Gate> SABRE::HeuristicSearch(VT<int>& pi, const VT<VT<int>>& DAG) {
@@ -757,74 +840,114 @@ VT<Gate> SABRE::HeuristicSearch(VT<int>& pi, const VT<VT<int>>& DAG) {
         for (int j : DAG[i])
             indeg[j]++;
 
-    std::list<int> F;  // front layer
+    VT<int> F;  // front layer
     for (int i = 0; i < static_cast<int>(DAG.size()); ++i)
         if (indeg[i] == 0)
             F.push_back(i);
 
-    while (!F.empty()) {
-        VT<int> executable_list;
-        // find all executable gates in F
-        for (auto it = F.begin(); it != F.end(); ++it) {
-            if (IsExecutable(pi, *it)) {
-                executable_list.push_back(*it);
+    // Extended set and the gates of F and E on every logical qubit only change when gates are executed, and a SWAP
+    // only changes the distance of gates on its two qubits, so both HBasic are updated by their difference.
+    VT<int> E;
+    VT<int> F_indexed;  // F when F_on was built
+    VT<VT<int>> F_on(pi.size());
+    VT<VT<int>> E_on(pi.size());
+    VT<bool> in_front(pi.size(), false);  // whether a physical qubit holds a qubit of gates in F
+    VT<std::pair<int, int>> candidate_SWAPs;
+    int F_cost = 0;
+    int E_cost = 0;
+    bool layer_changed = true;
+    auto index_layer = [&](const VT<int>& layer, VT<VT<int>>* on, bool add) {
+        for (int g : layer) {
+            for (int r : {gates[g].q1, gates[g].q2}) {
+                if (!add) {
+                    (*on)[r].clear();
+                } else if ((*on)[r].empty() || (*on)[r].back() != g) {
+                    (*on)[r].push_back(g);
+                }
             }
         }
+    };
 
-        if (!executable_list.empty()) {  // execute all executable gates
-            for (auto it = F.begin(); it != F.end();) {
-                if (IsExecutable(pi, *it)) {
-                    int x = *it;
-                    if (gates[x].type == "CNOT") {
-                        int p = gates[x].q1;
-                        int q = gates[x].q2;
-                        double tmp = std::max(decay[p], decay[q]);
-                        decay[p] = decay[q] = tmp + delta2;
-                        ans.push_back({"CNOT", pi[p], pi[q], gates[x].tag});
-                    } else {
-                        int p = gates[x].q1;
-                        decay[p] += delta1;
-                        ans.push_back({gates[x].type, pi[p], pi[p], gates[x].tag});
-                    }
-
-                    for (int y : DAG[x]) {
-                        --indeg[y];
-                        if (indeg[y] == 0)
-                            F.push_back(y);
-                    }
-                    it = F.erase(it);
-                } else {
-                    ++it;
-                }
+    while (!F.empty()) {
+        // execute all executable gates, including the ones that become executable meanwhile
+        bool executed = false;
+        for (size_t i = 0; i < F.size(); ++i) {
+            int x = F[i];
+            if (!IsExecutable(pi, x)) {
+                continue;
             }
-        } else {  // If there is no executable gate, try to SWAP
-            auto candidate_SWAPs = ObtainSWAPs(F, pi);
-            auto E = GetExtendedSet(F, DAG, indeg);
-            // find the SWAP with minimal H-score
-            double min_score = std::numeric_limits<double>::max();
-            std::pair<int, int> min_SWAP;
-            for (auto SWAP : candidate_SWAPs) {
-                int x = SWAP.first, y = SWAP.second;
-                int p = rpi[x], q = rpi[y];
+            if (is_cnot[x]) {
+                int p = gates[x].q1;
+                int q = gates[x].q2;
+                double tmp = std::max(decay[p], decay[q]);
+                decay[p] = decay[q] = tmp + delta2;
+                ans.push_back({"CNOT", pi[p], pi[q], gates[x].tag});
+            } else {
+                int p = gates[x].q1;
+                decay[p] += delta1;
+                ans.push_back({gates[x].type, pi[p], pi[p], gates[x].tag});
+            }
+            for (int y : DAG[x]) {
+                --indeg[y];
+                if (indeg[y] == 0)
+                    F.push_back(y);
+            }
+            F[i] = -1;
+            executed = true;
+        }
+        if (executed) {
+            F.erase(std::remove(F.begin(), F.end(), -1), F.end());
+            layer_changed = true;
+            continue;
+        }
 
-                auto tmp = pi;
-                std::swap(tmp[p], tmp[q]);
-                double score = H(F, E, tmp, {p, q}, decay);
-                if (score < min_score) {
-                    min_score = score;
-                    min_SWAP = SWAP;
-                }
+        // If there is no executable gate, try to SWAP
+        if (layer_changed) {
+            index_layer(E, &E_on, false);
+            index_layer(F_indexed, &F_on, false);
+            for (int g : F_indexed) {
+                in_front[pi[gates[g].q1]] = in_front[pi[gates[g].q2]] = false;
+            }
+            for (int g : F) {
+                in_front[pi[gates[g].q1]] = in_front[pi[gates[g].q2]] = true;
+            }
+            F_indexed = F;
+            E = GetExtendedSet(F, DAG, &indeg);
+            index_layer(F, &F_on, true);
+            index_layer(E, &E_on, true);
+            F_cost = HBasic(F, pi);
+            E_cost = HBasic(E, pi);
+            layer_changed = false;
+        }
+        // find the SWAP with minimal H-score, the smallest one if there are several
+        //   H = max(decay[p], decay[q]) * (HBasic(F) / |F| + W * HBasic(E) / |E|)
+        double min_score = std::numeric_limits<double>::max();
+        std::pair<int, int> min_SWAP;
+        ObtainSWAPs(F, pi, in_front, &candidate_SWAPs);
+        for (auto SWAP : candidate_SWAPs) {
+            int p = rpi[SWAP.first], q = rpi[SWAP.second];
+            double h = static_cast<double>(F_cost + HBasicDelta(F_on, pi, p, q)) / static_cast<double>(F.size());
+            if (!E.empty()) {
+                h = h + W * (static_cast<double>(E_cost + HBasicDelta(E_on, pi, p, q)) / static_cast<double>(E.size()));
             }
+            double score = std::max(decay[p], decay[q]) * h;
+            if (score < min_score || (score == min_score && SWAP < min_SWAP)) {
+                min_score = score;
+                min_SWAP = SWAP;
+            }
+        }
 
-            int x = min_SWAP.first, y = min_SWAP.second;
-            int p = rpi[x], q = rpi[y];
-            std::swap(pi[p], pi[q]);
-            std::swap(rpi[x], rpi[y]);
-            ans.push_back({"SWAP", x, y, "SWAP" + std::to_string(++tot)});
+        int x = min_SWAP.first, y = min_SWAP.second;
+        int p = rpi[x], q = rpi[y];
+        in_front.swap(in_front[x], in_front[y]);
+        F_cost += HBasicDelta(F_on, pi, p, q);
+        E_cost += HBasicDelta(E_on, pi, p, q);
+        std::swap(pi[p], pi[q]);
+        std::swap(rpi[x], rpi[y]);
+        ans.push_back({"SWAP", x, y, "SWAP" + std::to_string(++tot)});
 
-            double tmp = std::max(decay[p], decay[q]);
-            decay[p] = decay[q] = tmp + delta2 * 3;
-        }
+        double tmp = std::max(decay[p], decay[q]);
+        decay[p] = decay[q] = tmp + delta2 * 3;
     }
     return ans;
 }
@@ -834,33 +957,51 @@ void SABRE::IterOneTurn(VT<int>& pi) {
     HeuristicSearch(pi, this->RDAG);  // using reversed circuit to update
 }
 
-std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> SABRE::Solve(int iter_num, double W, double delta1, double delta2) {
+std::pair<VT<VT<int>>, std::pair<VT<int>, VT<int>>> SABRE::Solve(int iter_num, double W, double delta1, double delta2,
+                                                                  int num_trials, uint64_t seed, bool prefer_depth,
+                                                                  double layout_time_limit) {
+    CheckNumTrials(num_trials);
     this->SetParameters(W, delta1, delta2);
 
-    // generate random initial mapping
-    VT<int> pi(this->num_physical);
-    for (int i = 0; i < static_cast<int>(pi.size()); ++i)
-        pi[i] = i;
-
-    auto seed = std::chrono::system_clock::now().time_since_epoch().count();
-    auto engine = std::default_random_engine(seed);
-    shuffle(pi.begin(), pi.end(), engine);
+    // a layout that embeds the interaction graph needs no SWAP gate, so no trial is needed
+    auto perfect = PerfectLayout(this->num_logical, GetInteractions(this->gates), *this->G, layout_time_limit);
+    if (!perfect.empty()) {
+        auto pi = perfect;
+        auto gates = HeuristicSearch(pi, this->DAG);
+        this->trial_results = {GetTrialResult(gates, this->num_physical, seed)};
+        return {GetGateInfo(gates), {perfect, pi}};
+    }
+
+    VT<VT<Gate>> trial_gates(num_trials);
+    VT<VT<int>> initial_mappings(num_trials);
+    VT<VT<int>> final_mappings(num_trials);
+    this->trial_results = VT<TrialResult>(num_trials);
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), num_trials, 2,
+        for (omp::idx_t t = 0; t < static_cast<omp::idx_t>(num_trials); t++) {
+            // generate random initial mapping
+            VT<int> pi(this->num_physical);
+            std::iota(pi.begin(), pi.end(), 0);
+            auto engine = std::mt19937_64(seed + t);
+            std::shuffle(pi.begin(), pi.end(), engine);
+
+            // iterate to update initial mapping
+            for (int i = 0; i < iter_num; ++i) {
+                IterOneTurn(pi);
+            }
+            initial_mappings[t] = pi;
+            trial_gates[t] = HeuristicSearch(pi, this->DAG);
+            final_mappings[t] = pi;
+            trial_results[t] = GetTrialResult(trial_gates[t], this->num_physical, seed + t);
+        })
+    // clang-format on
+
+    auto best = BestTrial(trial_results, prefer_depth);
+    return {GetGateInfo(trial_gates[best]), {initial_mappings[best], final_mappings[best]}};
+}
 
-    // iterate to update initial mapping
-    for (int t = 0; t < iter_num; ++t) {
-        IterOneTurn(pi);
-    }
-    auto initial_mapping = pi;
-    auto gs = HeuristicSearch(pi, this->DAG);
-    VT<VT<int>> gate_info;
-    for (auto& g : gs) {
-        if (g.type == "SWAP") {
-            gate_info.push_back({-1, g.q1, g.q2});
-        } else {
-            gate_info.push_back({std::stoi(g.tag), g.q1, g.q2});
-        }
-    }
-    return {gate_info, {initial_mapping, pi}};
+const VT<TrialResult>& SABRE::GetTrialResults() const {
+    return trial_results;
 }
 
 inline void SABRE::SetParameters(double W, double delta1, double delta2) {
@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/placement.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace mindquantum::mapping {
+namespace {
+// Number of search steps between two checks of the time budget.
+constexpr int time_check_interval = 1024;
+
+// Matching order of VF2++: BFS from the node with the largest degree of every component, and inside one BFS level
+// the node with most ordered neighbours first, then the one with the largest degree.
+VT<int> MatchingOrder(const VT<VT<int>>& adj) {
+    int n = adj.size();
+    VT<int> order;
+    VT<bool> visited(n, false);
+    VT<int> conn(n, 0);  // number of ordered neighbours
+    for (;;) {
+        int root = -1;
+        for (int u = 0; u < n; u++) {
+            if (!visited[u] && !adj[u].empty() && (root == -1 || adj[u].size() > adj[root].size())) {
+                root = u;
+            }
+        }
+        if (root == -1) {
+            break;
+        }
+        VT<int> level = {root};
+        visited[root] = true;
+        while (!level.empty()) {
+            VT<int> next;
+            for (size_t i = 0; i < level.size(); i++) {
+                auto best = std::max_element(level.begin() + i, level.end(), [&](int a, int b) {
+                    return std::make_pair(conn[a], adj[a].size()) < std::make_pair(conn[b], adj[b].size());
+                });
+                std::iter_swap(level.begin() + i, best);
+                int u = level[i];
+                order.push_back(u);
+                for (int w : adj[u]) {
+                    conn[w]++;
+                    if (!visited[w]) {
+                        visited[w] = true;
+                        next.push_back(w);
+                    }
+                }
+            }
+            level = std::move(next);
+        }
+    }
+    return order;
+}
+}  // namespace
+
+VT<int> PerfectLayout(int num_logical, const VT<std::pair<int, int>>& interactions, const TopologyCSR& topology,
+                      double time_limit, const DistanceMatrix<double>* cost) {
+    int n = topology.Size();
+    if (time_limit <= 0 || num_logical > n) {
+        return {};
+    }
+    VT<std::pair<int, int>> edges;
+    for (auto [a, b] : interactions) {
+        if (a != b) {
+            edges.push_back({std::min(a, b), std::max(a, b)});
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    VT<int> multiplicity;  // number of two qubits gates on every unique edge
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (i == 0 || edges[i] != edges[i - 1]) {
+            multiplicity.push_back(0);
+        }
+        multiplicity.back()++;
+    }
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    if (edges.size() > topology.edges.size()) {
+        return {};
+    }
+    VT<VT<int>> adj(num_logical);
+    for (auto [a, b] : edges) {
+        adj[a].push_back(b);
+        adj[b].push_back(a);
+    }
+    int max_degree = 0;
+    for (int v = 0; v < n; v++) {
+        max_degree = std::max(max_degree, topology.Degree(v));
+    }
+    if (std::any_of(adj.begin(), adj.end(),
+                    [&](const VT<int>& nbrs) { return static_cast<int>(nbrs.size()) > max_degree; })) {
+        return {};
+    }
+
+    auto order = MatchingOrder(adj);
+    int depth_max = order.size();
+    VT<int> position(num_logical, -1);
+    for (int k = 0; k < depth_max; k++) {
+        position[order[k]] = k;
+    }
+    VT<int> parent(depth_max, -1);       // a matched neighbour, whose image gives the candidates
+    VT<VT<int>> matched_nbrs(depth_max);  // neighbours matched before
+    for (int k = 0; k < depth_max; k++) {
+        for (int w : adj[order[k]]) {
+            if (position[w] < k) {
+                matched_nbrs[k].push_back(w);
+            }
+        }
+        if (!matched_nbrs[k].empty()) {
+            parent[k] = *std::min_element(matched_nbrs[k].begin(), matched_nbrs[k].end(),
+                                          [&](int a, int b) { return position[a] < position[b]; });
+        }
+    }
+
+    VT<int> layout(num_logical, -1);
+    VT<bool> used(n, false);
+    VT<int> cursor(depth_max, 0);  // next candidate to try at every depth
+    auto feasible = [&](int k, int v) {
+        int u = order[k];
+        if (used[v] || topology.Degree(v) < static_cast<int>(adj[u].size())) {
+            return false;
+        }
+        for (int w : matched_nbrs[k]) {
+            if (!topology.IsCoupled(layout[w], v)) {
+                return false;
+            }
+        }
+        // unmatched neighbours of u need free neighbours of v
+        int free = 0;
+        for (int z : topology.Neighbours(v)) {
+            free += !used[z];
+        }
+        return free >= static_cast<int>(adj[u].size() - matched_nbrs[k].size());
+    };
+
+    VT<int> best;
+    double best_cost = 0;
+    auto start = std::chrono::steady_clock::now();
+    int steps = 0;
+    int k = 0;
+    while (k >= 0) {
+        if (k == depth_max) {
+            if (cost == nullptr) {
+                best = layout;
+                break;
+            }
+            double total = 0;
+            for (size_t i = 0; i < edges.size(); i++) {
+                total += multiplicity[i] * (*cost)[layout[edges[i].first]][layout[edges[i].second]];
+            }
+            if (best.empty() || total < best_cost) {
+                best = layout;
+                best_cost = total;
+            }
+            k--;
+            continue;
+        }
+        if (++steps % time_check_interval == 0
+            && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > time_limit) {
+            break;
+        }
+        int u = order[k];
+        if (layout[u] != -1) {  // back from a failed deeper level
+            used[layout[u]] = false;
+            layout[u] = -1;
+        }
+        // candidates are neighbours of the image of a matched neighbour, or any qubit for a new component
+        int size = parent[k] == -1 ? n : topology.Degree(layout[parent[k]]);
+        int v = -1;
+        while (cursor[k] < size) {
+            int c = parent[k] == -1 ? cursor[k] : topology.Neighbours(layout[parent[k]]).begin()[cursor[k]];
+            cursor[k]++;
+            if (feasible(k, c)) {
+                v = c;
+                break;
+            }
+        }
+        if (v == -1) {
+            cursor[k] = 0;
+            k--;
+            continue;
+        }
+        layout[u] = v;
+        used[v] = true;
+        k++;
+    }
+    if (best.empty()) {
+        return {};
+    }
+
+    // isolated logical qubits and the rest of indices take the unused physical qubits
+    std::fill(used.begin(), used.end(), false);
+    for (int v : best) {
+        if (v != -1) {
+            used[v] = true;
+        }
+    }
+    VT<int> out(n);
+    std::copy(best.begin(), best.end(), out.begin());
+    int next = 0;
+    for (int l = 0; l < n; l++) {
+        if (l >= num_logical || out[l] == -1) {
+            while (used[next]) {
+                next++;
+            }
+            out[l] = next;
+            used[next] = true;
+        }
+    }
+    return out;
+}
+}  // namespace mindquantum::mapping
@@ -16,11 +16,111 @@
 
 #include "device/topology.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <numeric>
+#include <queue>
 #include <stdexcept>
+#include <utility>
+
+#include "config/openmp.h"
+
+#include "core/utils.h"
 
 namespace mindquantum::mapping {
+namespace {
+// Number of sources above which distances are computed in parallel.
+constexpr omp::idx_t distance_omp_threshold = 64;
+
+// Bumped whenever an edge or a qubit of any topology changes. Nodes may be shared by several topologies, so a
+// global counter is the simplest way to invalidate every cached distance matrix they belong to.
+std::atomic<uint64_t> edge_version{1};
+
+void BumpEdgeVersion() {
+    edge_version.fetch_add(1, std::memory_order_relaxed);
+}
+}  // namespace
+
+// =============================================================================
+
+template <typename T>
+DistanceMatrix<T> ShortestPaths(const DistanceMatrix<T>& weight, T background) {
+    auto n = weight.n;
+    VT<VT<int>> edges(n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i != j && weight[i][j] != background) {
+                edges[i].push_back(j);
+            }
+        }
+    }
+    DistanceMatrix<T> dist(n, std::numeric_limits<T>::max());
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), static_cast<omp::idx_t>(n), distance_omp_threshold,
+        for (omp::idx_t src = 0; src < static_cast<omp::idx_t>(n); src++) {
+            auto d = dist[src];
+            VT<bool> done(n, false);
+            // Nodes not yet relaxed through a background pair. Since nodes are settled with increasing distance, the
+            // first settled node that reaches v by a background pair gives its shortest one.
+            VT<int> pending(n);
+            std::iota(pending.begin(), pending.end(), 0);
+            std::priority_queue<std::pair<T, int>, VT<std::pair<T, int>>, std::greater<>> heap;
+            d[src] = 0;
+            heap.push({0, static_cast<int>(src)});
+            while (!heap.empty()) {
+                auto [du, u] = heap.top();
+                heap.pop();
+                if (done[u]) {
+                    continue;
+                }
+                done[u] = true;
+                auto w = weight[u];
+                for (size_t k = 0; k < pending.size();) {
+                    auto v = pending[k];
+                    if (done[v] || w[v] == background) {
+                        if (!done[v] && du + background < d[v]) {
+                            d[v] = du + background;
+                            heap.push({d[v], v});
+                        }
+                        pending[k] = pending.back();
+                        pending.pop_back();
+                    } else {
+                        k++;
+                    }
+                }
+                for (auto v : edges[u]) {
+                    if (!done[v] && du + w[v] < d[v]) {
+                        d[v] = du + w[v];
+                        heap.push({d[v], v});
+                    }
+                }
+            }
+        })
+    // clang-format on
+    // Floyd algorithm keeps the shortest cycle through a node on diagonal, instead of zero.
+    VT<T> diagonal(n);
+    for (int i = 0; i < n; i++) {
+        auto cycle = weight[i][i];
+        for (int k = 0; k < n; k++) {
+            if (k != i && dist[i][k] != std::numeric_limits<T>::max()
+                && dist[k][i] != std::numeric_limits<T>::max()) {
+                cycle = std::min(cycle, dist[i][k] + dist[k][i]);
+            }
+        }
+        diagonal[i] = cycle;
+    }
+    for (int i = 0; i < n; i++) {
+        dist[i][i] = diagonal[i];
+    }
+    return dist;
+}
+
+template DistanceMatrix<int> ShortestPaths(const DistanceMatrix<int>& weight, int background);
+template DistanceMatrix<double> ShortestPaths(const DistanceMatrix<double>& weight, double background);
+
 // =============================================================================
 
 QubitNode::QubitNode(qbit_t id, std::string color, double poi_x, double poi_y, const std::set<qbit_t>& neighbour)
@@ -38,6 +138,7 @@ QNodePtr QubitNode::operator<<(const QNodePtr& other) {
     }
     this->neighbour.insert(other->id);
     other->neighbour.insert(this->id);
+    BumpEdgeVersion();
     return shared_from_this();
 }
 
@@ -47,6 +148,7 @@ QNodePtr QubitNode::operator>>(const QNodePtr& other) {
     }
     this->neighbour.insert(other->id);
     other->neighbour.insert(this->id);
+    BumpEdgeVersion();
     return other;
 }
 
@@ -56,6 +158,7 @@ QNodePtr QubitNode::operator<(const QNodePtr& other) {
     }
     this->neighbour.erase(other->id);
     other->neighbour.erase(this->id);
+    BumpEdgeVersion();
     return shared_from_this();
 }
 
@@ -65,6 +168,7 @@ QNodePtr QubitNode::operator>(const QNodePtr& other) {
     }
     this->neighbour.erase(other->id);
     other->neighbour.erase(this->id);
+    BumpEdgeVersion();
     return other;
 }
 
@@ -74,6 +178,18 @@ QubitNode::operator qbit_t() {
 
 // =============================================================================
 
+int TopologyCSR::EdgeIndex(int i, int j) const {
+    auto first = this->neighbours.begin() + this->offsets[i];
+    auto last = this->neighbours.begin() + this->offsets[i + 1];
+    auto it = std::lower_bound(first, last, j);
+    if (it == last || *it != j) {
+        return -1;
+    }
+    return this->edge_of[it - this->neighbours.begin()];
+}
+
+// =============================================================================
+
 QubitsTopology::QubitsTopology(const VT<QNodePtr>& qubits) {
     for (auto& qubit : qubits) {
         auto [it, succeed] = this->qubits.insert(std::unordered_map<qbit_t, QNodePtr>::value_type(qubit->id, qubit));
@@ -167,6 +283,7 @@ void QubitsTopology::RemoveQubitNode(qbit_t id) {
     std::accumulate(neighbour.begin(), neighbour.end(), will_remove,
                     [&](auto init, const auto near_id) { return *init < (*this)[near_id]; });
     this->qubits.erase(will_remove->id);
+    BumpEdgeVersion();
 }
 
 void QubitsTopology::RemoveIsolateNode() {
@@ -203,12 +320,85 @@ void QubitsTopology::AddQubitNode(const QNodePtr& qubit) {
         throw std::runtime_error("qubit with id " + std::to_string(qubit->id) + " already exists.");
     }
     this->qubits[qubit->id] = qubit;
+    BumpEdgeVersion();
 }
 
 bool QubitsTopology::HasQubitNode(qbit_t id) {
     return this->qubits.count(id) > 0;
 }
 
+std::shared_ptr<const DistanceMatrix<int>> QubitsTopology::HopDistances() {
+    auto version = edge_version.load(std::memory_order_relaxed);
+    if (this->hop_distances != nullptr && this->hop_distances_version == version) {
+        return this->hop_distances;
+    }
+    auto topo = this->Compile();
+    auto dist = std::make_shared<DistanceMatrix<int>>(static_cast<int>(topo->index.size()), unreachable_distance);
+    auto n = static_cast<omp::idx_t>(topo->Size());
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), n, distance_omp_threshold,
+        for (omp::idx_t src = 0; src < n; src++) {
+            // BFS on dense index, distances are stored by qubit id.
+            auto d = (*dist)[topo->ids[src]];
+            d[topo->ids[src]] = 0;
+            VT<int> queue = {static_cast<int>(src)};
+            for (size_t head = 0; head < queue.size(); head++) {
+                auto u = queue[head];
+                for (auto v : topo->Neighbours(u)) {
+                    if (d[topo->ids[v]] == unreachable_distance) {
+                        d[topo->ids[v]] = d[topo->ids[u]] + 1;
+                        queue.push_back(v);
+                    }
+                }
+            }
+        })
+    // clang-format on
+    this->hop_distances = dist;
+    this->hop_distances_version = version;
+    return this->hop_distances;
+}
+
+std::shared_ptr<const TopologyCSR> QubitsTopology::Compile() {
+    auto version = edge_version.load(std::memory_order_relaxed);
+    if (this->csr != nullptr && this->csr_version == version) {
+        return this->csr;
+    }
+    auto topo = std::make_shared<TopologyCSR>();
+    for (auto& [id, qubit] : this->qubits) {
+        topo->ids.push_back(id);
+    }
+    std::sort(topo->ids.begin(), topo->ids.end());
+    topo->index = VT<int>(topo->ids.empty() ? 0 : topo->ids.back() + 1, -1);
+    for (int i = 0; i < topo->Size(); i++) {
+        topo->index[topo->ids[i]] = i;
+    }
+    for (int i = 0; i < topo->Size(); i++) {
+        // Neighbours that have been removed from this topology are not reachable through it.
+        for (auto near_id : this->qubits.at(topo->ids[i])->neighbour) {
+            if (near_id < static_cast<qbit_t>(topo->index.size()) && topo->index[near_id] != -1) {
+                topo->neighbours.push_back(topo->index[near_id]);
+            }
+        }
+        topo->offsets.push_back(topo->neighbours.size());
+    }
+    // Neighbours are ascending since std::set is ordered and renumbering keeps the order.
+    topo->edge_of = VT<int>(topo->neighbours.size());
+    for (int i = 0; i < topo->Size(); i++) {
+        for (int k = topo->offsets[i]; k < topo->offsets[i + 1]; k++) {
+            auto j = topo->neighbours[k];
+            if (i < j) {
+                topo->edge_of[k] = topo->edges.size();
+                topo->edges.push_back({i, j});
+            } else {
+                topo->edge_of[k] = topo->EdgeIndex(j, i);
+            }
+        }
+    }
+    this->csr = topo;
+    this->csr_version = version;
+    return this->csr;
+}
+
 // =============================================================================
 
 LinearQubits::LinearQubits(qbit_t n_qubits) {
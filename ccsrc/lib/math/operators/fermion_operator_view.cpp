@@ -16,6 +16,12 @@
 
 #include "math/operators/fermion_operator_view.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "config/openmp.h"
+
 #include "core/utils.h"
 #include "math/operators/utils.h"
 #include "math/pr/parameter_resolver.h"
@@ -227,7 +233,7 @@ bool SingleFermionStr::IsSameString(const key_t& k1, const key_t& k2) {
     return true;
 }
 
-std::string SingleFermionStr::GetString(const compress_term_t& fermion) {
+std::string SingleFermionStr::GetString(const term_view_t& fermion) {
     std::string out = "";
     int group_id = 0;
     auto& [fermion_string, coeff] = fermion;
@@ -276,7 +282,7 @@ std::string SingleFermionStr::GetString(const compress_term_t& fermion) {
     return coeff.ToString() + " [" + out + "]";
 }
 
-auto SingleFermionStr::Mul(const compress_term_t& lhs, const compress_term_t& rhs) -> compress_term_t {
+auto SingleFermionStr::Mul(const term_view_t& lhs, const term_view_t& rhs) -> compress_term_t {
     auto& [l_k, l_v] = lhs;
     auto& [r_k, r_v] = rhs;
     key_t fermion_string = {};
@@ -393,13 +399,11 @@ FermionOperator::FermionOperator(const py_dict_t& t) {
     for (auto& [k, v] : t) {
         auto [term, succeed] = SingleFermionStr::init(SingleFermionStr::py_terms_to_terms(k), v);
         if (succeed) {
-            if (this->terms.m_map.find(term.first) != this->terms.m_map.end()) {
-                this->terms[term.first] = this->terms[term.first] + term.second;
-            } else {
-                this->terms.insert(term.first, term.second);
-            }
-            upper_type = tn::upper_type_v(this->terms[term.first].GetDtype(), this->dtype);
-            if (!this->terms[term.first].IsNotZero()) {
+            auto value = this->terms.contains(term.first) ? this->terms.at(term.first) + term.second
+                                                          : term.second;
+            this->terms.set(term.first, value);
+            upper_type = tn::upper_type_v(value.GetDtype(), this->dtype);
+            if (!value.IsNotZero()) {
                 will_pop.push_back(term.first);
             }
         }
@@ -419,49 +423,35 @@ FermionOperator::FermionOperator(const key_t& k, const value_t& v) {
 
 FermionOperator FermionOperator::imag() const {
     auto out = *this;
-    std::vector<key_t> will_pop;
-    for (auto& [k, v] : out.terms.m_list) {
-        v = v.Imag();
-        if (!v.IsNotZero()) {
-            will_pop.push_back(k);
-        }
-    }
+    out.terms.transform([](value_t& v) { v = v.Imag(); });
+    out.terms.erase_zeros();
     out.dtype = tn::ToRealType(this->dtype);
-    std::for_each(will_pop.begin(), will_pop.end(), [&](auto i) { out.terms.erase(i); });
     return out;
 }
 
 FermionOperator FermionOperator::real() const {
     auto out = *this;
-    std::vector<key_t> will_pop;
-    for (auto& [k, v] : out.terms.m_list) {
-        v = v.Real();
-        if (!v.IsNotZero()) {
-            will_pop.push_back(k);
-        }
-    }
+    out.terms.transform([](value_t& v) { v = v.Real(); });
+    out.terms.erase_zeros();
     out.dtype = tn::ToRealType(this->dtype);
-    std::for_each(will_pop.begin(), will_pop.end(), [&](auto i) { out.terms.erase(i); });
     return out;
 }
 
 void FermionOperator::CastTo(tn::TDtype dtype) {
     if (dtype != this->dtype) {
-        for (auto& [k, v] : this->terms) {
-            v.CastTo(dtype);
-        }
+        this->terms.cast(dtype);
         this->dtype = dtype;
     }
 }
 std::vector<std::pair<parameter::ParameterResolver, FermionOperator>> FermionOperator::split() const {
     auto out = std::vector<std::pair<parameter::ParameterResolver, FermionOperator>>();
-    for (auto& [k, v] : this->terms.m_list) {
+    for (const auto& [k, v] : this->terms) {
         out.push_back({v, FermionOperator(k, parameter::ParameterResolver(tn::ops::ones(1, v.GetDtype())))});
     }
     return out;
 }
 bool FermionOperator::parameterized() const {
-    for (auto& [k, v] : this->terms.m_list) {
+    for (const auto& [k, v] : this->terms) {
         if (!v.IsConst()) {
             return true;
         }
@@ -471,18 +461,12 @@ bool FermionOperator::parameterized() const {
 
 void FermionOperator::subs(const parameter::ParameterResolver& other) {
     auto new_type = this->dtype;
-    std::vector<key_t> will_pop;
-    for (auto& [k, v] : this->terms.m_list) {
+    this->terms.transform([&](value_t& v) {
         if (v.subs(other).size() != 0) {
             new_type = tensor::upper_type_v(this->dtype, v.GetDtype());
         }
-        if (!v.IsNotZero()) {
-            will_pop.push_back(k);
-        }
-    }
-    for (auto& k : will_pop) {
-        this->terms.erase(k);
-    }
+    });
+    this->terms.erase_zeros();
     if (new_type != this->dtype) {
         this->CastTo(new_type);
     }
@@ -503,40 +487,90 @@ FermionOperator FermionOperator::hermitian_conjugated() const {
     return out;
 }
 
+namespace {
+//! Number of terms above which terms are normal ordered in parallel.
+constexpr omp::idx_t normal_order_omp_threshold = 1024;
+//! Number of terms accumulated into one partial operator.
+constexpr size_t normal_order_block_size = 512;
+
+/*!
+ * Expand every a a^\dagger slot of a compressed term into 1 - a^\dagger a, and accumulate the 2^k ordered terms
+ * into out. Removing or swapping a pair on the same mode does not change the parity of other ladder operators, so
+ * only the number of a^\dagger a slots contributes to the sign.
+ */
+void AccumulateNormalOrdered(FermionOperator* out, const key_t& key, const value_t& coeff) {
+    std::vector<std::pair<size_t, size_t>> slots;
+    for (size_t group_id = 0; group_id < key.size(); group_id++) {
+        size_t local_id = 0;
+        for (auto t = key[group_id]; t != 0; t >>= 3, local_id += 3) {
+            if ((t & 7) == static_cast<uint64_t>(TermValue::AAd)) {
+                slots.emplace_back(group_id, local_id);
+            }
+        }
+    }
+    auto ordered = key;
+    for (auto& [group_id, local_id] : slots) {
+        ordered[group_id] &= ~(static_cast<uint64_t>(7) << local_id);
+    }
+    for (uint64_t mask = 0; mask < (static_cast<uint64_t>(1) << slots.size()); mask++) {
+        auto new_key = ordered;
+        for (size_t i = 0; i < slots.size(); i++) {
+            if ((mask >> i) & 1) {
+                new_key[slots[i].first] |= static_cast<uint64_t>(TermValue::AdA) << slots[i].second;
+            }
+        }
+        while (new_key.size() > 1 && new_key.back() == 0) {
+            new_key.pop_back();
+        }
+        AccumulateTerm(out, new_key, coeff, mindquantum::CountOne(mask) & 1);
+    }
+}
+}  // namespace
+
 FermionOperator FermionOperator::normal_ordered() const {
-    auto out = FermionOperator();
-    out.dtype = this->dtype;
-    for (auto& term : this->terms.m_list) {
-        if (std::any_of(term.first.begin(), term.first.end(), SingleFermionStr::has_a_ad)) {
-            auto tmp = FermionOperator("", term.second);
-            size_t group_id = 0;
-            for (auto local : term.first) {
-                size_t local_id = 0;
-                for (auto t = local; t != 0; t >>= 3) {
-                    auto current = t & 7;
-                    if (current == static_cast<uint64_t>(TermValue::AAd)) {
-                        tmp = (FermionOperator(terms_t{{group_id * 23 + local_id, TermValue::AdA}},
-                                               parameter::ParameterResolver(-1.0))
-                               + FermionOperator(""))
-                              * tmp;
-                    } else if (current != static_cast<uint64_t>(TermValue::I)) {
-                        tmp = FermionOperator(terms_t{{group_id * 23 + local_id, static_cast<TermValue>(current)}})
-                              * tmp;
-                    }
-                    local_id += 1;
+    std::vector<term_view_t> all_terms;
+    all_terms.reserve(this->size());
+    omp::idx_t n_unordered = 0;
+    for (const auto& term : this->terms) {
+        all_terms.push_back(term);
+        n_unordered += std::any_of(term.first.begin(), term.first.end(), SingleFermionStr::has_a_ad);
+    }
+    if (n_unordered == 0) {
+        return *this;
+    }
+    auto n_block = (all_terms.size() + normal_order_block_size - 1) / normal_order_block_size;
+    std::vector<FermionOperator> partial(n_block);
+    for (auto& p : partial) {
+        p.dtype = this->dtype;
+    }
+
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), n_unordered, normal_order_omp_threshold,
+        for (omp::idx_t b = 0; b < static_cast<omp::idx_t>(n_block); b++) {
+            auto begin = static_cast<size_t>(b) * normal_order_block_size;
+            auto end = std::min(all_terms.size(), begin + normal_order_block_size);
+            auto& out = partial[b];
+            for (auto i = begin; i < end; i++) {
+                const auto& [key, coeff] = all_terms[i];
+                if (std::any_of(key.begin(), key.end(), SingleFermionStr::has_a_ad)) {
+                    AccumulateNormalOrdered(&out, key, coeff);
+                } else {
+                    AccumulateTerm(&out, key, coeff);
                 }
-                group_id += 1;
             }
-            out += tmp;
-        } else {
-            out += FermionOperator(term.first, term.second);
-        }
+        })
+    // clang-format on
+
+    auto& out = partial[0];
+    for (size_t b = 1; b < n_block; b++) {
+        AccumulateOperator(&out, partial[b]);
+        partial[b] = FermionOperator();
     }
-    return out;
+    return std::move(out);
 }
 
 bool FermionOperator::Contains(const key_t& term) const {
-    return this->terms.m_map.find(term) != this->terms.m_map.end();
+    return this->terms.contains(term);
 }
 
 tn::TDtype FermionOperator::GetDtype() const {
@@ -544,19 +578,13 @@ tn::TDtype FermionOperator::GetDtype() const {
 }
 
 void FermionOperator::Update(const compress_term_t& fermion) {
-    if (this->Contains(fermion.first)) {
-        this->terms[fermion.first] = fermion.second;
-    } else {
-        this->terms.insert(fermion);
-    }
     auto upper_t = tn::upper_type_v(fermion.second.GetDtype(), this->dtype);
     if (upper_t != this->GetDtype()) {
         this->CastTo(upper_t);
-        return;
-    }
-    if (fermion.second.GetDtype() != upper_t) {
-        this->terms[fermion.first].CastTo(upper_t);
     }
+    auto coeff = fermion.second;
+    coeff.CastTo(upper_t);
+    this->terms.set(fermion.first, coeff);
 }
 
 size_t FermionOperator::size() const {
@@ -576,7 +604,7 @@ std::string FermionOperator::ToString() const {
 
 auto FermionOperator::get_terms() const -> dict_t {
     dict_t out{};
-    for (auto& [k, v] : this->terms.m_list) {
+    for (const auto& [k, v] : this->terms) {
         if (std::any_of(k.begin(), k.end(), [](auto i) { return i == static_cast<uint64_t>(TermValue::nll); })) {
             continue;
         }
@@ -612,7 +640,7 @@ value_t FermionOperator::get_coeff(const terms_t& term) {
         throw std::runtime_error("Invalid fermion term to get.");
     }
     if (this->Contains(terms.first)) {
-        return this->terms[terms.first] * terms.second;
+        return this->terms.at(terms.first) * terms.second;
     }
     throw std::out_of_range("term not in fermion operator");
 }
@@ -621,20 +649,13 @@ void FermionOperator::set_coeff(const terms_t& term, const parameter::ParameterR
     if (!succeed) {
         throw std::runtime_error("Invalid fermion term to set.");
     }
-    if (this->Contains(terms.first)) {
-        this->terms[terms.first] = terms.second * value;
-
-    } else {
-        terms.second = terms.second * value;
-        this->terms.insert(terms);
-    }
-    auto upper_t = tensor::upper_type_v(this->dtype, this->terms[terms.first].GetDtype());
+    auto coeff = terms.second * value;
+    auto upper_t = tensor::upper_type_v(this->dtype, coeff.GetDtype());
     if (this->dtype != upper_t) {
         this->CastTo(upper_t);
     }
-    if (this->terms[terms.first].GetDtype() != upper_t) {
-        this->terms[terms.first].CastTo(upper_t);
-    }
+    coeff.CastTo(upper_t);
+    this->terms.set(terms.first, coeff);
 }
 
 bool FermionOperator::is_singlet() const {
@@ -645,7 +666,7 @@ parameter::ParameterResolver FermionOperator::singlet_coeff() const {
     if (!this->is_singlet()) {
         throw std::runtime_error("Operator is not singlet.");
     }
-    return this->terms.m_list.begin()->second;
+    return this->terms.begin()->second;
 }
 
 std::vector<FermionOperator> FermionOperator::singlet() const {
@@ -664,7 +685,7 @@ std::vector<FermionOperator> FermionOperator::singlet() const {
 
 size_t FermionOperator::count_qubits() const {
     int n_qubits = 0;
-    for (auto& [k, v] : this->terms.m_list) {
+    for (const auto& [k, v] : this->terms) {
         int group_id = k.size() - 1;
         for (auto word = k.rbegin(); word != k.rend(); ++word) {
             if ((*word) != 0) {
@@ -680,69 +701,17 @@ size_t FermionOperator::count_qubits() const {
 // -----------------------------------------------------------------------------
 
 FermionOperator& FermionOperator::operator+=(const tn::Tensor& c) {
-    if (this->Contains(key_t{0})) {
-        this->terms[key_t{0}] = this->terms[key_t{0}] + c;
-    } else {
-        this->terms.insert({key_t{0}, parameter::ParameterResolver(c)});
-    }
-    auto upper_t = tn::upper_type_v(c.dtype, this->dtype);
-    if (upper_t != this->GetDtype()) {
-        this->CastTo(upper_t);
-        return *this;
-    }
-    if (c.dtype != upper_t) {
-        this->terms[key_t{0}].CastTo(upper_t);
-    }
-    if (!this->terms[key_t{0}].IsNotZero()) {
-        this->terms.erase(key_t{0});
-    }
+    AccumulateTerm(this, key_t{0}, parameter::ParameterResolver(c));
     return *this;
 }
 
 FermionOperator operator+(FermionOperator lhs, const tensor::Tensor& rhs) {
-    if (lhs.Contains(key_t{0})) {
-        lhs.terms[key_t{0}] = lhs.terms[key_t{0}] + rhs;
-    } else {
-        lhs.terms.insert({key_t{0}, parameter::ParameterResolver(rhs)});
-    }
-    auto upper_t = tn::upper_type_v(lhs.GetDtype(), rhs.dtype);
-    if (upper_t != lhs.GetDtype()) {
-        lhs.CastTo(upper_t);
-        return lhs;
-    }
-    if (upper_t != rhs.dtype) {
-        lhs.terms[key_t{0}].CastTo(upper_t);
-    }
-    if (!lhs.terms[key_t{0}].IsNotZero()) {
-        lhs.terms.erase(key_t{0});
-    }
+    lhs += rhs;
     return lhs;
 }
 
 FermionOperator& FermionOperator::operator+=(const FermionOperator& other) {
-    for (const auto& term : other.terms) {
-        if (this->Contains(term.first)) {
-            this->terms[term.first] = this->terms[term.first] + term.second;
-            if (this->dtype != this->terms[term.first].GetDtype()) {
-                this->CastTo(this->terms[term.first].GetDtype());
-            }
-            if (!this->terms[term.first].IsNotZero()) {
-                this->terms.erase(term.first);
-            }
-        } else {
-            this->terms.insert(term);
-            auto upper_t = tn::upper_type_v(this->dtype, term.second.GetDtype());
-            if (this->GetDtype() != upper_t) {
-                this->CastTo(upper_t);
-            }
-            if (term.second.GetDtype() != upper_t) {
-                this->terms[term.first].CastTo(upper_t);
-            }
-            if (!this->terms[term.first].IsNotZero()) {
-                this->terms.erase(term.first);
-            }
-        }
-    }
+    AccumulateOperator(this, other);
     return *this;
 }
 
@@ -753,29 +722,14 @@ FermionOperator operator+(FermionOperator lhs, const FermionOperator& rhs) {
 
 FermionOperator FermionOperator::operator*=(const FermionOperator& other) {
     auto out = FermionOperator();
-    for (auto& this_term : this->terms) {
+    out.dtype = this->dtype;
+    for (const auto& this_term : this->terms) {
         for (const auto& other_term : other.terms) {
             auto new_term = SingleFermionStr::Mul(this_term, other_term);
-            if (out.Contains(new_term.first)) {
-                out.terms[new_term.first] = out.terms[new_term.first] + new_term.second;
-                if (this->dtype != out.terms[new_term.first].GetDtype()) {
-                    this->CastTo(out.terms[new_term.first].GetDtype());
-                }
-            } else {
-                out.terms.insert(new_term);
-                auto upper_t = tn::upper_type_v(this->dtype, out.terms[new_term.first].GetDtype());
-                if (this->GetDtype() != upper_t) {
-                    this->CastTo(upper_t);
-                }
-                if (new_term.second.GetDtype() != upper_t) {
-                    out.terms[new_term.first].CastTo(upper_t);
-                }
-            }
-            if (!out.terms[new_term.first].IsNotZero()) {
-                out.terms.erase(new_term.first);
-            }
+            AccumulateTerm(&out, new_term.first, new_term.second);
         }
     }
+    this->dtype = out.dtype;
     std::swap(out.terms, this->terms);
     return *this;
 }
@@ -790,10 +744,10 @@ FermionOperator FermionOperator::operator*=(const parameter::ParameterResolver&
         this->terms = {};
         return *this;
     }
-    for (auto& [k, v] : this->terms.m_list) {
+    this->terms.transform([&](value_t& v) {
         v *= other;
         this->dtype = v.GetDtype();
-    }
+    });
     return *this;
 }
 }  // namespace operators::fermion
@@ -0,0 +1,440 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "math/operators/grouping.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "config/openmp.h"
+
+#include "core/utils.h"
+
+namespace operators {
+namespace {
+using qubit::TermValue;
+using bits_t = std::vector<uint8_t>;
+
+constexpr size_t npos = std::numeric_limits<size_t>::max();
+//! Largest number of terms that are coloured with DSATUR on a dense conflict graph.
+constexpr size_t dsatur_max_terms = 1 << 14;
+//! Number of terms above which rows of conflict graph are built in parallel.
+constexpr omp::idx_t adjacency_omp_threshold = 256;
+
+//! X and Z bit masks of pauli strings, every string takes n_word words of both masks.
+struct PauliMasks {
+    size_t n_word = 0;
+    std::vector<uint64_t> x;
+    std::vector<uint64_t> z;
+
+    PauliMasks(const qubit::QubitOperator::dict_t& terms, size_t n_qubits)
+        : n_word((n_qubits + 63) / 64), x(terms.size() * n_word), z(terms.size() * n_word) {
+        for (size_t i = 0; i < terms.size(); i++) {
+            for (const auto& [idx, value] : terms[i].first) {
+                auto bit = static_cast<uint64_t>(1) << (idx & 63);
+                if (value == TermValue::X || value == TermValue::Y) {
+                    x[i * n_word + idx / 64] |= bit;
+                }
+                if (value == TermValue::Z || value == TermValue::Y) {
+                    z[i * n_word + idx / 64] |= bit;
+                }
+            }
+        }
+    }
+    const uint64_t* X(size_t i) const {
+        return x.data() + i * n_word;
+    }
+    const uint64_t* Z(size_t i) const {
+        return z.data() + i * n_word;
+    }
+};
+
+bool Compatible(const uint64_t* x1, const uint64_t* z1, const uint64_t* x2, const uint64_t* z2, size_t n_word,
+                bool qubit_wise) {
+    if (qubit_wise) {
+        for (size_t w = 0; w < n_word; w++) {
+            if (((x1[w] ^ x2[w]) | (z1[w] ^ z2[w])) & (x1[w] | z1[w]) & (x2[w] | z2[w])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    uint64_t odd = 0;
+    for (size_t w = 0; w < n_word; w++) {
+        odd ^= (x1[w] & z2[w]) ^ (z1[w] & x2[w]);
+    }
+    return (mindquantum::CountOne(odd) & 1) == 0;
+}
+
+// -----------------------------------------------------------------------------
+
+//! Colour of every term, colours the conflict graph with DSATUR.
+std::vector<size_t> ColourDSATUR(const PauliMasks& masks, size_t n_term, bool qubit_wise) {
+    auto n_row_word = (n_term + 63) / 64;
+    std::vector<uint64_t> adj(n_term * n_row_word);
+    auto n_word = masks.n_word;
+    // Every thread owns its whole rows, so the symmetric graph is evaluated twice instead of racing on bits.
+    THRESHOLD_OMP_FOR(static_cast<omp::idx_t>(n_term), adjacency_omp_threshold,
+                      for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(n_term); i++) {
+                          auto row = adj.data() + i * n_row_word;
+                          for (size_t j = 0; j < n_term; j++) {
+                              if (j != static_cast<size_t>(i)
+                                  && !Compatible(masks.X(i), masks.Z(i), masks.X(j), masks.Z(j), n_word, qubit_wise)) {
+                                  row[j / 64] |= static_cast<uint64_t>(1) << (j & 63);
+                              }
+                          }
+                      })
+
+    std::vector<size_t> colour(n_term, npos);
+    std::vector<size_t> saturation(n_term, 0);
+    std::vector<size_t> degree(n_term, 0);
+    //! Bitset of colours used by coloured neighbours of every term.
+    std::vector<std::vector<uint64_t>> forbidden(n_term);
+    for (size_t i = 0; i < n_term; i++) {
+        for (size_t w = 0; w < n_row_word; w++) {
+            degree[i] += mindquantum::CountOne(adj[i * n_row_word + w]);
+        }
+    }
+    for (size_t step = 0; step < n_term; step++) {
+        size_t v = npos;
+        for (size_t u = 0; u < n_term; u++) {
+            if (colour[u] == npos
+                && (v == npos || saturation[u] > saturation[v]
+                    || (saturation[u] == saturation[v] && degree[u] > degree[v]))) {
+                v = u;
+            }
+        }
+        const auto& used = forbidden[v];
+        size_t c = 0;
+        while (c / 64 < used.size() && ((used[c / 64] >> (c & 63)) & 1)) {
+            c++;
+        }
+        colour[v] = c;
+        for (size_t w = 0; w < n_row_word; w++) {
+            auto bits = adj[v * n_row_word + w];
+            while (bits != 0) {
+                auto u = w * 64 + mindquantum::CountOne((bits & (~bits + 1)) - 1);
+                bits &= bits - 1;
+                if (colour[u] != npos) {
+                    continue;
+                }
+                auto& f = forbidden[u];
+                if (f.size() <= c / 64) {
+                    f.resize(c / 64 + 1, 0);
+                }
+                auto bit = static_cast<uint64_t>(1) << (c & 63);
+                if ((f[c / 64] & bit) == 0) {
+                    f[c / 64] |= bit;
+                    saturation[u]++;
+                }
+            }
+        }
+    }
+    return colour;
+}
+
+//! Independent generators of the span of commuting pauli strings, reduced against each other.
+struct Generators {
+    size_t n_word;
+    //! X mask followed by Z mask of every generator.
+    std::vector<std::vector<uint64_t>> rows;
+    std::vector<size_t> pivots;
+
+    explicit Generators(size_t n_word) : n_word(n_word) {
+    }
+    bool Commute(const uint64_t* x, const uint64_t* z) const {
+        for (const auto& row : rows) {
+            if (!Compatible(row.data(), row.data() + n_word, x, z, n_word, false)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    //! Add given string if it is independent of current generators, return whether it is added.
+    bool Add(const uint64_t* x, const uint64_t* z) {
+        std::vector<uint64_t> row(x, x + n_word);
+        row.insert(row.end(), z, z + n_word);
+        for (size_t k = 0; k < rows.size(); k++) {
+            if ((row[pivots[k] / 64] >> (pivots[k] & 63)) & 1) {
+                for (size_t w = 0; w < row.size(); w++) {
+                    row[w] ^= rows[k][w];
+                }
+            }
+        }
+        for (size_t w = 0; w < row.size(); w++) {
+            if (row[w] != 0) {
+                pivots.push_back(w * 64 + mindquantum::CountOne((row[w] & (~row[w] + 1)) - 1));
+                rows.push_back(std::move(row));
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+//! Colour of every term, first fit in term order against a summary of every group.
+std::vector<size_t> ColourGreedy(const PauliMasks& masks, size_t n_term, bool qubit_wise) {
+    auto n_word = masks.n_word;
+    std::vector<size_t> colour(n_term);
+    // Union basis of qubit wise groups.
+    std::vector<std::vector<uint64_t>> basis_x;
+    std::vector<std::vector<uint64_t>> basis_z;
+    // Generators of commuting groups.
+    std::vector<Generators> gens;
+    for (size_t i = 0; i < n_term; i++) {
+        auto x = masks.X(i);
+        auto z = masks.Z(i);
+        size_t n_group = qubit_wise ? basis_x.size() : gens.size();
+        size_t c = 0;
+        for (; c < n_group; c++) {
+            if (qubit_wise ? Compatible(basis_x[c].data(), basis_z[c].data(), x, z, n_word, true)
+                           : gens[c].Commute(x, z)) {
+                break;
+            }
+        }
+        if (c == n_group) {
+            if (qubit_wise) {
+                basis_x.emplace_back(n_word, 0);
+                basis_z.emplace_back(n_word, 0);
+            } else {
+                gens.emplace_back(n_word);
+            }
+        }
+        if (qubit_wise) {
+            for (size_t w = 0; w < n_word; w++) {
+                basis_x[c][w] |= x[w];
+                basis_z[c][w] |= z[w];
+            }
+        } else {
+            gens[c].Add(x, z);
+        }
+        colour[i] = c;
+    }
+    return colour;
+}
+
+// -----------------------------------------------------------------------------
+
+//! Basis rotation that maps every term of a qubit wise commuting group to Z strings.
+std::vector<BasisGate> QubitWiseRotation(const PauliMasks& masks, const std::vector<size_t>& terms,
+                                         size_t n_qubits) {
+    std::vector<BasisGate> out;
+    for (size_t q = 0; q < n_qubits; q++) {
+        auto bit = static_cast<uint64_t>(1) << (q & 63);
+        for (auto i : terms) {
+            bool x = masks.X(i)[q / 64] & bit;
+            bool z = masks.Z(i)[q / 64] & bit;
+            if (x) {
+                if (z) {
+                    out.push_back({"Sdag", q, {}});
+                }
+                out.push_back({"H", q, {}});
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+//! Basis rotation that maps every term of a commuting group to Z strings.
+std::vector<BasisGate> GroupRotation(const PauliMasks& masks, const std::vector<size_t>& terms, size_t n_qubits) {
+    auto gens = Generators(masks.n_word);
+    for (auto i : terms) {
+        gens.Add(masks.X(i), masks.Z(i));
+    }
+    auto k = gens.rows.size();
+    std::vector<bits_t> xs(k, bits_t(n_qubits, 0));
+    std::vector<bits_t> zs(k, bits_t(n_qubits, 0));
+    for (size_t r = 0; r < k; r++) {
+        for (size_t q = 0; q < n_qubits; q++) {
+            xs[r][q] = (gens.rows[r][q / 64] >> (q & 63)) & 1;
+            zs[r][q] = (gens.rows[r][masks.n_word + q / 64] >> (q & 63)) & 1;
+        }
+    }
+    return CommutingRotation(std::move(xs), std::move(zs));
+}
+}  // namespace
+
+std::vector<MeasureGroup> GroupCommutingTerms(const qubit::QubitOperator& ops, bool qubit_wise) {
+    auto terms = ops.get_terms();
+    auto n_term = terms.size();
+    auto n_qubits = ops.count_qubits();
+    auto masks = PauliMasks(terms, n_qubits);
+    auto colour = n_term <= dsatur_max_terms ? ColourDSATUR(masks, n_term, qubit_wise)
+                                             : ColourGreedy(masks, n_term, qubit_wise);
+
+    size_t n_group = 0;
+    for (auto c : colour) {
+        n_group = std::max(n_group, c + 1);
+    }
+    std::vector<MeasureGroup> out(n_group);
+    for (size_t i = 0; i < n_term; i++) {
+        out[colour[i]].terms.push_back(i);
+    }
+    for (auto& group : out) {
+        group.rotation = qubit_wise ? QubitWiseRotation(masks, group.terms, n_qubits)
+                                    : GroupRotation(masks, group.terms, n_qubits);
+        for (auto i : group.terms) {
+            bits_t x(n_qubits);
+            bits_t z(n_qubits);
+            uint8_t r = 0;
+            for (size_t q = 0; q < n_qubits; q++) {
+                x[q] = (masks.X(i)[q / 64] >> (q & 63)) & 1;
+                z[q] = (masks.Z(i)[q / 64] >> (q & 63)) & 1;
+            }
+            for (const auto& gate : group.rotation) {
+                ConjugatePauli(gate, &x, &z, &r);
+            }
+            std::vector<size_t> qubits;
+            for (size_t q = 0; q < n_qubits; q++) {
+                if (x[q]) {
+                    throw std::runtime_error("Basis rotation does not diagonalize measure group.");
+                }
+                if (z[q]) {
+                    qubits.push_back(q);
+                }
+            }
+            group.z_qubits.push_back(std::move(qubits));
+            group.signs.push_back(r ? -1 : 1);
+        }
+    }
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+
+void ConjugatePauli(const BasisGate& gate, std::vector<uint8_t>* x, std::vector<uint8_t>* z, uint8_t* r) {
+    auto& xs = *x;
+    auto& zs = *z;
+    auto q = gate.obj;
+    if (gate.name == "H") {
+        *r ^= xs[q] & zs[q];
+        std::swap(xs[q], zs[q]);
+    } else if (gate.name == "Sdag") {
+        *r ^= xs[q] & (zs[q] ^ 1);
+        zs[q] ^= xs[q];
+    } else if (gate.name == "CNOT") {
+        auto c = gate.ctrls[0];
+        *r ^= xs[c] & zs[q] & (xs[q] ^ zs[c] ^ 1);
+        xs[q] ^= xs[c];
+        zs[c] ^= zs[q];
+    } else if (gate.name == "CZ") {
+        auto c = gate.ctrls[0];
+        *r ^= xs[c] & xs[q] & (zs[c] ^ zs[q]);
+        zs[c] ^= xs[q];
+        zs[q] ^= xs[c];
+    } else {
+        throw std::runtime_error("Unknown basis gate " + gate.name + ".");
+    }
+}
+
+std::vector<BasisGate> CommutingRotation(std::vector<std::vector<uint8_t>> xs, std::vector<std::vector<uint8_t>> zs,
+                                         std::vector<size_t>* pivots) {
+    auto k = xs.size();
+    auto n_qubits = k == 0 ? 0 : xs[0].size();
+    std::vector<BasisGate> out;
+    // Signs of generators are irrelevant for the rotation itself.
+    auto apply = [&](BasisGate gate) {
+        uint8_t r = 0;
+        for (size_t i = 0; i < k; i++) {
+            ConjugatePauli(gate, &xs[i], &zs[i], &r);
+        }
+        out.push_back(std::move(gate));
+    };
+    auto add_row = [&](size_t dst, size_t src) {
+        for (size_t q = 0; q < n_qubits; q++) {
+            xs[dst][q] ^= xs[src][q];
+            zs[dst][q] ^= zs[src][q];
+        }
+    };
+
+    std::vector<size_t> pivot;
+    while (true) {
+        // Row reduce X block, row operations only change the generating set.
+        pivot.clear();
+        for (size_t q = 0; q < n_qubits && pivot.size() < k; q++) {
+            auto row = pivot.size();
+            size_t sel = row;
+            while (sel < k && xs[sel][q] == 0) {
+                sel++;
+            }
+            if (sel == k) {
+                continue;
+            }
+            std::swap(xs[row], xs[sel]);
+            std::swap(zs[row], zs[sel]);
+            for (size_t i = 0; i < k; i++) {
+                if (i != row && xs[i][q]) {
+                    add_row(i, row);
+                }
+            }
+            pivot.push_back(q);
+        }
+        if (pivot.size() == k) {
+            break;
+        }
+        // Row pivot.size() has no X, it has Z on some non pivot qubit since it commutes with all pivot rows.
+        auto row = pivot.size();
+        size_t q = 0;
+        while (q < n_qubits && (zs[row][q] == 0 || std::find(pivot.begin(), pivot.end(), q) != pivot.end())) {
+            q++;
+        }
+        if (q == n_qubits) {
+            throw std::runtime_error("Pauli strings of basis rotation do not commute.");
+        }
+        apply({"H", q, {}});
+    }
+
+    std::vector<uint8_t> is_pivot(n_qubits, 0);
+    for (auto q : pivot) {
+        is_pivot[q] = 1;
+    }
+    for (size_t r = 0; r < k; r++) {
+        for (size_t q = 0; q < n_qubits; q++) {
+            if (!is_pivot[q] && xs[r][q]) {
+                apply({"CNOT", q, {pivot[r]}});
+            }
+        }
+    }
+    for (size_t r = 0; r < k; r++) {
+        for (size_t q = 0; q < n_qubits; q++) {
+            if (!is_pivot[q] && zs[r][q]) {
+                apply({"CZ", q, {pivot[r]}});
+            }
+        }
+    }
+    for (size_t r = 0; r < k; r++) {
+        for (size_t s = r + 1; s < k; s++) {
+            if (zs[r][pivot[s]]) {
+                apply({"CZ", pivot[s], {pivot[r]}});
+            }
+        }
+        if (zs[r][pivot[r]]) {
+            apply({"Sdag", pivot[r], {}});
+        }
+    }
+    for (auto q : pivot) {
+        apply({"H", q, {}});
+    }
+    if (pivots != nullptr) {
+        *pivots = std::move(pivot);
+    }
+    return out;
+}
+}  // namespace operators
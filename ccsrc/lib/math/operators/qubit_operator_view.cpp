@@ -16,6 +16,12 @@
 
 #include "math/operators/qubit_operator_view.h"
 
+#include <algorithm>
+#include <complex>
+#include <numeric>
+
+#include "config/openmp.h"
+
 #include "core/utils.h"
 #include "math/operators/utils.h"
 #include "math/pr/parameter_resolver.h"
@@ -136,7 +142,7 @@ bool SinglePauliStr::IsSameString(const key_t& k1, const key_t& k2) {
     return true;
 }
 
-std::string SinglePauliStr::GetString(const compress_term_t& pauli) {
+std::string SinglePauliStr::GetString(const term_view_t& pauli) {
     std::string out = "";
     int group_id = 0;
     auto& [pauli_string, coeff] = pauli;
@@ -168,7 +174,7 @@ std::string SinglePauliStr::GetString(const compress_term_t& pauli) {
     return coeff.ToString() + " [" + out + "]";
 }
 
-auto SinglePauliStr::Mul(const compress_term_t& lhs, const compress_term_t& rhs) -> compress_term_t {
+auto SinglePauliStr::Mul(const term_view_t& lhs, const term_view_t& rhs) -> compress_term_t {
     auto& [l_k, l_v] = lhs;
     auto& [r_k, r_v] = rhs;
     key_t pauli_string = {};
@@ -195,7 +201,7 @@ auto SinglePauliStr::Mul(const compress_term_t& lhs, const compress_term_t& rhs)
     return {pauli_string, coeff};
 }
 
-std::tuple<tn::Tensor, uint64_t> SinglePauliStr::MulSingleCompressTerm(uint64_t a, uint64_t b) {
+uint64_t SinglePauliStr::MulSingleCompressTerm(uint64_t a, uint64_t b, int* phase) {
     auto res = (~a & b) | (a & ~b);
     auto idx_0 = (~(a >> 1) & a & (b >> 1)) | (a & (b >> 1) & ~b) | ((a >> 1) & ~a & b) | ((a >> 1) & ~(b >> 1) & b);
     auto idx_1 = (~(a >> 1) & a & (b >> 1) & b) | ((a >> 1) & ~a & ~(b >> 1) & b) | ((a >> 1) & a & (b >> 1) & ~b);
@@ -204,8 +210,14 @@ std::tuple<tn::Tensor, uint64_t> SinglePauliStr::MulSingleCompressTerm(uint64_t
     auto num_I = mindquantum::CountOne(~idx_1 & idx_0);
     auto num_M_ONE = mindquantum::CountOne(idx_1 & ~idx_0);
     auto num_M_I = mindquantum::CountOne(idx_1 & idx_0);
-    auto out = (num_I + 2 * num_M_ONE + 3 * num_M_I) & 3;
-    switch (out) {
+    *phase = static_cast<int>((num_I + 2 * num_M_ONE + 3 * num_M_I) & 3);
+    return res;
+}
+
+std::tuple<tn::Tensor, uint64_t> SinglePauliStr::MulSingleCompressTerm(uint64_t a, uint64_t b) {
+    int phase = 0;
+    auto res = MulSingleCompressTerm(a, b, &phase);
+    switch (phase) {
         case (0):
             return {tn::ops::init_with_value(static_cast<double>(1.0)), res};
         case (1):
@@ -277,13 +289,10 @@ QubitOperator::QubitOperator(const py_dict_t& t) {
     std::vector<key_t> will_pop;
     for (auto& [k, v] : t) {
         auto term = SinglePauliStr::init(SinglePauliStr::py_terms_to_terms(k), v);
-        if (this->terms.m_map.find(term.first) != this->terms.m_map.end()) {
-            this->terms[term.first] = this->terms[term.first] + term.second;
-        } else {
-            this->terms.insert(term.first, term.second);
-        }
-        upper_type = tn::upper_type_v(this->terms[term.first].GetDtype(), this->dtype);
-        if (!this->terms[term.first].IsNotZero()) {
+        auto value = this->terms.contains(term.first) ? this->terms.at(term.first) + term.second : term.second;
+        this->terms.set(term.first, value);
+        upper_type = tn::upper_type_v(value.GetDtype(), this->dtype);
+        if (!value.IsNotZero()) {
             will_pop.push_back(term.first);
         }
     }
@@ -296,15 +305,11 @@ QubitOperator::QubitOperator(const py_dict_t& t) {
 }
 
 bool QubitOperator::Contains(const key_t& term) const {
-    return this->terms.m_map.find(term) != this->terms.m_map.end();
+    return this->terms.contains(term);
 }
 
 void QubitOperator::Update(const compress_term_t& pauli) {
-    if (this->Contains(pauli.first)) {
-        this->terms[pauli.first] = pauli.second;
-    } else {
-        this->terms.insert(pauli);
-    }
+    this->terms.set(pauli.first, pauli.second);
 }
 
 size_t QubitOperator::size() const {
@@ -313,9 +318,7 @@ size_t QubitOperator::size() const {
 
 void QubitOperator::CastTo(tn::TDtype dtype) {
     if (dtype != this->dtype) {
-        for (auto& [k, v] : this->terms) {
-            v.CastTo(dtype);
-        }
+        this->terms.cast(dtype);
         this->dtype = dtype;
     }
 }
@@ -333,7 +336,7 @@ std::string QubitOperator::ToString() const {
 
 size_t QubitOperator::count_qubits() const {
     int n_qubits = 0;
-    for (auto& [k, v] : this->terms.m_list) {
+    for (const auto& [k, v] : this->terms) {
         int group_id = k.size() - 1;
         for (auto word = k.rbegin(); word != k.rend(); ++word) {
             if ((*word) != 0) {
@@ -349,7 +352,7 @@ size_t QubitOperator::count_qubits() const {
 
 auto QubitOperator::get_terms() const -> dict_t {
     dict_t out{};
-    for (auto& [k, v] : this->terms.m_list) {
+    for (const auto& [k, v] : this->terms) {
         terms_t terms{};
         int group_id = 0;
         for (auto qubit_word : k) {
@@ -373,7 +376,7 @@ auto QubitOperator::get_terms() const -> dict_t {
 value_t QubitOperator::get_coeff(const terms_t& term) {
     auto terms = SinglePauliStr::init(term, parameter::ParameterResolver(tn::ops::ones(1)));
     if (this->Contains(terms.first)) {
-        return this->terms[terms.first] * terms.second;
+        return this->terms.at(terms.first) * terms.second;
     }
     throw std::out_of_range("term not in fermion operator");
 }
@@ -381,9 +384,7 @@ value_t QubitOperator::get_coeff(const terms_t& term) {
 QubitOperator QubitOperator::hermitian_conjugated() const {
     if (this->dtype == tn::TDtype::Complex128 || this->dtype == tn::TDtype::Complex64) {
         auto out = *this;
-        for (auto& [k, v] : out.terms.m_list) {
-            v = v.Conjugate();
-        }
+        out.terms.transform([](value_t& v) { v = v.Conjugate(); });
         return out;
     }
     return *this;
@@ -393,7 +394,7 @@ bool QubitOperator::is_singlet() const {
     return this->size() == 1;
 }
 bool QubitOperator::parameterized() const {
-    for (auto& [k, v] : this->terms.m_list) {
+    for (const auto& [k, v] : this->terms) {
         if (!v.IsConst()) {
             return true;
         }
@@ -402,19 +403,13 @@ bool QubitOperator::parameterized() const {
 }
 void QubitOperator::set_coeff(const terms_t& term, const parameter::ParameterResolver& value) {
     auto terms = SinglePauliStr::init(term, parameter::ParameterResolver(tn::ops::ones(1)));
-    if (this->Contains(terms.first)) {
-        this->terms[terms.first] = terms.second * value;
-    } else {
-        terms.second = terms.second * value;
-        this->terms.insert(terms);
-    }
-    auto upper_t = tensor::upper_type_v(this->dtype, this->terms[terms.first].GetDtype());
+    auto coeff = terms.second * value;
+    auto upper_t = tensor::upper_type_v(this->dtype, coeff.GetDtype());
     if (this->dtype != upper_t) {
         this->CastTo(upper_t);
     }
-    if (this->terms[terms.first].GetDtype() != upper_t) {
-        this->terms[terms.first].CastTo(upper_t);
-    }
+    coeff.CastTo(upper_t);
+    this->terms.set(terms.first, coeff);
 }
 
 QubitOperator::QubitOperator(const key_t& k, const value_t& v) {
@@ -423,7 +418,7 @@ QubitOperator::QubitOperator(const key_t& k, const value_t& v) {
 }
 std::vector<std::pair<parameter::ParameterResolver, QubitOperator>> QubitOperator::split() const {
     auto out = std::vector<std::pair<parameter::ParameterResolver, QubitOperator>>();
-    for (auto& [k, v] : this->terms.m_list) {
+    for (const auto& [k, v] : this->terms) {
         out.push_back({v, QubitOperator(k, parameter::ParameterResolver(tn::ops::ones(1, v.GetDtype())))});
     }
     return out;
@@ -433,7 +428,7 @@ parameter::ParameterResolver QubitOperator::singlet_coeff() const {
     if (!this->is_singlet()) {
         throw std::runtime_error("Operator is not singlet.");
     }
-    return this->terms.m_list.begin()->second;
+    return this->terms.begin()->second;
 }
 
 std::vector<QubitOperator> QubitOperator::singlet() const {
@@ -452,18 +447,12 @@ std::vector<QubitOperator> QubitOperator::singlet() const {
 
 void QubitOperator::subs(const parameter::ParameterResolver& other) {
     auto new_type = this->dtype;
-    std::vector<key_t> will_pop;
-    for (auto& [k, v] : this->terms.m_list) {
+    this->terms.transform([&](value_t& v) {
         if (v.subs(other).size() != 0) {
             new_type = tensor::upper_type_v(this->dtype, v.GetDtype());
         }
-        if (!v.IsNotZero()) {
-            will_pop.push_back(k);
-        }
-    }
-    for (auto& k : will_pop) {
-        this->terms.erase(k);
-    }
+    });
+    this->terms.erase_zeros();
     if (new_type != this->dtype) {
         this->CastTo(new_type);
     }
@@ -471,29 +460,17 @@ void QubitOperator::subs(const parameter::ParameterResolver& other) {
 
 QubitOperator QubitOperator::imag() const {
     auto out = *this;
-    std::vector<key_t> will_pop;
-    for (auto& [k, v] : out.terms.m_list) {
-        v = v.Imag();
-        if (!v.IsNotZero()) {
-            will_pop.push_back(k);
-        }
-    }
+    out.terms.transform([](value_t& v) { v = v.Imag(); });
+    out.terms.erase_zeros();
     out.dtype = tn::ToRealType(this->dtype);
-    std::for_each(will_pop.begin(), will_pop.end(), [&](auto i) { out.terms.erase(i); });
     return out;
 }
 
 QubitOperator QubitOperator::real() const {
     auto out = *this;
-    std::vector<key_t> will_pop;
-    for (auto& [k, v] : out.terms.m_list) {
-        v = v.Real();
-        if (!v.IsNotZero()) {
-            will_pop.push_back(k);
-        }
-    }
+    out.terms.transform([](value_t& v) { v = v.Real(); });
+    out.terms.erase_zeros();
     out.dtype = tn::ToRealType(this->dtype);
-    std::for_each(will_pop.begin(), will_pop.end(), [&](auto i) { out.terms.erase(i); });
     return out;
 }
 
@@ -503,22 +480,7 @@ tn::TDtype QubitOperator::GetDtype() const {
 // -----------------------------------------------------------------------------
 
 QubitOperator& QubitOperator::operator+=(const tn::Tensor& c) {
-    if (this->Contains(key_t{0})) {
-        this->terms[key_t{0}] = this->terms[key_t{0}] + c;
-    } else {
-        this->terms.insert({key_t{0}, parameter::ParameterResolver(c)});
-    }
-    auto upper_t = tn::upper_type_v(c.dtype, this->dtype);
-    if (upper_t != this->GetDtype()) {
-        this->CastTo(upper_t);
-        return *this;
-    }
-    if (c.dtype != upper_t) {
-        this->terms[key_t{0}].CastTo(upper_t);
-    }
-    if (!this->terms[key_t{0}].IsNotZero()) {
-        this->terms.erase(key_t{0});
-    }
+    AccumulateTerm(this, key_t{0}, parameter::ParameterResolver(c));
     return *this;
 }
 QubitOperator& QubitOperator::operator-=(const tn::Tensor& c) {
@@ -527,77 +489,17 @@ QubitOperator& QubitOperator::operator-=(const tn::Tensor& c) {
 }
 
 QubitOperator& QubitOperator::operator+=(const QubitOperator& other) {
-    for (const auto& term : other.terms) {
-        if (this->Contains(term.first)) {
-            this->terms[term.first] = this->terms[term.first] + term.second;
-            if (this->dtype != this->terms[term.first].GetDtype()) {
-                this->CastTo(this->terms[term.first].GetDtype());
-            }
-            if (!this->terms[term.first].IsNotZero()) {
-                this->terms.erase(term.first);
-            }
-        } else {
-            this->terms.insert(term);
-            auto upper_t = tn::upper_type_v(this->dtype, term.second.GetDtype());
-            if (this->GetDtype() != upper_t) {
-                this->CastTo(upper_t);
-            }
-            if (term.second.GetDtype() != upper_t) {
-                this->terms[term.first].CastTo(upper_t);
-            }
-            if (!this->terms[term.first].IsNotZero()) {
-                this->terms.erase(term.first);
-            }
-        }
-    }
+    AccumulateOperator(this, other);
     return *this;
 }
 
 QubitOperator& QubitOperator::operator-=(const QubitOperator& other) {
-    for (const auto& term : other.terms) {
-        if (this->Contains(term.first)) {
-            this->terms[term.first] = this->terms[term.first] - term.second;
-            if (this->dtype != this->terms[term.first].GetDtype()) {
-                this->CastTo(this->terms[term.first].GetDtype());
-            }
-            if (!this->terms[term.first].IsNotZero()) {
-                this->terms.erase(term.first);
-            }
-        } else {
-            this->terms.insert({term.first, parameter::ParameterResolver(tensor::ops::zeros(1, term.second.GetDtype()))
-                                                - term.second});
-            auto upper_t = tn::upper_type_v(this->dtype, term.second.GetDtype());
-            if (this->GetDtype() != upper_t) {
-                this->CastTo(upper_t);
-            }
-            if (term.second.GetDtype() != upper_t) {
-                this->terms[term.first].CastTo(upper_t);
-            }
-            if (!this->terms[term.first].IsNotZero()) {
-                this->terms.erase(term.first);
-            }
-        }
-    }
+    AccumulateOperator(this, other, true);
     return *this;
 }
 
 QubitOperator operator+(QubitOperator lhs, const tensor::Tensor& rhs) {
-    if (lhs.Contains(key_t{0})) {
-        lhs.terms[key_t{0}] = lhs.terms[key_t{0}] + rhs;
-    } else {
-        lhs.terms.insert({key_t{0}, parameter::ParameterResolver(rhs)});
-    }
-    auto upper_t = tn::upper_type_v(lhs.GetDtype(), rhs.dtype);
-    if (upper_t != lhs.GetDtype()) {
-        lhs.CastTo(upper_t);
-        return lhs;
-    }
-    if (upper_t != rhs.dtype) {
-        lhs.terms[key_t{0}].CastTo(upper_t);
-    }
-    if (!lhs.terms[key_t{0}].IsNotZero()) {
-        lhs.terms.erase(key_t{0});
-    }
+    lhs += rhs;
     return lhs;
 }
 
@@ -616,31 +518,196 @@ QubitOperator operator-(QubitOperator lhs, const QubitOperator& rhs) {
     return lhs;
 }
 
+namespace {
+//! Number of term pairs above which operator product runs in parallel.
+constexpr omp::idx_t product_omp_threshold = 1 << 14;
+//! Term pairs generated by one block of lhs rows before it is reduced.
+constexpr size_t product_block_size = 1 << 16;
+
+/*!
+ * \brief Pauli strings with numeric coefficients produced by operator multiplication.
+ *
+ * Every pauli string is stored as width words padded with zero, together with its real word length, so that equal
+ * strings can be merged by sorting.
+ */
+struct ProductTerms {
+    size_t width = 0;
+    std::vector<uint64_t> words;
+    std::vector<uint32_t> len;
+    //! Index of the term pair that inserts this string in the serial product, used to restore its term order.
+    std::vector<uint64_t> order;
+    std::vector<std::complex<double>> coeff;
+    bool has_imag_phase = false;
+
+    size_t size() const {
+        return len.size();
+    }
+
+    bool Less(size_t a, size_t b) const {
+        if (len[a] != len[b]) {
+            return len[a] < len[b];
+        }
+        auto wa = words.begin() + a * width;
+        auto wb = words.begin() + b * width;
+        for (size_t i = 0; i < len[a]; i++) {
+            if (wa[i] != wb[i]) {
+                return wa[i] < wb[i];
+            }
+        }
+        return order[a] < order[b];
+    }
+
+    bool SameString(size_t a, size_t b) const {
+        return len[a] == len[b] && std::equal(words.begin() + a * width, words.begin() + a * width + len[a],
+                                              words.begin() + b * width);
+    }
+
+    //! Sort by pauli string and merge equal strings, coefficients are summed in order of generation.
+    void SortReduce() {
+        std::vector<size_t> perm(size());
+        std::iota(perm.begin(), perm.end(), 0);
+        std::sort(perm.begin(), perm.end(), [&](size_t a, size_t b) { return Less(a, b); });
+        ProductTerms out;
+        out.width = width;
+        out.has_imag_phase = has_imag_phase;
+        for (size_t i = 0; i < perm.size();) {
+            auto head = perm[i];
+            auto c = coeff[head];
+            auto o = order[head];
+            size_t j = i + 1;
+            for (; j < perm.size() && SameString(head, perm[j]); j++) {
+                // Like AccumulateTerm, a string whose sum cancels is erased and comes back with the next product.
+                if (c == 0.0) {
+                    o = order[perm[j]];
+                }
+                c += coeff[perm[j]];
+            }
+            out.words.insert(out.words.end(), words.begin() + head * width, words.begin() + (head + 1) * width);
+            out.len.push_back(len[head]);
+            out.order.push_back(o);
+            out.coeff.push_back(c);
+            i = j;
+        }
+        *this = std::move(out);
+    }
+
+    void Append(const ProductTerms& other) {
+        words.insert(words.end(), other.words.begin(), other.words.end());
+        len.insert(len.end(), other.len.begin(), other.len.end());
+        order.insert(order.end(), other.order.begin(), other.order.end());
+        coeff.insert(coeff.end(), other.coeff.begin(), other.coeff.end());
+        has_imag_phase = has_imag_phase || other.has_imag_phase;
+    }
+};
+}  // namespace
+
+void QubitOperator::NumericMulInplace(const QubitOperator& other, double tol) {
+    constexpr std::complex<double> i_pow[4] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    std::vector<const key_t*> l_keys, r_keys;
+    std::vector<std::complex<double>> l_coeff, r_coeff;
+    size_t width = 0;
+    auto gather = [&](const QubitOperator& op, std::vector<const key_t*>* keys, std::vector<std::complex<double>>* c) {
+        keys->reserve(op.size());
+        c->reserve(op.size());
+        for (const auto& [k, v] : op.terms) {
+            keys->push_back(&k);
+            c->push_back(tn::ops::cpu::to_vector<std::complex<double>>(v.const_value)[0]);
+            width = std::max(width, k.size());
+        }
+    };
+    gather(*this, &l_keys, &l_coeff);
+    gather(other, &r_keys, &r_coeff);
+    auto n_lhs = l_keys.size();
+    auto n_rhs = r_keys.size();
+    if (n_lhs == 0 || n_rhs == 0) {
+        this->terms = {};
+        return;
+    }
+
+    size_t rows_per_block = std::max<size_t>(1, product_block_size / n_rhs);
+    auto n_block = static_cast<omp::idx_t>((n_lhs + rows_per_block - 1) / rows_per_block);
+    std::vector<ProductTerms> blocks(n_block);
+    auto n_pair = static_cast<omp::idx_t>(n_lhs * n_rhs);
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), n_pair, product_omp_threshold,
+        for (omp::idx_t b = 0; b < n_block; b++) {
+            auto& buf = blocks[b];
+            buf.width = width;
+            auto row_begin = static_cast<size_t>(b) * rows_per_block;
+            auto row_end = std::min(n_lhs, row_begin + rows_per_block);
+            for (size_t i = row_begin; i < row_end; i++) {
+                const auto& l_k = *l_keys[i];
+                for (size_t j = 0; j < n_rhs; j++) {
+                    const auto& r_k = *r_keys[j];
+                    auto n_word = std::max(l_k.size(), r_k.size());
+                    int phase = 0;
+                    for (size_t w = 0; w < width; w++) {
+                        uint64_t l_w = w < l_k.size() ? l_k[w] : 0;
+                        uint64_t r_w = w < r_k.size() ? r_k[w] : 0;
+                        int p = 0;
+                        buf.words.push_back(SinglePauliStr::MulSingleCompressTerm(l_w, r_w, &p));
+                        phase += p;
+                    }
+                    phase &= 3;
+                    auto c = l_coeff[i] * r_coeff[j] * i_pow[phase];
+                    buf.has_imag_phase = buf.has_imag_phase || (phase & 1);
+                    buf.len.push_back(static_cast<uint32_t>(n_word));
+                    buf.order.push_back(i * n_rhs + j);
+                    buf.coeff.push_back(c);
+                }
+            }
+            buf.SortReduce();
+        })
+    // clang-format on
+
+    auto& out = blocks[0];
+    for (omp::idx_t b = 1; b < n_block; b++) {
+        out.Append(blocks[b]);
+        blocks[b] = ProductTerms();
+    }
+    if (n_block > 1) {
+        out.SortReduce();
+    }
+
+    auto dtype = tn::upper_type_v(tn::upper_type_v(this->dtype, other.dtype), tn::TDtype::Float64);
+    if (out.has_imag_phase) {
+        dtype = tn::upper_type_v(dtype, tn::TDtype::Complex128);
+    }
+    std::vector<size_t> perm(out.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::sort(perm.begin(), perm.end(), [&](size_t a, size_t b) { return out.order[a] < out.order[b]; });
+    QTerm_t new_terms;
+    new_terms.reserve(perm.size());
+    bool is_complex = dtype == tn::TDtype::Complex64 || dtype == tn::TDtype::Complex128;
+    for (auto t : perm) {
+        // With the default tol of zero this is the rule of AccumulateTerm: only exact zeros are dropped.
+        if (std::abs(out.coeff[t]) <= tol) {
+            continue;
+        }
+        auto value = is_complex ? parameter::ParameterResolver(tn::ops::init_with_value(out.coeff[t]))
+                                : parameter::ParameterResolver(tn::ops::init_with_value(out.coeff[t].real()));
+        value.CastTo(dtype);
+        key_t key(out.words.begin() + t * width, out.words.begin() + t * width + out.len[t]);
+        new_terms.insert(key, value);
+    }
+    this->terms = std::move(new_terms);
+    this->dtype = dtype;
+}
+
 QubitOperator QubitOperator::operator*=(const QubitOperator& other) {
+    if (!this->parameterized() && !other.parameterized()) {
+        this->NumericMulInplace(other);
+        return *this;
+    }
     auto out = QubitOperator();
-    for (auto& this_term : this->terms) {
+    out.dtype = this->dtype;
+    for (const auto& this_term : this->terms) {
         for (const auto& other_term : other.terms) {
             auto new_term = SinglePauliStr::Mul(this_term, other_term);
-            if (out.Contains(new_term.first)) {
-                out.terms[new_term.first] = out.terms[new_term.first] + new_term.second;
-                if (this->dtype != out.terms[new_term.first].GetDtype()) {
-                    this->CastTo(out.terms[new_term.first].GetDtype());
-                }
-            } else {
-                out.terms.insert(new_term);
-                auto upper_t = tn::upper_type_v(this->dtype, out.terms[new_term.first].GetDtype());
-                if (this->GetDtype() != upper_t) {
-                    this->CastTo(upper_t);
-                }
-                if (new_term.second.GetDtype() != upper_t) {
-                    out.terms[new_term.first].CastTo(upper_t);
-                }
-            }
-            if (!out.terms[new_term.first].IsNotZero()) {
-                out.terms.erase(new_term.first);
-            }
+            AccumulateTerm(&out, new_term.first, new_term.second);
         }
     }
+    this->dtype = out.dtype;
     std::swap(out.terms, this->terms);
     return *this;
 }
@@ -660,10 +727,10 @@ QubitOperator QubitOperator::operator*=(const parameter::ParameterResolver& othe
         this->terms = {};
         return *this;
     }
-    for (auto& [k, v] : this->terms.m_list) {
+    this->terms.transform([&](value_t& v) {
         v *= other;
         this->dtype = v.GetDtype();
-    }
+    });
     return *this;
 }
 }  // namespace operators::qubit
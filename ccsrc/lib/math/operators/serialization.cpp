@@ -0,0 +1,312 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "math/operators/serialization.h"
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif  // !_WIN32
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "math/pr/symbol_table.h"
+#include "math/tensor/ops/memory_operator.h"
+
+namespace operators::serialization {
+namespace {
+constexpr size_t Pad(size_t len) {
+    return (len + 7) / 8 * 8;
+}
+
+tn::Tensor ReadTensor(const char* p, tn::TDtype dtype) {
+    auto out = tn::ops::init(1, dtype);
+    std::memcpy(out.data, p, tn::bit_size(dtype));
+    return out;
+}
+}  // namespace
+
+// -----------------------------------------------------------------------------
+
+OperatorWriter::OperatorWriter(const std::string& filename, OperatorKind kind, tn::TDtype dtype)
+    : file(filename, std::ios::binary | std::ios::trunc) {
+    if (!file) {
+        throw std::runtime_error("Can not open file " + filename + " for writing.");
+    }
+    std::memcpy(header.magic, FileHeader::magic_value, sizeof(header.magic));
+    header.version = FileHeader::current_version;
+    header.endian = FileHeader::endian_tag;
+    header.kind = static_cast<uint8_t>(kind);
+    header.dtype = static_cast<uint8_t>(dtype);
+    Write(&header, sizeof(header));
+}
+
+OperatorWriter::~OperatorWriter() {
+    if (!closed) {
+        try {
+            Close();
+        } catch (...) {
+        }
+    }
+}
+
+void OperatorWriter::Write(const void* data, size_t len) {
+    static constexpr char zeros[8] = {0};
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(len));
+    file.write(zeros, static_cast<std::streamsize>(Pad(len) - len));
+    pos += Pad(len);
+}
+
+void OperatorWriter::Append(const key_t& key, const value_t& value) {
+    if (closed) {
+        throw std::runtime_error("Can not append term to a closed operator file.");
+    }
+    auto dtype = static_cast<tn::TDtype>(header.dtype);
+    auto write_tensor = [&](const tn::Tensor& t) {
+        if (t.dtype == dtype) {
+            Write(t.data, tn::bit_size(dtype));
+        } else {
+            auto casted = t.astype(dtype);
+            Write(casted.data, tn::bit_size(dtype));
+        }
+    };
+    offsets.push_back(pos);
+    uint32_t sizes[2] = {static_cast<uint32_t>(key.size()), static_cast<uint32_t>(value.terms_.size())};
+    Write(sizes, sizeof(sizes));
+    Write(key.data(), key.size() * sizeof(uint64_t));
+    write_tensor(value.const_value);
+    for (const auto& term : value.terms_) {
+        const auto& name = term.name();
+        uint8_t param[8] = {0};
+        auto name_len = static_cast<uint32_t>(name.size());
+        std::memcpy(param, &name_len, sizeof(name_len));
+        param[4] = term.flags;
+        Write(param, sizeof(param));
+        Write(name.data(), name.size());
+        write_tensor(term.value);
+        header.parameterized = 1;
+    }
+}
+
+void OperatorWriter::Close() {
+    if (closed) {
+        return;
+    }
+    closed = true;
+    header.index_offset = pos;
+    header.n_terms = offsets.size();
+    Write(offsets.data(), offsets.size() * sizeof(uint64_t));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Failed to write operator file.");
+    }
+}
+
+void Save(const qubit::QubitOperator& ops, const std::string& filename) {
+    auto writer = OperatorWriter(filename, OperatorKind::Qubit, ops.dtype);
+    for (const auto& [key, value] : ops.terms) {
+        writer.Append(key, value);
+    }
+    writer.Close();
+}
+
+void Save(const fermion::FermionOperator& ops, const std::string& filename) {
+    auto writer = OperatorWriter(filename, OperatorKind::Fermion, ops.dtype);
+    for (const auto& [key, value] : ops.terms) {
+        writer.Append(key, value);
+    }
+    writer.Close();
+}
+
+// -----------------------------------------------------------------------------
+
+OperatorFile::OperatorFile(const std::string& filename) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Can not open file " + filename + ".");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Can not stat file " + filename + ".");
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length >= sizeof(FileHeader)) {
+        void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Can not map file " + filename + ".");
+        }
+        data = static_cast<const char*>(p);
+        mapped = true;
+    }
+    close(fd);
+#else
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Can not open file " + filename + ".");
+    }
+    length = static_cast<size_t>(in.tellg());
+    buffer.resize(Pad(length) / sizeof(uint64_t));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(length));
+    data = reinterpret_cast<const char*>(buffer.data());
+#endif  // !_WIN32
+    auto invalid = [&](const std::string& reason) {
+        Release();
+        return std::runtime_error("File " + filename + " is not a valid operator file: " + reason + ".");
+    };
+    if (length < sizeof(FileHeader)) {
+        throw invalid("file is too short");
+    }
+    header = reinterpret_cast<const FileHeader*>(data);
+    if (std::memcmp(header->magic, FileHeader::magic_value, sizeof(header->magic)) != 0) {
+        throw invalid("wrong magic number");
+    }
+    if (header->endian != FileHeader::endian_tag) {
+        throw invalid("wrong byte order");
+    }
+    if (header->version != FileHeader::current_version) {
+        throw invalid("unsupported version " + std::to_string(header->version));
+    }
+    if (header->kind > static_cast<uint8_t>(OperatorKind::Fermion)
+        || header->dtype > static_cast<uint8_t>(tn::TDtype::Complex128)) {
+        throw invalid("unknown operator kind or data type");
+    }
+    if (header->index_offset % 8 != 0 || header->index_offset > length
+        || header->n_terms > (length - header->index_offset) / sizeof(uint64_t)) {
+        throw invalid("index out of range");
+    }
+    index = reinterpret_cast<const uint64_t*>(data + header->index_offset);
+}
+
+OperatorFile::~OperatorFile() {
+    Release();
+}
+
+void OperatorFile::Release() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(data), length);
+        mapped = false;
+    }
+#endif  // !_WIN32
+}
+
+auto OperatorFile::operator[](size_t idx) const -> Term {
+    if (idx >= size()) {
+        throw std::out_of_range("Term index " + std::to_string(idx) + " out of range.");
+    }
+    auto off = index[idx];
+    auto limit = header->index_offset;
+    if (off % 8 != 0 || off < sizeof(FileHeader) || off + 8 > limit) {
+        throw std::runtime_error("Broken record of term " + std::to_string(idx) + " in operator file.");
+    }
+    uint32_t sizes[2];
+    std::memcpy(sizes, data + off, sizeof(sizes));
+    if (sizes[0] > (limit - off - 8) / sizeof(uint64_t)) {
+        throw std::runtime_error("Broken record of term " + std::to_string(idx) + " in operator file.");
+    }
+    auto key = reinterpret_cast<const uint64_t*>(data + off + 8);
+    return {key, sizes[0], this, reinterpret_cast<const char*>(key + sizes[0]), sizes[1]};
+}
+
+value_t OperatorFile::Term::Value() const {
+    auto dtype = file->GetDtype();
+    auto elem = Pad(tn::bit_size(dtype));
+    auto end = file->data + file->header->index_offset;
+    auto p = coeff;
+    auto check = [&](size_t len) {
+        if (static_cast<size_t>(end - p) < len) {
+            throw std::runtime_error("Broken coefficient in operator file.");
+        }
+    };
+    value_t out;
+    check(elem);
+    out.const_value = ReadTensor(p, dtype);
+    p += elem;
+    out.terms_.reserve(n_param);
+    for (size_t i = 0; i < n_param; i++) {
+        check(8);
+        uint32_t name_len;
+        std::memcpy(&name_len, p, sizeof(name_len));
+        auto flags = static_cast<uint8_t>(p[4]);
+        p += 8;
+        check(Pad(name_len) + elem);
+        auto id = parameter::SymbolTable::Intern(std::string(p, name_len));
+        p += Pad(name_len);
+        out.terms_.push_back({id, ReadTensor(p, dtype), flags});
+        p += elem;
+    }
+    out.SortTerms();
+    return out;
+}
+
+qubit::QubitOperator OperatorFile::ToQubitOperator() const {
+    if (Kind() != OperatorKind::Qubit) {
+        throw std::runtime_error("Operator file does not contain a qubit operator.");
+    }
+    qubit::QubitOperator out;
+    out.dtype = GetDtype();
+    out.terms.reserve(size());
+    for (const auto& term : *this) {
+        out.terms.insert(term.Key(), term.Value());
+    }
+    return out;
+}
+
+fermion::FermionOperator OperatorFile::ToFermionOperator() const {
+    if (Kind() != OperatorKind::Fermion) {
+        throw std::runtime_error("Operator file does not contain a fermion operator.");
+    }
+    fermion::FermionOperator out;
+    out.dtype = GetDtype();
+    out.terms.reserve(size());
+    for (const auto& term : *this) {
+        out.terms.insert(term.Key(), term.Value());
+    }
+    return out;
+}
+
+qubit::QubitOperator OperatorFile::QubitTerm(size_t idx) const {
+    if (Kind() != OperatorKind::Qubit) {
+        throw std::runtime_error("Operator file does not contain a qubit operator.");
+    }
+    auto term = (*this)[idx];
+    qubit::QubitOperator out;
+    out.dtype = GetDtype();
+    out.terms.insert(term.Key(), term.Value());
+    return out;
+}
+
+fermion::FermionOperator OperatorFile::FermionTerm(size_t idx) const {
+    if (Kind() != OperatorKind::Fermion) {
+        throw std::runtime_error("Operator file does not contain a fermion operator.");
+    }
+    auto term = (*this)[idx];
+    fermion::FermionOperator out;
+    out.dtype = GetDtype();
+    out.terms.insert(term.Key(), term.Value());
+    return out;
+}
+}  // namespace operators::serialization
@@ -0,0 +1,341 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "math/operators/tapering.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config/openmp.h"
+
+#include "core/utils.h"
+#include "math/operators/utils.h"
+
+namespace operators {
+namespace {
+using bits_t = std::vector<uint8_t>;
+using row_t = std::vector<uint64_t>;
+
+constexpr size_t npos = std::numeric_limits<size_t>::max();
+//! Number of terms above which terms are processed in parallel.
+constexpr omp::idx_t tapering_omp_threshold = 1024;
+//! Number of terms handled by one block.
+constexpr size_t tapering_block_size = 512;
+
+bool GetBit(const row_t& row, size_t idx) {
+    return (row[idx / 64] >> (idx & 63)) & 1;
+}
+
+//! Unpack X and Z bits of a compressed pauli key, every word holds 32 qubits.
+void UnpackKey(const key_t& key, bits_t* x, bits_t* z) {
+    for (size_t w = 0; w < key.size(); w++) {
+        size_t q = w * 32;
+        for (auto word = key[w]; word != 0; word >>= 2, q++) {
+            auto value = static_cast<qubit::TermValue>(word & 3);
+            (*x)[q] = value == qubit::TermValue::X || value == qubit::TermValue::Y;
+            (*z)[q] = value == qubit::TermValue::Z || value == qubit::TermValue::Y;
+        }
+    }
+}
+
+//! Compressed pauli key of X and Z bits, qubit q is written to label[q] unless it is npos.
+key_t PackKey(const bits_t& x, const bits_t& z, const std::vector<size_t>& label) {
+    key_t key = {0};
+    for (size_t q = 0; q < x.size(); q++) {
+        if (label[q] == npos || (x[q] == 0 && z[q] == 0)) {
+            continue;
+        }
+        auto value = x[q] ? (z[q] ? qubit::TermValue::Y : qubit::TermValue::X) : qubit::TermValue::Z;
+        auto idx = label[q];
+        if (key.size() <= idx / 32) {
+            key.resize(idx / 32 + 1, 0);
+        }
+        key[idx / 32] |= static_cast<uint64_t>(value) << ((idx & 31) * 2);
+    }
+    return key;
+}
+
+//! Row echelon basis over GF(2), every row has a distinct pivot bit.
+struct RowBasis {
+    std::vector<row_t> rows;
+    std::vector<size_t> pivots;
+
+    void Add(row_t row) {
+        for (size_t k = 0; k < rows.size(); k++) {
+            if (GetBit(row, pivots[k])) {
+                for (size_t w = 0; w < row.size(); w++) {
+                    row[w] ^= rows[k][w];
+                }
+            }
+        }
+        for (size_t w = 0; w < row.size(); w++) {
+            if (row[w] != 0) {
+                pivots.push_back(w * 64 + mindquantum::CountOne((row[w] & (~row[w] + 1)) - 1));
+                rows.push_back(std::move(row));
+                return;
+            }
+        }
+    }
+    //! Clear the pivot bit of every row from all other rows.
+    void Reduce() {
+        for (size_t i = 0; i < rows.size(); i++) {
+            for (size_t j = 0; j < rows.size(); j++) {
+                if (j != i && GetBit(rows[j], pivots[i])) {
+                    for (size_t w = 0; w < rows[j].size(); w++) {
+                        rows[j][w] ^= rows[i][w];
+                    }
+                }
+            }
+        }
+    }
+};
+
+bool Anticommute(const bits_t& x1, const bits_t& z1, const bits_t& x2, const bits_t& z2) {
+    uint8_t odd = 0;
+    for (size_t q = 0; q < x1.size(); q++) {
+        odd ^= (x1[q] & z2[q]) ^ (z1[q] & x2[q]);
+    }
+    return odd;
+}
+
+//! Pauli strings that commute with every term, as rows of X bits followed by Z bits on n_qubits.
+void SymmetryKernel(const qubit::QubitOperator& ops, size_t n_qubits, std::vector<bits_t>* xs,
+                    std::vector<bits_t>* zs) {
+    std::vector<const key_t*> keys;
+    keys.reserve(ops.size());
+    for (const auto& [key, value] : ops.terms) {
+        keys.push_back(&key);
+    }
+    // A string v commutes with term t when z_t . v_x + x_t . v_z = 0, so term t is the row (z_t, x_t).
+    auto n_word = (2 * n_qubits + 63) / 64;
+    auto n_block = std::max<size_t>(1, (keys.size() + tapering_block_size - 1) / tapering_block_size);
+    std::vector<RowBasis> partial(n_block);
+
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), static_cast<omp::idx_t>(keys.size()),
+                  tapering_omp_threshold,
+        for (omp::idx_t b = 0; b < static_cast<omp::idx_t>(n_block); b++) {
+            auto begin = static_cast<size_t>(b) * tapering_block_size;
+            auto end = std::min(keys.size(), begin + tapering_block_size);
+            bits_t x(n_qubits);
+            bits_t z(n_qubits);
+            for (auto i = begin; i < end; i++) {
+                std::fill(x.begin(), x.end(), 0);
+                std::fill(z.begin(), z.end(), 0);
+                UnpackKey(*keys[i], &x, &z);
+                row_t row(n_word, 0);
+                for (size_t q = 0; q < n_qubits; q++) {
+                    row[q / 64] |= static_cast<uint64_t>(z[q]) << (q & 63);
+                    row[(n_qubits + q) / 64] |= static_cast<uint64_t>(x[q]) << ((n_qubits + q) & 63);
+                }
+                partial[b].Add(std::move(row));
+            }
+        })
+    // clang-format on
+
+    auto& basis = partial[0];
+    for (size_t b = 1; b < n_block; b++) {
+        for (auto& row : partial[b].rows) {
+            basis.Add(std::move(row));
+        }
+    }
+    basis.Reduce();
+
+    std::vector<uint8_t> is_pivot(2 * n_qubits, 0);
+    for (auto p : basis.pivots) {
+        is_pivot[p] = 1;
+    }
+    for (size_t f = 0; f < 2 * n_qubits; f++) {
+        if (is_pivot[f]) {
+            continue;
+        }
+        bits_t v(2 * n_qubits, 0);
+        v[f] = 1;
+        for (size_t i = 0; i < basis.rows.size(); i++) {
+            if (GetBit(basis.rows[i], f)) {
+                v[basis.pivots[i]] = 1;
+            }
+        }
+        xs->emplace_back(v.begin(), v.begin() + n_qubits);
+        zs->emplace_back(v.begin() + n_qubits, v.end());
+    }
+}
+
+//! Keep one string of every anticommuting pair with symplectic Gram-Schmidt, the rest commute with each other.
+void CommutingSubset(std::vector<bits_t>* xs, std::vector<bits_t>* zs) {
+    std::vector<bits_t> out_x;
+    std::vector<bits_t> out_z;
+    auto& x = *xs;
+    auto& z = *zs;
+    auto add_row = [&](size_t dst, const bits_t& src_x, const bits_t& src_z) {
+        for (size_t q = 0; q < x[dst].size(); q++) {
+            x[dst][q] ^= src_x[q];
+            z[dst][q] ^= src_z[q];
+        }
+    };
+    while (!x.empty()) {
+        auto vx = std::move(x.front());
+        auto vz = std::move(z.front());
+        x.erase(x.begin());
+        z.erase(z.begin());
+        size_t partner = 0;
+        while (partner < x.size() && !Anticommute(vx, vz, x[partner], z[partner])) {
+            partner++;
+        }
+        if (partner < x.size()) {
+            auto wx = std::move(x[partner]);
+            auto wz = std::move(z[partner]);
+            x.erase(x.begin() + partner);
+            z.erase(z.begin() + partner);
+            for (size_t i = 0; i < x.size(); i++) {
+                bool with_v = Anticommute(x[i], z[i], vx, vz);
+                bool with_w = Anticommute(x[i], z[i], wx, wz);
+                if (with_w) {
+                    add_row(i, vx, vz);
+                }
+                if (with_v) {
+                    add_row(i, wx, wz);
+                }
+            }
+        }
+        out_x.push_back(std::move(vx));
+        out_z.push_back(std::move(vz));
+    }
+    *xs = std::move(out_x);
+    *zs = std::move(out_z);
+}
+}  // namespace
+
+Z2Symmetries FindZ2Symmetries(const qubit::QubitOperator& ops) {
+    auto n_qubits = ops.count_qubits();
+    std::vector<bits_t> xs;
+    std::vector<bits_t> zs;
+    SymmetryKernel(ops, n_qubits, &xs, &zs);
+    CommutingSubset(&xs, &zs);
+
+    Z2Symmetries out;
+    out.rotation = CommutingRotation(std::move(xs), std::move(zs), &out.qubits);
+    std::vector<size_t> label(n_qubits);
+    for (size_t q = 0; q < n_qubits; q++) {
+        label[q] = q;
+    }
+    // Generator i is Z on qubits[i] rotated back, gates are self inverse except Sdag.
+    for (auto p : out.qubits) {
+        bits_t x(n_qubits, 0);
+        bits_t z(n_qubits, 0);
+        uint8_t r = 0;
+        z[p] = 1;
+        for (auto gate = out.rotation.rbegin(); gate != out.rotation.rend(); ++gate) {
+            for (int i = 0; i < (gate->name == "Sdag" ? 3 : 1); i++) {
+                ConjugatePauli(*gate, &x, &z, &r);
+            }
+        }
+        qubit::QubitOperator generator;
+        generator.terms.insert(PackKey(x, z, label), parameter::ParameterResolver(1.0));
+        out.generators.push_back(std::move(generator));
+        out.signs.push_back(r ? -1 : 1);
+    }
+    return out;
+}
+
+qubit::QubitOperator TaperOperator(const qubit::QubitOperator& ops, const Z2Symmetries& symmetries,
+                                   const std::vector<int>& sector) {
+    auto k = symmetries.qubits.size();
+    if (sector.size() != k) {
+        throw std::runtime_error("Size of sector (" + std::to_string(sector.size())
+                                 + ") should be equal to number of symmetries (" + std::to_string(k) + ").");
+    }
+    if (std::any_of(sector.begin(), sector.end(), [](int e) { return e != 1 && e != -1; })) {
+        throw std::runtime_error("Eigenvalue of symmetry in sector should be 1 or -1.");
+    }
+    size_t n_qubits = ops.count_qubits();
+    for (const auto& gate : symmetries.rotation) {
+        n_qubits = std::max(n_qubits, gate.obj + 1);
+        for (auto c : gate.ctrls) {
+            n_qubits = std::max(n_qubits, c + 1);
+        }
+    }
+    for (auto q : symmetries.qubits) {
+        n_qubits = std::max(n_qubits, q + 1);
+    }
+    //! Whether Z on a tapered qubit flips sign of term.
+    std::vector<uint8_t> flip(n_qubits, 0);
+    std::vector<uint8_t> tapered(n_qubits, 0);
+    for (size_t i = 0; i < k; i++) {
+        tapered[symmetries.qubits[i]] = 1;
+        flip[symmetries.qubits[i]] = sector[i] * symmetries.signs[i] < 0;
+    }
+    std::vector<size_t> label(n_qubits, npos);
+    for (size_t q = 0, idx = 0; q < n_qubits; q++) {
+        if (!tapered[q]) {
+            label[q] = idx++;
+        }
+    }
+
+    std::vector<term_view_t> terms;
+    terms.reserve(ops.size());
+    for (const auto& term : ops.terms) {
+        terms.push_back(term);
+    }
+    auto n_block = std::max<size_t>(1, (terms.size() + tapering_block_size - 1) / tapering_block_size);
+    std::vector<qubit::QubitOperator> partial(n_block);
+    std::vector<uint8_t> not_commute(n_block, 0);
+    for (auto& p : partial) {
+        p.dtype = ops.dtype;
+    }
+
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), static_cast<omp::idx_t>(terms.size()),
+                  tapering_omp_threshold,
+        for (omp::idx_t b = 0; b < static_cast<omp::idx_t>(n_block); b++) {
+            auto begin = static_cast<size_t>(b) * tapering_block_size;
+            auto end = std::min(terms.size(), begin + tapering_block_size);
+            bits_t x(n_qubits);
+            bits_t z(n_qubits);
+            for (auto i = begin; i < end; i++) {
+                const auto& [key, coeff] = terms[i];
+                std::fill(x.begin(), x.end(), 0);
+                std::fill(z.begin(), z.end(), 0);
+                UnpackKey(key, &x, &z);
+                uint8_t r = 0;
+                for (const auto& gate : symmetries.rotation) {
+                    ConjugatePauli(gate, &x, &z, &r);
+                }
+                for (auto q : symmetries.qubits) {
+                    not_commute[b] |= x[q];
+                    r ^= z[q] & flip[q];
+                }
+                AccumulateTerm(&partial[b], PackKey(x, z, label), coeff, r);
+            }
+        })
+    // clang-format on
+
+    if (std::any_of(not_commute.begin(), not_commute.end(), [](auto i) { return i != 0; })) {
+        throw std::runtime_error("Qubit operator does not commute with Z2 symmetries.");
+    }
+    auto& out = partial[0];
+    for (size_t b = 1; b < n_block; b++) {
+        AccumulateOperator(&out, partial[b]);
+        partial[b] = qubit::QubitOperator();
+    }
+    return std::move(out);
+}
+}  // namespace operators
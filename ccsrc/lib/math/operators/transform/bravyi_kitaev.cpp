@@ -18,35 +18,30 @@
 
 namespace operators::transform {
 qubit_op_t bravyi_kitaev(const fermion_op_t& ops, int n_qubits) {
-    auto transf_op = qubit_op_t();
-    for (const auto& [term, coeff] : ops.get_terms()) {
-        auto transformed_term = qubit_op_t("", coeff);
-        for (const auto& [idx, value] : term) {
-            auto update_set_ = update_set(idx, n_qubits);
-            auto occupation_set_ = occupation_set(idx);
-            auto parity_set_ = parity_set(idx - 1);
-            qlist_t x1(update_set_.begin(), update_set_.end());
-            qlist_t y1 = {};
-            qlist_t z1(parity_set_.begin(), parity_set_.end());
-            std::unordered_set<qubit_op_t::term_t::first_type> x2_set(update_set_);
-            x2_set.erase(idx);
-            qlist_t x2(x2_set.begin(), x2_set.end());
-            qlist_t y2 = {idx};
-            std::unordered_set<qubit_op_t::term_t::first_type> z2_set(parity_set_);
-            for (auto it = occupation_set_.begin(); it != occupation_set_.end(); it++) {
-                if (z2_set.count(*it)) {
-                    z2_set.erase(*it);
-                } else {
-                    z2_set.insert(*it);
-                }
+    return transform_fermion_operator(ops, [n_qubits](const fermion_op_t::term_t& term) {
+        const auto& [idx, value] = term;
+        auto update_set_ = update_set(idx, n_qubits);
+        auto occupation_set_ = occupation_set(idx);
+        auto parity_set_ = parity_set(idx - 1);
+        qlist_t x1(update_set_.begin(), update_set_.end());
+        qlist_t y1 = {};
+        qlist_t z1(parity_set_.begin(), parity_set_.end());
+        std::unordered_set<qubit_op_t::term_t::first_type> x2_set(update_set_);
+        x2_set.erase(idx);
+        qlist_t x2(x2_set.begin(), x2_set.end());
+        qlist_t y2 = {idx};
+        std::unordered_set<qubit_op_t::term_t::first_type> z2_set(parity_set_);
+        for (auto it = occupation_set_.begin(); it != occupation_set_.end(); it++) {
+            if (z2_set.count(*it)) {
+                z2_set.erase(*it);
+            } else {
+                z2_set.insert(*it);
             }
-            z2_set.erase(idx);
-            qlist_t z2(z2_set.begin(), z2_set.end());
-            transformed_term *= transform_ladder_operator(value, x1, y1, z1, x2, y2, z2);
         }
-        transf_op += transformed_term;
-    }
-    return transf_op;
+        z2_set.erase(idx);
+        qlist_t z2(z2_set.begin(), z2_set.end());
+        return transform_ladder_operator(value, x1, y1, z1, x2, y2, z2);
+    });
 }
 
 std::unordered_set<qubit_op_t::term_t::first_type> parity_set(qubit_op_t::term_t::first_type idx) {
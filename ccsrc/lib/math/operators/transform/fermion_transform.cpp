@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "config/openmp.h"
+
+#include "core/utils.h"
+#include "math/operators/transform.h"
+
+namespace operators::transform {
+namespace {
+//! Number of fermion terms above which terms are transformed in parallel.
+constexpr omp::idx_t transform_omp_threshold = 2048;
+//! Number of fermion terms accumulated into one partial qubit operator.
+constexpr size_t transform_block_size = 1024;
+
+//! Least recently used cache of ladder operator images.
+class LadderCache {
+ public:
+    LadderCache(const ladder_image_t& image, size_t capacity) : image(image), capacity(capacity) {
+    }
+
+    //! Image of given ladder operator, the reference is valid until next call.
+    const qubit_op_t& Get(const fermion_op_t::term_t& term) {
+        if (auto it = index.find(term); it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+        auto value = image(term);
+        if (entries.size() >= capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(term, std::move(value));
+        index.emplace(term, entries.begin());
+        return entries.front().second;
+    }
+
+ private:
+    using entry_t = std::pair<fermion_op_t::term_t, qubit_op_t>;
+
+    const ladder_image_t& image;
+    size_t capacity;
+    //! Most recently used entry first.
+    std::list<entry_t> entries;
+    std::map<fermion_op_t::term_t, std::list<entry_t>::iterator> index;
+};
+}  // namespace
+
+qubit_op_t transform_fermion_operator(const fermion_op_t& ops, const ladder_image_t& image, size_t cache_size) {
+    if (cache_size == 0) {
+        throw std::runtime_error("Cache size must be greater than zero.");
+    }
+    const auto terms = ops.get_terms();
+    auto n_terms = static_cast<omp::idx_t>(terms.size());
+    auto n_block = (terms.size() + transform_block_size - 1) / transform_block_size;
+    if (n_block == 0) {
+        return qubit_op_t();
+    }
+    std::vector<qubit_op_t> partial(n_block);
+
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel), n_terms, transform_omp_threshold,
+        {
+            auto cache = LadderCache(image, cache_size);
+            MQ_DO_PRAGMA(omp for schedule(dynamic))
+            for (omp::idx_t b = 0; b < static_cast<omp::idx_t>(n_block); b++) {
+                auto begin = static_cast<size_t>(b) * transform_block_size;
+                auto end = std::min(terms.size(), begin + transform_block_size);
+                auto& out = partial[b];
+                for (auto i = begin; i < end; i++) {
+                    const auto& [term, coeff] = terms[i];
+                    auto transformed_term = qubit_op_t("", coeff);
+                    for (const auto& ladder : term) {
+                        transformed_term *= cache.Get(ladder);
+                    }
+                    out += transformed_term;
+                }
+            }
+        })
+    // clang-format on
+
+    auto& out = partial[0];
+    for (size_t b = 1; b < n_block; b++) {
+        out += partial[b];
+        partial[b] = qubit_op_t();
+    }
+    return std::move(out);
+}
+}  // namespace operators::transform
@@ -26,24 +26,19 @@ qubit_op_t parity(const fermion_op_t& ops, int n_qubits) {
     if (n_qubits < local_n_qubits) {
         throw std::runtime_error("Target qubits number is less than local qubits of operator.");
     }
-    auto transf_op = qubit_op_t();
-    for (const auto& [term, coeff] : ops.get_terms()) {
-        auto transformed_term = qubit_op_t("", coeff);
-        for (const auto& [idx, value] : term) {
-            qlist_t x1 = {}, z1 = {}, x2 = {};
-            for (auto i = idx; i < static_cast<size_t>(n_qubits); i++) {
-                x1.push_back((i));
-            }
-            for (auto i = idx + 1; i < static_cast<size_t>(n_qubits); i++) {
-                x2.push_back((i));
-            }
-            if (idx > 0) {
-                z1.push_back(idx - 1);
-            }
-            transformed_term *= transform_ladder_operator(value, x1, {}, z1, x2, {idx}, {});
+    return transform_fermion_operator(ops, [n_qubits](const fermion_op_t::term_t& term) {
+        const auto& [idx, value] = term;
+        qlist_t x1 = {}, z1 = {}, x2 = {};
+        for (auto i = idx; i < static_cast<size_t>(n_qubits); i++) {
+            x1.push_back((i));
         }
-        transf_op += transformed_term;
-    }
-    return transf_op;
+        for (auto i = idx + 1; i < static_cast<size_t>(n_qubits); i++) {
+            x2.push_back((i));
+        }
+        if (idx > 0) {
+            z1.push_back(idx - 1);
+        }
+        return transform_ladder_operator(value, x1, {}, z1, x2, {idx}, {});
+    });
 }
 }  // namespace operators::transform
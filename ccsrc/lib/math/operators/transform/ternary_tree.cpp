@@ -20,61 +20,56 @@ namespace operators::transform {
 qubit_op_t ternary_tree(const fermion_op_t& ops, int n_qubits) {
     int h = static_cast<int>(std::floor(std::log1p(2 * n_qubits) / std::log(3)));
     int d = n_qubits - (static_cast<int>(std::round(std::pow(3, h))) - 1) / 2;
-    auto transf_op = qubit_op_t();
-    for (const auto& [term, coeff] : ops.get_terms()) {
-        auto transformed_term = qubit_op_t("", coeff);
-        for (const auto& [idx, value] : term) {
-            qlist_t p1 = {};
-            if (2 * idx < static_cast<size_t>(3 * d)) {
-                for (int k = h; k > -1; k--) {
-                    p1.push_back((2 * idx / static_cast<int>(std::round(std::pow(3, k))) % 3));
-                }
-            } else {
-                for (int k = h - 1; k > -1; k--) {
-                    p1.push_back(((2 * idx - 2 * d) / static_cast<int>(std::round(std::pow(3, k))) % 3));
-                }
+    return transform_fermion_operator(ops, [h, d](const fermion_op_t::term_t& term) {
+        const auto& [idx, value] = term;
+        qlist_t p1 = {};
+        if (2 * idx < static_cast<size_t>(3 * d)) {
+            for (int k = h; k > -1; k--) {
+                p1.push_back((2 * idx / static_cast<int>(std::round(std::pow(3, k))) % 3));
             }
-            qlist_t x1 = {};
-            qlist_t y1 = {};
-            qlist_t z1 = {};
-            for (int k = 0; k < static_cast<int>(p1.size()); k++) {
-                auto tmp = p1[k];
-                if (tmp == 0) {
-                    x1.push_back((get_qubit_index(p1, k)));
-                } else if (tmp == 1) {
-                    y1.push_back((get_qubit_index(p1, k)));
-                } else {
-                    z1.push_back((get_qubit_index(p1, k)));
-                }
+        } else {
+            for (int k = h - 1; k > -1; k--) {
+                p1.push_back(((2 * idx - 2 * d) / static_cast<int>(std::round(std::pow(3, k))) % 3));
             }
-            qlist_t p2 = {};
-            if (2 * idx < static_cast<size_t>(3 * d)) {
-                for (int k = h; k > -1; k--) {
-                    p2.push_back(((2 * idx + 1) / static_cast<int>(std::round(std::pow(3, k))) % 3));
-                }
+        }
+        qlist_t x1 = {};
+        qlist_t y1 = {};
+        qlist_t z1 = {};
+        for (int k = 0; k < static_cast<int>(p1.size()); k++) {
+            auto tmp = p1[k];
+            if (tmp == 0) {
+                x1.push_back((get_qubit_index(p1, k)));
+            } else if (tmp == 1) {
+                y1.push_back((get_qubit_index(p1, k)));
             } else {
-                for (int k = h - 1; k > -1; k--) {
-                    p2.push_back(((2 * idx + 1 - 2 * d) / static_cast<int>(std::round(std::pow(3, k))) % 3));
-                }
+                z1.push_back((get_qubit_index(p1, k)));
+            }
+        }
+        qlist_t p2 = {};
+        if (2 * idx < static_cast<size_t>(3 * d)) {
+            for (int k = h; k > -1; k--) {
+                p2.push_back(((2 * idx + 1) / static_cast<int>(std::round(std::pow(3, k))) % 3));
             }
-            qlist_t x2 = {};
-            qlist_t y2 = {};
-            qlist_t z2 = {};
-            for (int k = 0; k < static_cast<int>(p2.size()); k++) {
-                auto tmp = p2[k];
-                if (tmp == 0) {
-                    x2.push_back((get_qubit_index(p2, k)));
-                } else if (tmp == 1) {
-                    y2.push_back((get_qubit_index(p2, k)));
-                } else {
-                    z2.push_back((get_qubit_index(p2, k)));
-                }
+        } else {
+            for (int k = h - 1; k > -1; k--) {
+                p2.push_back(((2 * idx + 1 - 2 * d) / static_cast<int>(std::round(std::pow(3, k))) % 3));
             }
-            transformed_term *= transform_ladder_operator(value, x1, y1, z1, x2, y2, z2);
         }
-        transf_op += transformed_term;
-    }
-    return transf_op;
+        qlist_t x2 = {};
+        qlist_t y2 = {};
+        qlist_t z2 = {};
+        for (int k = 0; k < static_cast<int>(p2.size()); k++) {
+            auto tmp = p2[k];
+            if (tmp == 0) {
+                x2.push_back((get_qubit_index(p2, k)));
+            } else if (tmp == 1) {
+                y2.push_back((get_qubit_index(p2, k)));
+            } else {
+                z2.push_back((get_qubit_index(p2, k)));
+            }
+        }
+        return transform_ladder_operator(value, x1, y1, z1, x2, y2, z2);
+    });
 }
 
 int get_qubit_index(const qlist_t& p, int i) {
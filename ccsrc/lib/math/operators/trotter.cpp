@@ -0,0 +1,311 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "math/operators/trotter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config/openmp.h"
+
+#include "core/utils.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+
+namespace operators {
+namespace {
+//! Number of rotations above which gates are emitted in parallel.
+constexpr omp::idx_t trotter_omp_threshold = 4096;
+//! Number of rotations handled by one block.
+constexpr size_t trotter_block_size = 1024;
+constexpr double half_pi = 1.5707963267948966;
+
+using paulis_t = std::vector<std::pair<size_t, qubit::TermValue>>;
+
+//! Non identity term of the evolved operator, with pauli operators in ascending qubit order.
+struct EvolutionTerm {
+    paulis_t paulis;
+    double coeff;
+    bool native;
+};
+
+//! Rotation exp(-i angle / 2 * P) of a term P.
+struct Rotation {
+    size_t term;
+    double angle;
+};
+
+//! Compare compressed pauli keys in reflected gray code order of their qubits, from highest qubit to lowest.
+bool GrayLess(const key_t& lhs, const key_t& rhs) {
+    constexpr uint64_t odd_mask = 0x5555555555555555ULL;
+    bool reverse = false;
+    for (size_t w = std::max(lhs.size(), rhs.size()); w-- > 0;) {
+        auto a = w < lhs.size() ? lhs[w] : 0;
+        auto b = w < rhs.size() ? rhs[w] : 0;
+        if (a == b) {
+            // X and Z are the odd digits, every odd digit reflects the order of lower qubits.
+            reverse ^= mindquantum::CountOne(static_cast<uint64_t>(a & odd_mask)) & 1;
+            continue;
+        }
+        for (int shift = 62;; shift -= 2) {
+            auto da = (a >> shift) & 3;
+            auto db = (b >> shift) & 3;
+            if (da != db) {
+                return reverse ? da > db : da < db;
+            }
+            reverse ^= da & 1;
+        }
+    }
+    return false;
+}
+
+std::vector<EvolutionTerm> GatherTerms(const qubit::QubitOperator& ops, bool native) {
+    std::vector<std::pair<const key_t*, std::complex<double>>> terms;
+    terms.reserve(ops.size());
+    for (const auto& [key, coeff] : ops.terms) {
+        if (!coeff.IsConst()) {
+            throw std::runtime_error("Time evolution requires a qubit operator with constant coefficients.");
+        }
+        if (std::any_of(key.begin(), key.end(), [](auto word) { return word != 0; })) {
+            terms.emplace_back(&key, tensor::ops::cpu::to_vector<std::complex<double>>(coeff.const_value)[0]);
+        }
+    }
+    std::sort(terms.begin(), terms.end(),
+              [](const auto& lhs, const auto& rhs) { return GrayLess(*lhs.first, *rhs.first); });
+
+    std::vector<EvolutionTerm> out;
+    out.reserve(terms.size());
+    for (const auto& [key_p, value] : terms) {
+        const auto& key = *key_p;
+        if (std::abs(value.imag()) > 1e-12) {
+            throw std::runtime_error("Time evolution requires a hermitian qubit operator, but get coefficient "
+                                     + std::to_string(value.real()) + " + " + std::to_string(value.imag()) + "j.");
+        }
+        EvolutionTerm evo{{}, value.real(), false};
+        for (size_t w = 0; w < key.size(); w++) {
+            size_t q = w * 32;
+            for (auto word = key[w]; word != 0; word >>= 2, q++) {
+                if ((word & 3) != 0) {
+                    evo.paulis.emplace_back(q, static_cast<qubit::TermValue>(word & 3));
+                }
+            }
+        }
+        evo.native = native && evo.paulis.size() <= 2;
+        out.push_back(std::move(evo));
+    }
+    return out;
+}
+
+//! Append a rotation, merged with the previous one if it rotates the same term.
+void PushRotation(std::vector<Rotation>* seq, size_t term, double angle) {
+    if (!seq->empty() && seq->back().term == term) {
+        seq->back().angle += angle;
+    } else {
+        seq->push_back({term, angle});
+    }
+}
+
+//! Second order formula, forward sweep of half steps and backward sweep of half steps.
+void PushStrang(std::vector<Rotation>* seq, const std::vector<EvolutionTerm>& terms, double dt) {
+    for (size_t j = 0; j < terms.size(); j++) {
+        PushRotation(seq, j, terms[j].coeff * dt);
+    }
+    for (size_t j = terms.size(); j-- > 0;) {
+        PushRotation(seq, j, terms[j].coeff * dt);
+    }
+}
+
+//! Basis of a term on a qubit in its CNOT ladder, I for native rotations and for Z.
+qubit::TermValue LadderBasis(const EvolutionTerm* term, size_t q) {
+    if (term == nullptr || term->native) {
+        return qubit::TermValue::I;
+    }
+    auto it = std::lower_bound(term->paulis.begin(), term->paulis.end(), q,
+                               [](const auto& p, size_t qubit) { return p.first < qubit; });
+    if (it == term->paulis.end() || it->first != q || it->second == qubit::TermValue::Z) {
+        return qubit::TermValue::I;
+    }
+    return it->second;
+}
+
+//! Change ladder basis of every qubit from the one of prev to the one of next, both may be null.
+void EmitBasisChange(std::vector<EvolutionGate>* gates, const EvolutionTerm* prev, const EvolutionTerm* next) {
+    auto change = [&](size_t q) {
+        auto from = LadderBasis(prev, q);
+        auto to = LadderBasis(next, q);
+        if (from == to) {
+            return;
+        }
+        if (from == qubit::TermValue::X) {
+            gates->push_back({"H", {q}, {}, 0.0});
+        } else if (from == qubit::TermValue::Y) {
+            gates->push_back({"RX", {q}, {}, -half_pi});
+        }
+        if (to == qubit::TermValue::X) {
+            gates->push_back({"H", {q}, {}, 0.0});
+        } else if (to == qubit::TermValue::Y) {
+            gates->push_back({"RX", {q}, {}, half_pi});
+        }
+    };
+    static const paulis_t empty;
+    const auto& a = (prev == nullptr || prev->native) ? empty : prev->paulis;
+    const auto& b = (next == nullptr || next->native) ? empty : next->paulis;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (j == b.size() || (i < a.size() && a[i].first < b[j].first)) {
+            change(a[i++].first);
+        } else if (i == a.size() || b[j].first < a[i].first) {
+            change(b[j++].first);
+        } else {
+            change(a[i].first);
+            i++;
+            j++;
+        }
+    }
+}
+
+void EmitRotation(std::vector<EvolutionGate>* gates, const EvolutionTerm& term, double angle) {
+    constexpr const char* upper[4] = {"", "X", "Y", "Z"};
+    constexpr const char* lower[4] = {"", "x", "y", "z"};
+    const auto& paulis = term.paulis;
+    if (term.native && paulis.size() == 1) {
+        gates->push_back({std::string("R") + upper[static_cast<int>(paulis[0].second)], {paulis[0].first}, {}, angle});
+        return;
+    }
+    if (term.native) {
+        // Native two qubit rotations only exist for pauli pairs in ascending order, like Rxz but not Rzx.
+        auto a = paulis[0];
+        auto b = paulis[1];
+        if (a.second > b.second) {
+            std::swap(a, b);
+        }
+        auto name = std::string("R") + lower[static_cast<int>(a.second)] + lower[static_cast<int>(b.second)];
+        gates->push_back({name, {a.first, b.first}, {}, angle});
+        return;
+    }
+    for (size_t k = 0; k + 1 < paulis.size(); k++) {
+        gates->push_back({"CNOT", {paulis[k + 1].first}, {paulis[k].first}, 0.0});
+    }
+    gates->push_back({"RZ", {paulis.back().first}, {}, angle});
+    for (size_t k = paulis.size() - 1; k-- > 0;) {
+        gates->push_back({"CNOT", {paulis[k + 1].first}, {paulis[k].first}, 0.0});
+    }
+}
+
+std::vector<EvolutionGate> EmitCircuit(const std::vector<EvolutionTerm>& terms, const std::vector<Rotation>& seq) {
+    if (seq.empty()) {
+        return {};
+    }
+    auto n_block = (seq.size() + trotter_block_size - 1) / trotter_block_size;
+    std::vector<std::vector<EvolutionGate>> partial(n_block);
+
+    // clang-format off
+    THRESHOLD_OMP(MQ_DO_PRAGMA(omp parallel for schedule(dynamic)), static_cast<omp::idx_t>(seq.size()),
+                  trotter_omp_threshold,
+        for (omp::idx_t b = 0; b < static_cast<omp::idx_t>(n_block); b++) {
+            auto begin = static_cast<size_t>(b) * trotter_block_size;
+            auto end = std::min(seq.size(), begin + trotter_block_size);
+            auto& gates = partial[b];
+            for (auto i = begin; i < end; i++) {
+                const auto* prev = i == 0 ? nullptr : &terms[seq[i - 1].term];
+                EmitBasisChange(&gates, prev, &terms[seq[i].term]);
+                EmitRotation(&gates, terms[seq[i].term], seq[i].angle);
+            }
+        })
+    // clang-format on
+
+    size_t n_gates = 0;
+    for (const auto& p : partial) {
+        n_gates += p.size();
+    }
+    std::vector<EvolutionGate> out;
+    out.reserve(n_gates + 2 * terms[seq.back().term].paulis.size());
+    for (auto& p : partial) {
+        std::move(p.begin(), p.end(), std::back_inserter(out));
+        p = {};
+    }
+    EmitBasisChange(&out, &terms[seq.back().term], nullptr);
+    return out;
+}
+}  // namespace
+
+std::vector<EvolutionGate> TrotterCircuit(const qubit::QubitOperator& ops, double time, size_t steps, int order,
+                                          bool native) {
+    if (steps == 0) {
+        throw std::runtime_error("Number of trotter steps should be positive.");
+    }
+    if (order != 1 && order != 2 && order != 4) {
+        throw std::runtime_error("Trotter order should be 1, 2 or 4, but get " + std::to_string(order) + ".");
+    }
+    auto terms = GatherTerms(ops, native);
+    if (terms.empty()) {
+        return {};
+    }
+    // Angle of exp(-i c dt P) as rotation gate is 2 c dt.
+    auto dt = 2 * time / static_cast<double>(steps);
+    std::vector<Rotation> seq;
+    for (size_t s = 0; s < steps; s++) {
+        if (order == 1) {
+            for (size_t j = 0; j < terms.size(); j++) {
+                PushRotation(&seq, j, terms[j].coeff * dt);
+            }
+        } else if (order == 2) {
+            PushStrang(&seq, terms, dt / 2);
+        } else {
+            auto p = 1 / (4 - std::cbrt(4.0));
+            for (auto w : {p, p, 1 - 4 * p, p, p}) {
+                PushStrang(&seq, terms, w * dt / 2);
+            }
+        }
+    }
+    return EmitCircuit(terms, seq);
+}
+
+std::vector<EvolutionGate> QDriftCircuit(const qubit::QubitOperator& ops, double time, size_t n_samples,
+                                         uint64_t seed, bool native) {
+    if (n_samples == 0) {
+        throw std::runtime_error("Number of qDRIFT samples should be positive.");
+    }
+    auto terms = GatherTerms(ops, native);
+    std::vector<double> weights;
+    weights.reserve(terms.size());
+    double lambda = 0;
+    for (const auto& term : terms) {
+        weights.push_back(std::abs(term.coeff));
+        lambda += weights.back();
+    }
+    if (lambda == 0) {
+        return {};
+    }
+    auto angle = 2 * lambda * time / static_cast<double>(n_samples);
+    std::mt19937_64 rng(seed);
+    std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+    std::vector<Rotation> seq;
+    for (size_t s = 0; s < n_samples; s++) {
+        auto j = dist(rng);
+        PushRotation(&seq, j, terms[j].coeff < 0 ? -angle : angle);
+    }
+    return EmitCircuit(terms, seq);
+}
+}  // namespace operators
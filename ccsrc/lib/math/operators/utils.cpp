@@ -16,6 +16,12 @@
 
 #include "math/operators/utils.h"
 
+#include <algorithm>
+#include <complex>
+#include <stdexcept>
+
+#include "math/tensor/ops_cpu/memory_operator.h"
+
 namespace operators {
 bool KeyCompare::operator()(const key_t& a, const key_t& b) const {
     if (a.size() == b.size() && a.size() == 1) {
@@ -29,4 +35,392 @@ bool KeyCompare::operator()(const key_t& a, const key_t& b) const {
         return false;
     }
 }
+
+// -----------------------------------------------------------------------------
+
+namespace {
+//! Whether value has no parameter at all, parameters with zero coefficient still count.
+bool IsNumber(const value_t& value) {
+    return value.terms_.empty();
+}
+
+std::complex<double> ToNumber(const tensor::Tensor& t) {
+    switch (t.dtype) {
+        case tensor::TDtype::Float32:
+            return static_cast<const float*>(t.data)[0];
+        case tensor::TDtype::Float64:
+            return static_cast<const double*>(t.data)[0];
+        case tensor::TDtype::Complex64:
+            return static_cast<const std::complex<float>*>(t.data)[0];
+        case tensor::TDtype::Complex128:
+            return static_cast<const std::complex<double>*>(t.data)[0];
+    }
+    return 0.0;
+}
+
+//! Round c to what dtype can hold, real dtypes keep the real part like Tensor::astype.
+std::complex<double> AsDtype(const std::complex<double>& c, tensor::TDtype dtype) {
+    switch (dtype) {
+        case tensor::TDtype::Float32:
+            return static_cast<float>(c.real());
+        case tensor::TDtype::Float64:
+            return c.real();
+        case tensor::TDtype::Complex64:
+            return std::complex<float>(c);
+        case tensor::TDtype::Complex128:
+            return c;
+    }
+    return c;
+}
+
+//! 0 - c as the tensor kernels compute it, so that a zero imaginary part stays +0.
+std::complex<double> Negate(const std::complex<double>& c) {
+    return {0.0 - c.real(), 0.0 - c.imag()};
+}
+
+tensor::Tensor ToTensor(const std::complex<double>& c, tensor::TDtype dtype) {
+    auto out = tensor::ops::cpu::init(1, dtype);
+    switch (dtype) {
+        case tensor::TDtype::Float32:
+            static_cast<float*>(out.data)[0] = static_cast<float>(c.real());
+            break;
+        case tensor::TDtype::Float64:
+            static_cast<double*>(out.data)[0] = c.real();
+            break;
+        case tensor::TDtype::Complex64:
+            static_cast<std::complex<float>*>(out.data)[0] = std::complex<float>(c);
+            break;
+        case tensor::TDtype::Complex128:
+            static_cast<std::complex<double>*>(out.data)[0] = c;
+            break;
+    }
+    return out;
+}
+}  // namespace
+
+uint64_t QTerm_t::Hash(const key_t& key) {
+    uint64_t h = key.size();
+    for (auto word : key) {
+        h ^= word + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    // splitmix64 finalizer, spread the low bits that index the table.
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+size_t QTerm_t::Find(const key_t& key, uint64_t hash) const {
+    if (m_slots.empty()) {
+        return npos;
+    }
+    auto mask = m_slots.size() - 1;
+    for (auto i = hash & mask; m_slots[i] != 0; i = (i + 1) & mask) {
+        size_t pos = m_slots[i] - 1;
+        if (m_alive[pos] && m_hash[pos] == hash && m_keys[pos] == key) {
+            return pos;
+        }
+    }
+    return npos;
+}
+
+void QTerm_t::Append(const key_t& key, const value_t& value, uint64_t hash) {
+    if (!m_symbolic && !IsNumber(value)) {
+        Promote();
+    }
+    // Keep load factor, dead terms included, below 3/4.
+    if ((m_keys.size() + 1) * 4 > m_slots.size() * 3) {
+        if (n_dead * 2 > m_keys.size()) {
+            Compact();
+        } else {
+            Rehash(std::max<size_t>(16, m_slots.size() * 2));
+        }
+    }
+    auto mask = m_slots.size() - 1;
+    auto i = hash & mask;
+    while (m_slots[i] != 0) {
+        i = (i + 1) & mask;
+    }
+    m_keys.push_back(key);
+    if (m_symbolic) {
+        m_values.push_back(value);
+    } else {
+        m_coeffs.push_back(ToNumber(value.const_value));
+        m_dtypes.push_back(value.GetDtype());
+    }
+    m_hash.push_back(hash);
+    m_alive.push_back(1);
+    m_slots[i] = static_cast<uint32_t>(m_keys.size());
+}
+
+void QTerm_t::Kill(size_t pos) {
+    m_alive[pos] = 0;
+    m_keys[pos] = {};
+    if (m_symbolic) {
+        m_values[pos] = {};
+    }
+    ++n_dead;
+}
+
+void QTerm_t::Rehash(size_t n_slots) {
+    m_slots.assign(n_slots, 0);
+    auto mask = n_slots - 1;
+    for (size_t pos = 0; pos < m_keys.size(); pos++) {
+        if (!m_alive[pos]) {
+            continue;
+        }
+        auto i = m_hash[pos] & mask;
+        while (m_slots[i] != 0) {
+            i = (i + 1) & mask;
+        }
+        m_slots[i] = static_cast<uint32_t>(pos + 1);
+    }
+}
+
+void QTerm_t::Compact() {
+    size_t n = 0;
+    for (size_t pos = 0; pos < m_keys.size(); pos++) {
+        if (m_alive[pos]) {
+            if (n != pos) {
+                m_keys[n] = std::move(m_keys[pos]);
+                if (m_symbolic) {
+                    m_values[n] = std::move(m_values[pos]);
+                } else {
+                    m_coeffs[n] = m_coeffs[pos];
+                    m_dtypes[n] = m_dtypes[pos];
+                }
+                m_hash[n] = m_hash[pos];
+            }
+            ++n;
+        }
+    }
+    m_keys.resize(n);
+    if (m_symbolic) {
+        m_values.resize(n);
+    } else {
+        m_coeffs.resize(n);
+        m_dtypes.resize(n);
+    }
+    m_hash.resize(n);
+    m_alive.assign(n, 1);
+    n_dead = 0;
+    size_t n_slots = 16;
+    while ((n + 1) * 4 > n_slots * 3) {
+        n_slots <<= 1;
+    }
+    Rehash(n_slots);
+}
+
+void QTerm_t::Promote() {
+    if (m_symbolic) {
+        return;
+    }
+    m_values.reserve(m_keys.capacity());
+    for (size_t pos = 0; pos < m_keys.size(); pos++) {
+        m_values.push_back(m_alive[pos] ? Value(pos) : value_t());
+    }
+    m_symbolic = true;
+    m_coeffs = {};
+    m_dtypes = {};
+}
+
+value_t QTerm_t::Value(size_t pos) const {
+    if (m_symbolic) {
+        return m_values[pos];
+    }
+    return value_t(ToTensor(m_coeffs[pos], m_dtypes[pos]));
+}
+
+void QTerm_t::Store(size_t pos, const value_t& value) {
+    if (!m_symbolic && !IsNumber(value)) {
+        Promote();
+    }
+    if (m_symbolic) {
+        m_values[pos] = value;
+    } else {
+        m_coeffs[pos] = ToNumber(value.const_value);
+        m_dtypes[pos] = value.GetDtype();
+    }
+}
+
+void QTerm_t::insert(const key_t& key, const value_t& value) {
+    auto hash = Hash(key);
+    auto pos = Find(key, hash);
+    if (pos == npos) {
+        Append(key, value, hash);
+        return;
+    }
+    // Copy first, key and value may refer to the term that is replaced.
+    compress_term_t term{key, value};
+    Kill(pos);
+    Append(term.first, term.second, hash);
+}
+
+void QTerm_t::erase(const key_t& key) {
+    auto pos = Find(key, Hash(key));
+    if (pos == npos) {
+        return;
+    }
+    Kill(pos);
+    if (n_dead > 16 && n_dead * 2 > m_keys.size()) {
+        Compact();
+    }
+}
+
+value_t QTerm_t::at(const key_t& key) const {
+    auto pos = Find(key, Hash(key));
+    if (pos == npos) {
+        throw std::out_of_range("Term not in operator.");
+    }
+    return Value(pos);
+}
+
+void QTerm_t::set(const key_t& key, const value_t& value) {
+    auto hash = Hash(key);
+    auto pos = Find(key, hash);
+    if (pos == npos) {
+        Append(key, value, hash);
+    } else {
+        Store(pos, value);
+    }
+}
+
+void QTerm_t::accumulate(const key_t& key, const value_t& value, tensor::TDtype dtype, bool subtract) {
+    auto hash = Hash(key);
+    auto pos = Find(key, hash);
+    if (!m_symbolic && IsNumber(value)) {
+        auto c = AsDtype(ToNumber(value.const_value), dtype);
+        if (pos == npos) {
+            if (c != 0.0) {
+                Append(key, value_t(ToTensor(subtract ? Negate(c) : c, dtype)), hash);
+            }
+            return;
+        }
+        auto sum = AsDtype(subtract ? m_coeffs[pos] - c : m_coeffs[pos] + c, dtype);
+        if (sum == 0.0) {
+            erase(key);
+            return;
+        }
+        m_coeffs[pos] = sum;
+        m_dtypes[pos] = dtype;
+        return;
+    }
+    if (pos == npos) {
+        if (!value.IsNotZero()) {
+            return;
+        }
+        auto term = subtract ? value_t(tensor::ops::zeros(1, value.GetDtype())) - value : value;
+        term.CastTo(dtype);
+        if (term.IsNotZero()) {
+            Append(key, term, hash);
+        }
+        return;
+    }
+    Promote();
+    auto& found = m_values[pos];
+    found.CastTo(dtype);
+    if (subtract) {
+        found -= value;
+    } else {
+        found += value;
+    }
+    found.CastTo(dtype);
+    if (!found.IsNotZero()) {
+        erase(key);
+    }
+}
+
+void QTerm_t::accumulate(const QTerm_t& other, tensor::TDtype dtype, bool subtract) {
+    if (m_symbolic || other.m_symbolic) {
+        for (const auto& [k, v] : other) {
+            accumulate(k, v, dtype, subtract);
+        }
+        return;
+    }
+    for (size_t pos = 0; pos < other.m_keys.size(); pos++) {
+        if (!other.m_alive[pos]) {
+            continue;
+        }
+        const auto& key = other.m_keys[pos];
+        auto hash = other.m_hash[pos];
+        auto c = AsDtype(other.m_coeffs[pos], dtype);
+        auto found = Find(key, hash);
+        if (found == npos) {
+            if (c != 0.0) {
+                Append(key, value_t(ToTensor(subtract ? Negate(c) : c, dtype)), hash);
+            }
+            continue;
+        }
+        auto sum = AsDtype(subtract ? m_coeffs[found] - c : m_coeffs[found] + c, dtype);
+        if (sum == 0.0) {
+            erase(key);
+            continue;
+        }
+        m_coeffs[found] = sum;
+        m_dtypes[found] = dtype;
+    }
+}
+
+tensor::TDtype QTerm_t::upper_dtype(tensor::TDtype dtype) const {
+    for (size_t pos = 0; pos < m_keys.size(); pos++) {
+        if (m_alive[pos]) {
+            dtype = tensor::upper_type_v(dtype, m_symbolic ? m_values[pos].GetDtype() : m_dtypes[pos]);
+        }
+    }
+    return dtype;
+}
+
+void QTerm_t::cast(tensor::TDtype dtype) {
+    if (m_symbolic) {
+        for (auto& value : m_values) {
+            value.CastTo(dtype);
+        }
+        return;
+    }
+    for (size_t pos = 0; pos < m_keys.size(); pos++) {
+        m_coeffs[pos] = AsDtype(m_coeffs[pos], dtype);
+        m_dtypes[pos] = dtype;
+    }
+}
+
+void QTerm_t::erase_zeros() {
+    for (size_t pos = 0; pos < m_keys.size(); pos++) {
+        if (m_alive[pos] && !(m_symbolic ? m_values[pos].IsNotZero() : m_coeffs[pos] != 0.0)) {
+            Kill(pos);
+        }
+    }
+    if (n_dead > 16 && n_dead * 2 > m_keys.size()) {
+        Compact();
+    }
+}
+
+void QTerm_t::reserve(size_t n) {
+    m_keys.reserve(n);
+    if (m_symbolic) {
+        m_values.reserve(n);
+    } else {
+        m_coeffs.reserve(n);
+        m_dtypes.reserve(n);
+    }
+    m_hash.reserve(n);
+    m_alive.reserve(n);
+    size_t n_slots = std::max<size_t>(16, m_slots.size());
+    while ((n + 1) * 4 > n_slots * 3) {
+        n_slots <<= 1;
+    }
+    if (n_slots != m_slots.size()) {
+        Rehash(n_slots);
+    }
+}
+
+void QTerm_t::clear() {
+    m_keys.clear();
+    m_coeffs.clear();
+    m_dtypes.clear();
+    m_values.clear();
+    m_symbolic = false;
+    m_hash.clear();
+    m_alive.clear();
+    m_slots.clear();
+    n_dead = 0;
+}
 }  // namespace operators
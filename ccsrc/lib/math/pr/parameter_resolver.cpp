@@ -22,28 +22,136 @@
 #include "math/tensor/traits.h"
 
 namespace parameter {
+namespace {
+// Visit terms of two sorted term lists in order of id, fn(lhs, rhs) is called with nullptr for the missing side.
+template <typename L, typename R, typename F>
+void MergeVisit(L* lhs, R* rhs, F&& fn) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < lhs->size() || j < rhs->size()) {
+        if (j == rhs->size() || (i < lhs->size() && (*lhs)[i].id < (*rhs)[j].id)) {
+            fn(&(*lhs)[i], nullptr);
+            i++;
+        } else if (i == lhs->size() || (*rhs)[j].id < (*lhs)[i].id) {
+            fn(nullptr, &(*rhs)[j]);
+            j++;
+        } else {
+            fn(&(*lhs)[i], &(*rhs)[j]);
+            i++;
+            j++;
+        }
+    }
+}
+
+// Parameters that appear in both resolvers should have same encoder and gradient property.
+void CheckPropertyConflict(const ParameterResolver::terms_t& lhs, const ParameterResolver::terms_t& rhs) {
+    bool encoder_conflict = false;
+    bool grad_conflict = false;
+    MergeVisit(&lhs, &rhs, [&](const ParameterTerm* l, const ParameterTerm* r) {
+        if (l != nullptr && r != nullptr) {
+            encoder_conflict |= l->encoder() != r->encoder();
+            grad_conflict |= l->no_grad() != r->no_grad();
+        }
+    });
+    if (encoder_conflict) {
+        throw std::runtime_error("encoder or ansatz property of parameter conflict.");
+    }
+    if (grad_conflict) {
+        throw std::runtime_error("gradient property of parameter conflict.");
+    }
+}
+
+// Indices of terms ordered by parameter name, which is the order that user sees.
+std::vector<size_t> NameOrder(const ParameterResolver::terms_t& terms) {
+    // Look up every name once, SymbolTable::Name takes a lock.
+    std::vector<const std::string*> names(terms.size());
+    std::vector<size_t> order(terms.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        names[i] = &terms[i].name();
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return *names[a] < *names[b]; });
+    return order;
+}
+
+std::set<std::string> NamesWithFlag(const ParameterResolver::terms_t& terms, uint8_t flag, bool has_flag) {
+    std::set<std::string> out{};
+    for (auto& term : terms) {
+        if (((term.flags & flag) != 0) == has_flag) {
+            out.insert(term.name());
+        }
+    }
+    return out;
+}
+}  // namespace
+
 ParameterResolver::ParameterResolver(const tn::Tensor& const_value) : const_value(const_value) {
 }
 
 ParameterResolver::ParameterResolver(const std::string& key, const tn::Tensor& const_value, tn::TDtype dtype) {
     this->const_value = const_value.astype(dtype);
-    this->data_[key] = tn::ops::ones(1, dtype);
+    this->terms_.push_back({SymbolTable::Intern(key), tn::ops::ones(1, dtype)});
 }
 
 ParameterResolver::ParameterResolver(const std::map<std::string, tn::Tensor>& data, const tn::Tensor& const_value,
                                      tn::TDtype dtype) {
     this->const_value = const_value.astype(dtype);
+    this->terms_.reserve(data.size());
     for (auto& [k, v] : data) {
-        this->data_[k] = v.astype(dtype);
+        this->terms_.push_back({SymbolTable::Intern(k), v.astype(dtype)});
     }
+    this->SortTerms();
 }
 
+// -----------------------------------------------------------------------------
+
+const ParameterTerm* ParameterResolver::Find(symbol_t id) const {
+    auto it = std::lower_bound(this->terms_.begin(), this->terms_.end(), id,
+                               [](const ParameterTerm& term, symbol_t i) { return term.id < i; });
+    if (it == this->terms_.end() || it->id != id) {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+ParameterTerm* ParameterResolver::Find(symbol_t id) {
+    return const_cast<ParameterTerm*>(static_cast<const ParameterResolver*>(this)->Find(id));
+}
+
+const ParameterTerm* ParameterResolver::Find(const std::string& key) const {
+    symbol_t id;
+    if (!SymbolTable::Lookup(key, &id)) {
+        return nullptr;
+    }
+    return this->Find(id);
+}
+
+ParameterTerm* ParameterResolver::Find(const std::string& key) {
+    return const_cast<ParameterTerm*>(static_cast<const ParameterResolver*>(this)->Find(key));
+}
+
+ParameterTerm* ParameterResolver::FindOrInsert(symbol_t id) {
+    auto it = std::lower_bound(this->terms_.begin(), this->terms_.end(), id,
+                               [](const ParameterTerm& term, symbol_t i) { return term.id < i; });
+    if (it == this->terms_.end() || it->id != id) {
+        it = this->terms_.insert(it, {id, tn::ops::zeros(1, this->GetDtype())});
+    }
+    return &(*it);
+}
+
+void ParameterResolver::SortTerms() {
+    std::sort(this->terms_.begin(), this->terms_.end(),
+              [](const ParameterTerm& a, const ParameterTerm& b) { return a.id < b.id; });
+}
+
+// -----------------------------------------------------------------------------
+
 tn::TDtype ParameterResolver::GetDtype() const {
     return this->const_value.dtype;
 }
 
 size_t ParameterResolver::Size() const {
-    return this->data_.size();
+    return this->terms_.size();
 }
 
 void ParameterResolver::CastTo(tn::TDtype dtype) {
@@ -51,8 +159,8 @@ void ParameterResolver::CastTo(tn::TDtype dtype) {
         return;
     }
     this->const_value = tn::ops::cast_to(this->const_value, dtype);
-    for (auto& [k, v] : this->data_) {
-        v = tn::ops::cast_to(v, dtype);
+    for (auto& term : this->terms_) {
+        term.value = tn::ops::cast_to(term.value, dtype);
     }
 }
 void ParameterResolver::SetConstValue(const tn::Tensor& a) {
@@ -65,88 +173,89 @@ tn::Tensor ParameterResolver::GetConstValue() const {
 
 std::string ParameterResolver::ToString() const {
     std::string out = "ParameterResolver(dtype: " + tensor::dtype_to_string(this->const_value.dtype) + ",";
-    if (this->data_.size() == 0) {
+    if (this->terms_.size() == 0) {
         out += " const: " + tn::ops::to_string(this->const_value, true);
         out += ")";
         return out;
     }
+    auto order = NameOrder(this->terms_);
     out += "\n";
-    if (this->data_.size() == 0) {
-        out += "  data: [],\n";
-    } else {
-        out += "  data: [\n";
-        std::size_t i = 0;
-        for (auto& [k, v] : this->data_) {
-            out += "         " + k + ": " + tn::ops::to_string(v, true);
-            i += 1;
-            if (i != this->data_.size()) {
-                out += ",";
-            }
-            out += "\n";
+    out += "  data: [\n";
+    std::size_t i = 0;
+    for (auto idx : order) {
+        out += "         " + this->terms_[idx].name() + ": " + tn::ops::to_string(this->terms_[idx].value, true);
+        i += 1;
+        if (i != this->terms_.size()) {
+            out += ",";
         }
-        out += "  ],\n";
+        out += "\n";
     }
+    out += "  ],\n";
     out += "  const: " + tn::ops::to_string(this->const_value, true);
-    if (this->no_grad_parameters_.size() != 0) {
-        out += ",\n  no grad parameters: {";
+    auto flagged = [&](const std::string& title, uint8_t flag) {
+        std::string names;
         std::size_t i = 0;
-        for (auto& v : this->no_grad_parameters_) {
-            out += v;
-            i += 1;
-            if (i != this->data_.size()) {
-                out += ", ";
+        for (auto idx : order) {
+            if ((this->terms_[idx].flags & flag) == 0) {
+                continue;
             }
-        }
-        out += "}";
-    }
-    if (this->encoder_parameters_.size() != 0) {
-        out += ",\n  encoder parameters: {";
-        std::size_t i = 0;
-        for (auto& v : this->encoder_parameters_) {
-            out += v;
+            names += this->terms_[idx].name();
             i += 1;
-            if (i != this->data_.size()) {
-                out += ", ";
+            if (i != this->terms_.size()) {
+                names += ", ";
             }
         }
-        out += "}";
-    }
+        if (i != 0) {
+            out += ",\n  " + title + ": {" + names + "}";
+        }
+    };
+    flagged("no grad parameters", ParameterTerm::no_grad_flag);
+    flagged("encoder parameters", ParameterTerm::encoder_flag);
     out += "\n)";
     return out;
 }
 
 bool ParameterResolver::Contains(const std::string& key) const {
-    auto res = this->data_.find(key) != this->data_.end();
-    return res;
+    return this->Find(key) != nullptr;
 }
 
 bool ParameterResolver::NoGradContains(const std::string& key) const {
-    return this->no_grad_parameters_.find(key) != this->no_grad_parameters_.end();
+    auto term = this->Find(key);
+    return term != nullptr && term->no_grad();
 }
 
 bool ParameterResolver::EncoderContains(const std::string& key) const {
-    return this->encoder_parameters_.find(key) != this->encoder_parameters_.end();
+    auto term = this->Find(key);
+    return term != nullptr && term->encoder();
 }
 
 std::set<std::string> ParameterResolver::GetAllParameters() const {
     std::set<std::string> out{};
-    for (auto& [k, v] : this->data_) {
-        out.insert(k);
+    for (auto& term : this->terms_) {
+        out.insert(term.name());
     }
     return out;
 }
 
 std::set<std::string> ParameterResolver::GetRequiresGradParameters() const {
-    return this->GetAllParameters() - this->no_grad_parameters_;
+    return NamesWithFlag(this->terms_, ParameterTerm::no_grad_flag, false);
 }
 
 std::set<std::string> ParameterResolver::GetAnsatzParameters() const {
-    return this->GetAllParameters() - this->encoder_parameters_;
+    return NamesWithFlag(this->terms_, ParameterTerm::encoder_flag, false);
+}
+
+std::set<std::string> ParameterResolver::GetNoGradParameters() const {
+    return NamesWithFlag(this->terms_, ParameterTerm::no_grad_flag, true);
+}
+
+std::set<std::string> ParameterResolver::GetEncoderParameters() const {
+    return NamesWithFlag(this->terms_, ParameterTerm::encoder_flag, true);
 }
 
 bool ParameterResolver::IsConst() const {
-    for (auto& [k, v] : this->data_) {
-        if (!tn::ops::is_all_zero(v)) {
+    for (auto& term : this->terms_) {
+        if (!tn::ops::is_all_zero(term.value)) {
             return false;
         }
     }
@@ -157,113 +266,103 @@ bool ParameterResolver::IsNotZero() const {
     if (!tn::ops::is_all_zero(this->const_value)) {
         return true;
     }
-    for (auto& [k, v] : this->data_) {
-        if (!tn::ops::is_all_zero(v)) {
-            return true;
-        }
-    }
-    return false;
+    return !this->IsConst();
 }
+
 std::vector<std::string> ParameterResolver::subs(const ParameterResolver& other) {
     std::vector<std::string> will_pop;
     auto origin_dtype = this->GetDtype();
-    for (auto& [k, v] : this->data_) {
-        if (other.Contains(k)) {
-            this->const_value = this->const_value + v * other.data_.at(k);
-            will_pop.push_back(k);
+    terms_t remain;
+    MergeVisit(&this->terms_, &other.terms_, [&](ParameterTerm* l, const ParameterTerm* r) {
+        if (l == nullptr) {
+            return;
         }
-    }
-    if (will_pop.size() != 0) {
-        for (auto& k : will_pop) {
-            this->Pop(k);
+        if (r == nullptr) {
+            remain.push_back(std::move(*l));
+            return;
         }
+        this->const_value = this->const_value + l->value * r->value;
+        will_pop.push_back(l->name());
+    });
+    if (will_pop.size() != 0) {
+        this->terms_ = std::move(remain);
         auto new_dtype = this->GetDtype();
         if (origin_dtype != new_dtype) {
-            for (auto& [k, v] : this->data_) {
-                v = v.astype(new_dtype);
+            for (auto& term : this->terms_) {
+                term.value = term.value.astype(new_dtype);
             }
         }
+        std::sort(will_pop.begin(), will_pop.end());
     }
     return will_pop;
 }
 
 tn::Tensor ParameterResolver::GetItem(const std::string& key) const {
-    if (!this->Contains(key)) {
+    auto term = this->Find(key);
+    if (term == nullptr) {
         throw std::runtime_error("parameter " + key + " not in this parameter resolver.");
     }
-    return this->data_.at(key);
+    return term->value;
 }
 
 // -----------------------------------------------------------------------------
 
 ParameterResolver& ParameterResolver::operator+=(const ParameterResolver& rhs) {
-    if (((this->encoder_parameters_ & rhs.GetAnsatzParameters()).size() != 0)
-        || ((this->GetAnsatzParameters() & rhs.encoder_parameters_).size() != 0)) {
-        throw std::runtime_error("encoder or ansatz property of parameter conflict.");
-    }
-    if (((this->no_grad_parameters_ & rhs.GetRequiresGradParameters()).size() != 0)
-        || ((this->GetRequiresGradParameters() & rhs.no_grad_parameters_).size() != 0)) {
-        throw std::runtime_error("gradient property of parameter conflict.");
-    }
-    for (auto& [key, value] : rhs.data_) {
-        if (this->Contains(key)) {
-            this->data_[key] += value;
+    CheckPropertyConflict(this->terms_, rhs.terms_);
+    terms_t out;
+    out.reserve(this->terms_.size() + rhs.terms_.size());
+    MergeVisit(&this->terms_, &rhs.terms_, [&](ParameterTerm* l, const ParameterTerm* r) {
+        if (r == nullptr) {
+            out.push_back(std::move(*l));
+        } else if (l == nullptr) {
+            out.push_back({r->id, r->value.astype(this->GetDtype()), r->flags});
         } else {
-            this->SetItem(key, value);
-            if (rhs.EncoderContains(key)) {
-                this->encoder_parameters_.insert(key);
-            }
-            if (rhs.NoGradContains(key)) {
-                this->no_grad_parameters_.insert(key);
-            }
+            l->value += r->value;
+            out.push_back(std::move(*l));
         }
-    }
+    });
+    this->terms_ = std::move(out);
     this->const_value += rhs.const_value;
     return *this;
 }
 
 ParameterResolver& ParameterResolver::operator-=(const ParameterResolver& rhs) {
-    if (((this->encoder_parameters_ & rhs.GetAnsatzParameters()).size() != 0)
-        || ((this->GetAnsatzParameters() & rhs.encoder_parameters_).size() != 0)) {
-        throw std::runtime_error("encoder or ansatz property of parameter conflict.");
-    }
-    if (((this->no_grad_parameters_ & rhs.GetRequiresGradParameters()).size() != 0)
-        || ((this->GetRequiresGradParameters() & rhs.no_grad_parameters_).size() != 0)) {
-        throw std::runtime_error("gradient property of parameter conflict.");
-    }
-    for (auto& [key, value] : rhs.data_) {
-        if (this->Contains(key)) {
-            this->data_[key] -= value;
+    CheckPropertyConflict(this->terms_, rhs.terms_);
+    terms_t out;
+    out.reserve(this->terms_.size() + rhs.terms_.size());
+    MergeVisit(&this->terms_, &rhs.terms_, [&](ParameterTerm* l, const ParameterTerm* r) {
+        if (r == nullptr) {
+            out.push_back(std::move(*l));
+        } else if (l == nullptr) {
+            out.push_back({r->id, (static_cast<float>(0.0) - r->value).astype(this->GetDtype()), r->flags});
         } else {
-            this->SetItem(key, static_cast<float>(0.0) - value);
-            if (rhs.EncoderContains(key)) {
-                this->encoder_parameters_.insert(key);
-            }
-            if (rhs.NoGradContains(key)) {
-                this->no_grad_parameters_.insert(key);
-            }
+            l->value -= r->value;
+            out.push_back(std::move(*l));
         }
-    }
+    });
+    this->terms_ = std::move(out);
     this->const_value -= rhs.const_value;
     return *this;
 }
 
 ParameterResolver& ParameterResolver::operator*=(const ParameterResolver& rhs) {
     if (this->IsConst()) {
-        for (auto& [k, v] : rhs.data_) {
-            this->data_[k] = this->const_value * v;
-            if (!this->Contains(k)) {
-                if (rhs.EncoderContains(k)) {
-                    this->encoder_parameters_.insert(k);
-                }
-                if (rhs.NoGradContains(k)) {
-                    this->no_grad_parameters_.insert(k);
-                }
+        terms_t out;
+        out.reserve(this->terms_.size() + rhs.terms_.size());
+        MergeVisit(&this->terms_, &rhs.terms_, [&](ParameterTerm* l, const ParameterTerm* r) {
+            if (r == nullptr) {
+                out.push_back(std::move(*l));
+            } else if (l == nullptr) {
+                out.push_back({r->id, this->const_value * r->value, r->flags});
+            } else {
+                l->value = this->const_value * r->value;
+                out.push_back(std::move(*l));
             }
-        }
+        });
+        this->terms_ = std::move(out);
     } else if (rhs.IsConst()) {
-        for (auto& [k, v] : this->data_) {
-            this->data_[k] *= rhs.const_value;
+        for (auto& term : this->terms_) {
+            term.value *= rhs.const_value;
         }
     } else {
         throw std::runtime_error("Parameter resolver only support first order variable.");
@@ -280,25 +379,25 @@ ParameterResolver& ParameterResolver::operator/=(const ParameterResolver& rhs) {
     if (!rhs.IsNotZero()) {
         throw std::runtime_error("Cannot divided by zero.");
     }
-    for (auto& [k, v] : this->data_) {
-        this->data_[k] /= rhs.const_value;
+    for (auto& term : this->terms_) {
+        term.value /= rhs.const_value;
     }
     this->const_value /= rhs.const_value;
     return *this;
 }
 
 bool ParameterResolver::operator==(const ParameterResolver& value) {
-    if (this->data_.size() != value.data_.size()) {
+    if (this->terms_.size() != value.terms_.size()) {
         return false;
     }
     if (!tn::ops::all_equal_to(this->const_value, value.const_value)) {
         return false;
     }
-    for (auto& [k, v] : this->data_) {
-        if (!value.Contains(k)) {
+    for (size_t i = 0; i < this->terms_.size(); i++) {
+        if (this->terms_[i].id != value.terms_[i].id) {
             return false;
         }
-        if (!tn::ops::all_equal_to(v, this->data_[k])) {
+        if (!tn::ops::all_equal_to(this->terms_[i].value, value.terms_[i].value)) {
             return false;
         }
     }
@@ -312,8 +411,8 @@ bool ParameterResolver::operator!=(const ParameterResolver& value) {
 ParameterResolver ParameterResolver::operator-() const {
     auto out = *this;
     out.const_value = 0.0 - out.const_value;
-    for (auto& [k, v] : out.data_) {
-        v = 0.0 - v;
+    for (auto& term : out.terms_) {
+        term.value = 0.0 - term.value;
     }
     return out;
 }
@@ -373,115 +472,121 @@ ParameterResolver operator/(const ParameterResolver& lhs, const ParameterResolve
 
 std::vector<std::string> ParameterResolver::ParamsName() const {
     std::vector<std::string> out = {};
-    for (auto& [k, v] : this->data_) {
-        out.push_back(k);
+    for (auto idx : NameOrder(this->terms_)) {
+        out.push_back(this->terms_[idx].name());
     }
     return out;
 }
 
 std::vector<tn::Tensor> ParameterResolver::ParaValue() const {
     std::vector<tn::Tensor> out = {};
-    for (auto& [k, v] : this->data_) {
-        out.push_back(v);
+    for (auto idx : NameOrder(this->terms_)) {
+        out.push_back(this->terms_[idx].value);
     }
     return out;
 }
 auto ParameterResolver::ParaData() const -> data_t {
-    return this->data_;
+    data_t out;
+    for (auto& term : this->terms_) {
+        out[term.name()] = term.value;
+    }
+    return out;
 }
 
 void ParameterResolver::RequiresGrad() {
-    this->no_grad_parameters_ = {};
+    for (auto& term : this->terms_) {
+        term.flags &= ~ParameterTerm::no_grad_flag;
+    }
 }
 
 void ParameterResolver::NoGrad() {
-    this->no_grad_parameters_ = {};
-    for (auto& [k, v] : this->data_) {
-        this->no_grad_parameters_.insert(k);
+    for (auto& term : this->terms_) {
+        term.flags |= ParameterTerm::no_grad_flag;
     }
 }
 
 void ParameterResolver::RequiresGradPart(const std::vector<std::string>& names) {
     for (auto& name : names) {
-        if (this->NoGradContains(name)) {
-            this->no_grad_parameters_.erase(name);
+        if (auto term = this->Find(name); term != nullptr) {
+            term->flags &= ~ParameterTerm::no_grad_flag;
         }
     }
 }
 
 void ParameterResolver::NoGradPart(const std::vector<std::string>& names) {
     for (auto& name : names) {
-        if (this->Contains(name)) {
-            this->no_grad_parameters_.insert(name);
+        if (auto term = this->Find(name); term != nullptr) {
+            term->flags |= ParameterTerm::no_grad_flag;
         }
     }
 }
 
 void ParameterResolver::AnsatzPart(const std::vector<std::string>& names) {
     for (auto& name : names) {
-        if (this->EncoderContains(name)) {
-            this->encoder_parameters_.erase(name);
+        if (auto term = this->Find(name); term != nullptr) {
+            term->flags &= ~ParameterTerm::encoder_flag;
         }
     }
 }
 
 void ParameterResolver::EncoderPart(const std::vector<std::string>& names) {
     for (auto& name : names) {
-        if (this->Contains(name)) {
-            this->encoder_parameters_.insert(name);
+        if (auto term = this->Find(name); term != nullptr) {
+            term->flags |= ParameterTerm::encoder_flag;
         }
     }
 }
 
 void ParameterResolver::AsEncoder() {
-    for (auto& [k, v] : this->data_) {
-        this->encoder_parameters_.insert(k);
+    for (auto& term : this->terms_) {
+        term.flags |= ParameterTerm::encoder_flag;
     }
 }
 
 void ParameterResolver::AsAnsatz() {
-    this->encoder_parameters_ = {};
+    for (auto& term : this->terms_) {
+        term.flags &= ~ParameterTerm::encoder_flag;
+    }
 }
 
 void ParameterResolver::Update(const ParameterResolver& other) {
-    if (((this->encoder_parameters_ & other.GetAnsatzParameters()).size() != 0)
-        | ((this->GetAnsatzParameters() & other.encoder_parameters_).size() != 0)) {
-        throw std::runtime_error("encoder or ansatz property of parameter conflict.");
-    }
-    if (((this->no_grad_parameters_ & other.GetRequiresGradParameters()).size() != 0)
-        | ((this->GetRequiresGradParameters() & other.no_grad_parameters_).size() != 0)) {
-        throw std::runtime_error("gradient property of parameter conflict.");
-    }
-
-    for (auto& [key, value] : other.data_) {
-        if (this->Contains(key)) {
-            this->SetItem(key, value);
+    CheckPropertyConflict(this->terms_, other.terms_);
+    terms_t out;
+    out.reserve(this->terms_.size() + other.terms_.size());
+    MergeVisit(&this->terms_, &other.terms_, [&](ParameterTerm* l, const ParameterTerm* r) {
+        if (r == nullptr) {
+            out.push_back(std::move(*l));
+        } else if (l == nullptr) {
+            out.push_back({r->id, r->value.astype(this->GetDtype()), r->flags});
         } else {
-            this->SetItem(key, value);
-            if (other.EncoderContains(key)) {
-                this->encoder_parameters_.insert(key);
-            }
-            if (other.NoGradContains(key)) {
-                this->no_grad_parameters_.insert(key);
-            }
+            l->value = r->value.astype(this->GetDtype());
+            out.push_back(std::move(*l));
         }
-    }
+    });
+    this->terms_ = std::move(out);
     this->const_value = other.const_value;
 }
 
 ParameterResolver ParameterResolver::Conjugate() const {
     auto out = *this;
     out.const_value = out.const_value.conj();
-    for (auto& [k, v] : out.data_) {
-        v = v.conj();
+    for (auto& term : out.terms_) {
+        term.value = term.value.conj();
     }
     return out;
 }
 
 ParameterResolver ParameterResolver::Combination(const ParameterResolver& pr) const {
     auto c = this->const_value;
-    for (auto& [k, v] : this->data_) {
-        c += v * pr.GetItem(k);
+    size_t j = 0;
+    for (auto& term : this->terms_) {
+        while (j < pr.terms_.size() && pr.terms_[j].id < term.id) {
+            j++;
+        }
+        if (j == pr.terms_.size() || pr.terms_[j].id != term.id) {
+            throw std::runtime_error("parameter " + term.name() + " not in this parameter resolver.");
+        }
+        c += term.value * pr.terms_[j].value;
     }
     auto out = ParameterResolver();
     out.const_value = c;
@@ -490,45 +595,37 @@ ParameterResolver ParameterResolver::Combination(const ParameterResolver& pr) co
 
 ParameterResolver ParameterResolver::Real() const {
     auto out = *this;
-    out.const_value = out.const_value.real();
-    for (auto& [k, v] : out.data_) {
-        v = v.real();
-    }
+    out.KeepReal();
     return out;
 }
 
 void ParameterResolver::KeepReal() {
     this->const_value = this->const_value.real();
-    for (auto& [k, v] : this->data_) {
-        v = v.real();
+    for (auto& term : this->terms_) {
+        term.value = term.value.real();
     }
 }
 
 void ParameterResolver::KeepImag() {
     this->const_value = this->const_value.imag();
-    for (auto& [k, v] : this->data_) {
-        v = v.imag();
+    for (auto& term : this->terms_) {
+        term.value = term.value.imag();
     }
 }
 
 ParameterResolver ParameterResolver::Imag() const {
     auto out = *this;
-    out.const_value = out.const_value.imag();
-    for (auto& [k, v] : out.data_) {
-        v = v.imag();
-    }
+    out.KeepImag();
     return out;
 }
 
 tn::Tensor ParameterResolver::Pop(const std::string& key) {
-    auto out = this->GetItem(key);
-    this->data_.erase(key);
-    if (this->EncoderContains(key)) {
-        this->encoder_parameters_.erase(key);
-    }
-    if (this->NoGradContains(key)) {
-        this->no_grad_parameters_.erase(key);
+    auto term = this->Find(key);
+    if (term == nullptr) {
+        throw std::runtime_error("parameter " + key + " not in this parameter resolver.");
     }
+    auto out = std::move(term->value);
+    this->terms_.erase(this->terms_.begin() + (term - this->terms_.data()));
     return out;
 }
 
@@ -540,8 +637,8 @@ bool ParameterResolver::IsAntiHermitian() const {
     return !(*this + this->Conjugate()).IsNotZero();
 }
 
-bool ParameterResolver::HasRequireGradParams() {
-    return this->data_.size() > this->no_grad_parameters_.size();
+bool ParameterResolver::HasRequireGradParams() const {
+    return std::any_of(this->terms_.begin(), this->terms_.end(), [](const auto& term) { return !term.no_grad(); });
 }
 std::map<std::string, size_t> GetRequiresGradParameters(const std::vector<ParameterResolver>& prs) {
     std::map<std::string, size_t> title = {};
@@ -565,8 +662,10 @@ std::pair<std::map<std::string, size_t>, tensor::Matrix> Jacobi(const std::vecto
     }
     auto jacobi = tensor::ops::zeros(prs.size() * title.size());
     for (size_t i = 0; i < prs.size(); i++) {
-        for (auto& name : prs[i].GetRequiresGradParameters()) {
-            tensor::ops::cpu::set(&jacobi, prs[i].data_.at(name), i * title.size() + title.at(name));
+        for (auto& term : prs[i].terms_) {
+            if (!term.no_grad()) {
+                tensor::ops::cpu::set(&jacobi, term.value, i * title.size() + title.at(term.name()));
+            }
         }
     }
     return {title, tensor::Matrix(std::move(jacobi), prs.size(), title.size())};
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "math/pr/symbol_table.h"
+
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace parameter {
+namespace {
+struct SymbolStorage {
+    std::shared_mutex mtx;
+    std::unordered_map<std::string, symbol_t> ids;
+    // deque keeps references of names valid while growing.
+    std::deque<std::string> names;
+};
+
+SymbolStorage& GetStorage() {
+    static SymbolStorage storage;
+    return storage;
+}
+}  // namespace
+
+symbol_t SymbolTable::Intern(const std::string& name) {
+    auto& storage = GetStorage();
+    {
+        std::shared_lock lock(storage.mtx);
+        if (auto it = storage.ids.find(name); it != storage.ids.end()) {
+            return it->second;
+        }
+    }
+    std::unique_lock lock(storage.mtx);
+    if (auto it = storage.ids.find(name); it != storage.ids.end()) {
+        return it->second;
+    }
+    if (storage.names.size() >= std::numeric_limits<symbol_t>::max()) {
+        throw std::runtime_error("Too many parameter names.");
+    }
+    auto id = static_cast<symbol_t>(storage.names.size());
+    storage.names.push_back(name);
+    storage.ids.emplace(name, id);
+    return id;
+}
+
+bool SymbolTable::Lookup(const std::string& name, symbol_t* id) {
+    auto& storage = GetStorage();
+    std::shared_lock lock(storage.mtx);
+    auto it = storage.ids.find(name);
+    if (it == storage.ids.end()) {
+        return false;
+    }
+    *id = it->second;
+    return true;
+}
+
+const std::string& SymbolTable::Name(symbol_t id) {
+    auto& storage = GetStorage();
+    std::shared_lock lock(storage.mtx);
+    if (id >= storage.names.size()) {
+        throw std::runtime_error("Unknown parameter id " + std::to_string(id) + ".");
+    }
+    return storage.names[id];
+}
+}  // namespace parameter
@@ -16,6 +16,8 @@
 
 #include "math/tensor/ops/memory_operator.h"
 
+#include <cstring>
+
 #include "math/tensor/ops_cpu/memory_operator.h"
 #include "math/tensor/tensor.h"
 #include "math/tensor/traits.h"
@@ -171,84 +173,51 @@ namespace tensor {
 Tensor::~Tensor() {
     ops::destroy(this);
 }
-Tensor::Tensor(float a, TDtype dtype) {
-    auto tmp = tensor::ops::init_with_value(a).astype(dtype);
-    this->data = tmp.data;
-    this->dtype = tmp.dtype;
-    this->device = tmp.device;
-    this->dim = tmp.dim;
-    tmp.data = nullptr;
-}
-Tensor::Tensor(double a, TDtype dtype) {
-    auto tmp = tensor::ops::init_with_value(a).astype(dtype);
-    this->data = tmp.data;
-    this->dtype = tmp.dtype;
-    this->device = tmp.device;
-    this->dim = tmp.dim;
-    tmp.data = nullptr;
-}
-Tensor::Tensor(const std::complex<float>& a, TDtype dtype) {
-    auto tmp = tensor::ops::init_with_value(a).astype(dtype);
-    this->data = tmp.data;
-    this->dtype = tmp.dtype;
-    this->device = tmp.device;
-    this->dim = tmp.dim;
-    tmp.data = nullptr;
-}
-Tensor::Tensor(const std::complex<double>& a, TDtype dtype) {
-    auto tmp = tensor::ops::init_with_value(a).astype(dtype);
-    this->data = tmp.data;
-    this->dtype = tmp.dtype;
-    this->device = tmp.device;
-    this->dim = tmp.dim;
-    tmp.data = nullptr;
-}
-Tensor::Tensor(const std::vector<float>& a, TDtype dtype) {
-    auto tmp = tensor::ops::init_with_vector(a).astype(dtype);
-    this->data = tmp.data;
-    this->dtype = tmp.dtype;
-    this->device = tmp.device;
-    this->dim = tmp.dim;
-    tmp.data = nullptr;
-}
-Tensor::Tensor(const std::vector<double>& a, TDtype dtype) {
-    auto tmp = tensor::ops::init_with_vector(a).astype(dtype);
-    this->data = tmp.data;
-    this->dtype = tmp.dtype;
-    this->device = tmp.device;
-    this->dim = tmp.dim;
-    tmp.data = nullptr;
-}
-Tensor::Tensor(const std::vector<std::complex<float>>& a, TDtype dtype) {
-    auto tmp = tensor::ops::init_with_vector(a).astype(dtype);
-    this->data = tmp.data;
-    this->dtype = tmp.dtype;
-    this->device = tmp.device;
-    this->dim = tmp.dim;
-    tmp.data = nullptr;
-}
-Tensor::Tensor(const std::vector<std::complex<double>>& a, TDtype dtype) {
-    auto tmp = tensor::ops::init_with_vector(a).astype(dtype);
-    this->data = tmp.data;
-    this->dtype = tmp.dtype;
-    this->device = tmp.device;
-    this->dim = tmp.dim;
-    tmp.data = nullptr;
+Tensor::Tensor(float a, TDtype dtype) : Tensor(tensor::ops::init_with_value(a).astype(dtype)) {
+}
+Tensor::Tensor(double a, TDtype dtype) : Tensor(tensor::ops::init_with_value(a).astype(dtype)) {
+}
+Tensor::Tensor(const std::complex<float>& a, TDtype dtype) : Tensor(tensor::ops::init_with_value(a).astype(dtype)) {
+}
+Tensor::Tensor(const std::complex<double>& a, TDtype dtype) : Tensor(tensor::ops::init_with_value(a).astype(dtype)) {
+}
+Tensor::Tensor(const std::vector<float>& a, TDtype dtype) : Tensor(tensor::ops::init_with_vector(a).astype(dtype)) {
+}
+Tensor::Tensor(const std::vector<double>& a, TDtype dtype) : Tensor(tensor::ops::init_with_vector(a).astype(dtype)) {
+}
+Tensor::Tensor(const std::vector<std::complex<float>>& a, TDtype dtype)
+    : Tensor(tensor::ops::init_with_vector(a).astype(dtype)) {
+}
+Tensor::Tensor(const std::vector<std::complex<double>>& a, TDtype dtype)
+    : Tensor(tensor::ops::init_with_vector(a).astype(dtype)) {
 }
 Tensor::Tensor(TDtype dtype, TDevice device, void* data, size_t dim)
     : dtype(dtype), device(device), data(data), dim(dim) {
 }
 
-Tensor::Tensor(Tensor&& t) {
-    this->data = t.data;
+Tensor::Tensor(Tensor&& t) noexcept {
+    if (t.is_inline()) {
+        std::memcpy(this->inline_data, t.inline_data, inline_capacity);
+        this->data = this->inline_data;
+    } else {
+        this->data = t.data;
+    }
     t.data = nullptr;
     this->dim = t.dim;
     this->device = t.device;
     this->dtype = t.dtype;
 }
-Tensor& Tensor::operator=(Tensor&& t) {
+Tensor& Tensor::operator=(Tensor&& t) noexcept {
+    if (this == &t) {
+        return *this;
+    }
     ops::destroy(this);
-    this->data = t.data;
+    if (t.is_inline()) {
+        std::memcpy(this->inline_data, t.inline_data, inline_capacity);
+        this->data = this->inline_data;
+    } else {
+        this->data = t.data;
+    }
     t.data = nullptr;
     this->dim = t.dim;
     this->device = t.device;
@@ -256,9 +225,17 @@ Tensor& Tensor::operator=(Tensor&& t) {
     return *this;
 }
 Tensor& Tensor::operator=(const Tensor& t) {
+    if (this == &t) {
+        return *this;
+    }
     ops::destroy(this);
     if (t.device == TDevice::CPU) {
-        this->data = ops::cpu::copy_mem(t.data, t.dtype, t.dim);
+        if (t.data != nullptr && t.dim != 0) {
+            ops::cpu::allocate(this, t.dim * bit_size(t.dtype));
+            std::memcpy(this->data, t.data, t.dim * bit_size(t.dtype));
+        } else {
+            this->data = ops::cpu::copy_mem(t.data, t.dtype, t.dim);
+        }
     } else {
     }
     this->device = t.device;
@@ -269,7 +246,12 @@ Tensor& Tensor::operator=(const Tensor& t) {
 
 Tensor::Tensor(const Tensor& t) {
     if (t.device == TDevice::CPU) {
-        this->data = ops::cpu::copy_mem(t.data, t.dtype, t.dim);
+        if (t.data != nullptr && t.dim != 0) {
+            ops::cpu::allocate(this, t.dim * bit_size(t.dtype));
+            std::memcpy(this->data, t.data, t.dim * bit_size(t.dtype));
+        } else {
+            this->data = ops::cpu::copy_mem(t.data, t.dtype, t.dim);
+        }
     } else {
     }
     this->device = t.device;
@@ -16,10 +16,17 @@
 
 #include "math/tensor/ops_cpu/concrete_tensor.h"
 
+#include <cstring>
+
 #include "math/tensor/traits.h"
 
 namespace tensor::ops::cpu {
 Tensor zeros(size_t len, TDtype dtype) {
+    if (Tensor::fits_inline(len, dtype)) {
+        auto out = cpu::init(len, dtype);
+        std::memset(out.data, 0, len * bit_size(dtype));
+        return out;
+    }
     auto data = reinterpret_cast<void*>(calloc(len, bit_size(dtype)));
     return {dtype, TDevice::CPU, data, len};
 }
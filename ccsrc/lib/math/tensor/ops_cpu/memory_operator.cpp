@@ -93,9 +93,22 @@ std::string to_string(const Tensor& t, bool simplify) {
 }
 
 // -----------------------------------------------------------------------------
+void allocate(Tensor* t, size_t bytes) {
+    if (bytes <= Tensor::inline_capacity) {
+        t->data = t->inline_data;
+        return;
+    }
+    t->data = malloc(bytes);
+    if (t->data == nullptr) {
+        throw std::runtime_error("malloc memory error.");
+    }
+}
+
 void destroy(Tensor* t) {
     if (t->data != nullptr) {
-        free(t->data);
+        if (!t->is_inline()) {
+            free(t->data);
+        }
         t->data = nullptr;
         t->dim = 0;
     }
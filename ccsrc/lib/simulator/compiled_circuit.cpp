@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2022. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulator/compiled_circuit.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "math/tensor/ops_cpu/memory_operator.h"
+
+namespace mindquantum::sim {
+namespace {
+double RealValue(const tensor::Tensor &t) {
+    return tensor::ops::cpu::to_vector<double>(t)[0];
+}
+}  // namespace
+
+bool IsParameterizable(GateID id) {
+    switch (id) {
+        case GateID::RX:
+        case GateID::RY:
+        case GateID::RZ:
+        case GateID::Rxx:
+        case GateID::Ryy:
+        case GateID::Rzz:
+        case GateID::Rxy:
+        case GateID::Rxz:
+        case GateID::Ryz:
+        case GateID::Rn:
+        case GateID::SWAPalpha:
+        case GateID::GP:
+        case GateID::PS:
+        case GateID::U3:
+        case GateID::FSim:
+        case GateID::CUSTOM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+VT<double> GateParameters(const std::shared_ptr<BasicGate> &gate, const parameter::ParameterResolver &pr) {
+    auto g = static_cast<Parameterizable *>(gate.get());
+    VT<double> out;
+    out.reserve(g->prs_.size());
+    for (const auto &p : g->prs_) {
+        out.push_back(RealValue(p.Combination(pr).const_value));
+    }
+    return out;
+}
+
+CompiledCircuit::CompiledCircuit(const std::vector<std::shared_ptr<BasicGate>> &circ, const VS &names)
+    : names_(names) {
+    for (size_t i = 0; i < names_.size(); i++) {
+        columns_[names_[i]] = i;
+    }
+    gate_rows_.reserve(circ.size());
+    for (const auto &gate : circ) {
+        if (!IsParameterizable(gate->id_)) {
+            gate_rows_.push_back(npos);
+            continue;
+        }
+        gate_rows_.push_back(offset_.size());
+        auto g = static_cast<Parameterizable *>(gate.get());
+        for (const auto &p : g->prs_) {
+            offset_.push_back(RealValue(p.const_value));
+            for (const auto &term : p.terms_) {
+                auto [it, inserted] = columns_.emplace(term.name(), names_.size());
+                if (inserted) {
+                    names_.push_back(term.name());
+                }
+                col_idx_.push_back(it->second);
+                coeff_.push_back(RealValue(term.value));
+            }
+            row_ptr_.push_back(col_idx_.size());
+        }
+    }
+}
+
+VT<double> CompiledCircuit::Bind(const VT<double> &x) const {
+    if (x.size() != names_.size()) {
+        throw std::invalid_argument("Compiled circuit requires " + std::to_string(names_.size())
+                                    + " parameters, but get " + std::to_string(x.size()) + ".");
+    }
+    VT<double> out = offset_;
+    for (size_t row = 0; row < out.size(); row++) {
+        for (size_t k = row_ptr_[row]; k < row_ptr_[row + 1]; k++) {
+            out[row] += coeff_[k] * x[col_idx_[k]];
+        }
+    }
+    return out;
+}
+
+CompiledJacobian::CompiledJacobian(const std::vector<std::shared_ptr<BasicGate>> &circ, const MST<size_t> &p_map) {
+    gate_ptr_.reserve(circ.size() + 1);
+    for (const auto &gate : circ) {
+        if (IsParameterizable(gate->id_) && gate->GradRequired()) {
+            auto g = static_cast<Parameterizable *>(gate.get());
+            for (size_t row = 0; row < g->prs_.size(); row++) {
+                for (const auto &term : g->prs_[row].terms_) {
+                    if (!term.no_grad()) {
+                        auto coeff = tensor::ops::cpu::to_vector<std::complex<double>>(term.value)[0];
+                        entries_.push_back({row, p_map.at(term.name()), coeff});
+                    }
+                }
+            }
+        }
+        gate_ptr_.push_back(entries_.size());
+    }
+}
+
+VT<double> CompiledCircuit::Values(const parameter::ParameterResolver &pr) const {
+    VT<double> x(names_.size());
+    for (size_t i = 0; i < names_.size(); i++) {
+        x[i] = RealValue(pr.GetItem(names_[i]));
+    }
+    return x;
+}
+}  // namespace mindquantum::sim
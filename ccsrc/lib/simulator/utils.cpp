@@ -16,8 +16,15 @@
 
 #include "simulator/utils.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <numeric>
+#include <stdexcept>
+
+#include "core/utils.h"
 
 namespace mindquantum::sim {
 index_t QIndexToMask(qbits_t objs) {
@@ -72,4 +79,380 @@ DoubleQubitGateMask::DoubleQubitGateMask(const qbits_t &obj_qubits, const qbits_
     obj_rev_low_mask = ~obj_low_mask;
     obj_rev_high_mask = ~obj_high_mask;
 }
+
+VVT<double> SymTridiagEigen(VT<double> *diag, VT<double> off) {
+    auto &d = *diag;
+    size_t n = d.size();
+    VVT<double> z(n, VT<double>(n, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        z[i][i] = 1.0;
+    }
+    off.resize(n, 0.0);
+    if (n != 0) {
+        off[n - 1] = 0.0;
+    }
+    constexpr int max_iter = 60;
+    for (size_t l = 0; l < n; l++) {
+        int iter = 0;
+        size_t m = l;
+        do {
+            for (m = l; m + 1 < n; m++) {
+                double dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                if (std::abs(off[m]) <= std::numeric_limits<double>::epsilon() * dd) {
+                    break;
+                }
+            }
+            if (m == l) {
+                break;
+            }
+            if (iter++ == max_iter) {
+                throw std::runtime_error("Eigen decomposition of tridiagonal matrix not converged.");
+            }
+            double g = (d[l + 1] - d[l]) / (2.0 * off[l]);
+            double r = std::hypot(g, 1.0);
+            g = d[m] - d[l] + off[l] / (g + std::copysign(r, g));
+            double s = 1.0;
+            double c = 1.0;
+            double p = 0.0;
+            bool deflated = false;
+            for (size_t i = m; i-- > l;) {
+                double f = s * off[i];
+                double b = c * off[i];
+                r = std::hypot(f, g);
+                off[i + 1] = r;
+                if (r == 0.0) {
+                    d[i + 1] -= p;
+                    off[m] = 0.0;
+                    deflated = true;
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = d[i + 1] - p;
+                r = (d[i] - g) * s + 2.0 * c * b;
+                p = s * r;
+                d[i + 1] = g + p;
+                g = c * r - b;
+                for (size_t k = 0; k < n; k++) {
+                    f = z[k][i + 1];
+                    z[k][i + 1] = s * z[k][i] + c * f;
+                    z[k][i] = c * z[k][i] - s * f;
+                }
+            }
+            if (!deflated) {
+                d[l] -= p;
+                off[l] = g;
+                off[m] = 0.0;
+            }
+        } while (true);
+    }
+    VT<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return d[i] < d[j]; });
+    VT<double> sorted_d(n);
+    VVT<double> sorted_z(n, VT<double>(n));
+    for (size_t j = 0; j < n; j++) {
+        sorted_d[j] = d[order[j]];
+        for (size_t i = 0; i < n; i++) {
+            sorted_z[i][j] = z[i][order[j]];
+        }
+    }
+    d = sorted_d;
+    return sorted_z;
+}
+
+VT<std::complex<double>> TridiagExpDotE0(const VT<double> &diag, const VT<double> &off, double t) {
+    auto eig_val = diag;
+    auto eig_vec = SymTridiagEigen(&eig_val, off);
+    size_t n = eig_val.size();
+    VT<std::complex<double>> out(n, 0.0);
+    for (size_t j = 0; j < n; j++) {
+        auto phase = eig_vec[0][j] * std::polar(1.0, -eig_val[j] * t);
+        for (size_t i = 0; i < n; i++) {
+            out[i] += eig_vec[i][j] * phase;
+        }
+    }
+    return out;
+}
+
+VVT<double> SymEigen(VVT<double> mat, VT<double> *eig_val) {
+    size_t n = mat.size();
+    VVT<double> z(n, VT<double>(n, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        z[i][i] = 1.0;
+        for (size_t j = 0; j < i; j++) {
+            mat[i][j] = mat[j][i];
+        }
+    }
+    constexpr int max_sweep = 100;
+    for (int sweep = 0;; sweep++) {
+        double off_norm = 0.0;
+        double total_norm = 0.0;
+        for (size_t p = 0; p < n; p++) {
+            total_norm += mat[p][p] * mat[p][p];
+            for (size_t q = p + 1; q < n; q++) {
+                off_norm += 2 * mat[p][q] * mat[p][q];
+            }
+        }
+        total_norm += off_norm;
+        if (off_norm <= std::numeric_limits<double>::epsilon() * std::numeric_limits<double>::epsilon() * total_norm) {
+            break;
+        }
+        if (sweep == max_sweep) {
+            throw std::runtime_error("Eigen decomposition of symmetric matrix not converged.");
+        }
+        for (size_t p = 0; p < n; p++) {
+            for (size_t q = p + 1; q < n; q++) {
+                if (mat[p][q] == 0.0) {
+                    continue;
+                }
+                double theta = (mat[q][q] - mat[p][p]) / (2.0 * mat[p][q]);
+                double t = std::copysign(1.0, theta) / (std::abs(theta) + std::hypot(theta, 1.0));
+                double c = 1.0 / std::hypot(t, 1.0);
+                double s = t * c;
+                for (size_t k = 0; k < n; k++) {
+                    double a_kp = mat[k][p];
+                    double a_kq = mat[k][q];
+                    mat[k][p] = c * a_kp - s * a_kq;
+                    mat[k][q] = s * a_kp + c * a_kq;
+                }
+                for (size_t k = 0; k < n; k++) {
+                    double a_pk = mat[p][k];
+                    double a_qk = mat[q][k];
+                    mat[p][k] = c * a_pk - s * a_qk;
+                    mat[q][k] = s * a_pk + c * a_qk;
+                }
+                for (size_t k = 0; k < n; k++) {
+                    double z_kp = z[k][p];
+                    double z_kq = z[k][q];
+                    z[k][p] = c * z_kp - s * z_kq;
+                    z[k][q] = s * z_kp + c * z_kq;
+                }
+            }
+        }
+    }
+    VT<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return mat[i][i] < mat[j][j]; });
+    eig_val->resize(n);
+    VVT<double> sorted_z(n, VT<double>(n));
+    for (size_t j = 0; j < n; j++) {
+        (*eig_val)[j] = mat[order[j]][order[j]];
+        for (size_t i = 0; i < n; i++) {
+            sorted_z[i][j] = z[i][order[j]];
+        }
+    }
+    return sorted_z;
+}
+
+namespace {
+struct ZZTerm {
+    index_t mask;
+    double coeff;
+};
+
+inline double ZZSign(index_t bits, index_t mask) {
+    return (CountOne(bits & mask) & 1) ? -1.0 : 1.0;
+}
+
+//! Lowest energy and the bitstrings that reach it, found in one branch of the search.
+struct ZZSearchResult {
+    double energy = std::numeric_limits<double>::max();
+    VT<index_t> states;
+};
+
+class ZZGroundStateSearch {
+ public:
+    ZZGroundStateSearch(const VT<index_t>& masks, const VT<double>& coeffs, qbit_t n_qubits, size_t max_n_states)
+        : max_n_states_(max_n_states) {
+        if (masks.size() != coeffs.size()) {
+            throw std::invalid_argument("Size of masks and coeffs not match.");
+        }
+        constexpr auto n_mask_bits = static_cast<qbit_t>(std::numeric_limits<index_t>::digits);
+        if (n_qubits > n_mask_bits) {
+            throw std::invalid_argument("Qubit number of ZZ terms exceeds the bit width of mask.");
+        }
+        VT<double> weight(n_qubits, 0.0);
+        double total = 0.0;
+        VT<ZZTerm> terms;
+        for (size_t i = 0; i < masks.size(); i++) {
+            // Shifting by the full bit width is undefined, every mask fits when all bits are qubits.
+            if (n_qubits < n_mask_bits && (masks[i] >> n_qubits) != 0) {
+                throw std::invalid_argument("Mask of ZZ term exceeds qubit number.");
+            }
+            if (masks[i] == 0) {
+                const_energy_ += coeffs[i];
+                continue;
+            }
+            terms.push_back({masks[i], coeffs[i]});
+            total += std::abs(coeffs[i]);
+            for (qbit_t q = 0; q < n_qubits; q++) {
+                if ((masks[i] >> q) & 1) {
+                    weight[q] += std::abs(coeffs[i]);
+                }
+            }
+        }
+        tol_ = 1e-10 * std::max(1.0, total + std::abs(const_energy_));
+
+        // Heavy qubits are branched first for early pruning, the lightest qubit flips most often in Gray code.
+        VT<qbit_t> order(n_qubits);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](qbit_t a, qbit_t b) { return weight[a] > weight[b]; });
+        qbit_t n_gray = n_qubits <= 16 ? n_qubits : std::clamp<qbit_t>(n_qubits - 6, 16, 20);
+        n_branch_ = n_qubits - n_gray;
+        branch_qubits_.assign(order.begin(), order.begin() + n_branch_);
+        gray_qubits_.assign(order.rbegin(), order.rbegin() + n_gray);
+
+        index_t gray_mask = 0;
+        for (auto q : gray_qubits_) {
+            gray_mask |= static_cast<index_t>(1) << q;
+        }
+        VT<size_t> pos(n_qubits, 0);
+        for (size_t d = 0; d < branch_qubits_.size(); d++) {
+            pos[branch_qubits_[d]] = d;
+        }
+        terms_at_depth_.resize(n_branch_);
+        rest_bound_.assign(n_branch_ + 1, 0.0);
+        gray_terms_of_.resize(n_gray);
+        for (auto& term : terms) {
+            if ((term.mask & gray_mask) != 0) {
+                for (size_t g = 0; g < gray_qubits_.size(); g++) {
+                    if ((term.mask >> gray_qubits_[g]) & 1) {
+                        gray_terms_of_[g].push_back(gray_terms_.size());
+                    }
+                }
+                gray_terms_.push_back(term);
+                rest_bound_[n_branch_] -= std::abs(term.coeff);
+                continue;
+            }
+            size_t depth = 0;
+            for (qbit_t q = 0; q < n_qubits; q++) {
+                if ((term.mask >> q) & 1) {
+                    depth = std::max(depth, pos[q]);
+                }
+            }
+            terms_at_depth_[depth].push_back(term);
+            rest_bound_[depth] -= std::abs(term.coeff);
+        }
+        for (size_t d = n_branch_; d-- > 0;) {
+            rest_bound_[d] += rest_bound_[d + 1];
+        }
+    }
+
+    std::pair<double, VT<index_t>> Solve() {
+        size_t n_prefix = std::min<size_t>(n_branch_, 10);
+        auto n_task = static_cast<omp::idx_t>(static_cast<index_t>(1) << n_prefix);
+        VT<ZZSearchResult> results(n_task);
+        MQ_DO_PRAGMA(omp parallel for schedule(dynamic))
+        for (omp::idx_t task = 0; task < n_task; task++) {
+            index_t assign = 0;
+            double energy = const_energy_;
+            bool pruned = false;
+            for (size_t d = 0; d < n_prefix && !pruned; d++) {
+                if ((static_cast<index_t>(task) >> d) & 1) {
+                    assign |= static_cast<index_t>(1) << branch_qubits_[d];
+                }
+                energy += DepthEnergy(d, assign);
+                pruned = Prunable(d + 1, energy);
+            }
+            if (!pruned) {
+                Branch(n_prefix, assign, energy, &results[task]);
+            }
+        }
+        double energy = best_.load();
+        VT<index_t> states;
+        for (auto& res : results) {
+            if (res.energy <= energy + tol_) {
+                states.insert(states.end(), res.states.begin(), res.states.end());
+            }
+        }
+        std::sort(states.begin(), states.end());
+        if (states.size() > max_n_states_) {
+            states.resize(max_n_states_);
+        }
+        return {energy, states};
+    }
+
+ private:
+    double DepthEnergy(size_t depth, index_t assign) const {
+        double energy = 0.0;
+        for (auto& term : terms_at_depth_[depth]) {
+            energy += term.coeff * ZZSign(assign, term.mask);
+        }
+        return energy;
+    }
+
+    bool Prunable(size_t depth, double energy) const {
+        return energy + rest_bound_[depth] > best_.load(std::memory_order_relaxed) + tol_;
+    }
+
+    void Branch(size_t depth, index_t assign, double energy, ZZSearchResult* res) {
+        if (Prunable(depth, energy)) {
+            return;
+        }
+        if (depth == n_branch_) {
+            Sweep(assign, energy, res);
+            return;
+        }
+        for (index_t bit = 0; bit < 2; bit++) {
+            auto next = assign | (bit << branch_qubits_[depth]);
+            Branch(depth + 1, next, energy + DepthEnergy(depth, next), res);
+        }
+    }
+
+    void Sweep(index_t assign, double energy, ZZSearchResult* res) {
+        VT<double> value(gray_terms_.size());
+        for (size_t t = 0; t < gray_terms_.size(); t++) {
+            value[t] = gray_terms_[t].coeff * ZZSign(assign, gray_terms_[t].mask);
+            energy += value[t];
+        }
+        Record(energy, assign, res);
+        index_t n_step = static_cast<index_t>(1) << gray_qubits_.size();
+        for (index_t i = 1; i < n_step; i++) {
+            // Number of trailing zeros of i, which is the qubit to flip in Gray-code order.
+            auto g = static_cast<size_t>(CountOne(i ^ (i - 1)) - 1);
+            assign ^= static_cast<index_t>(1) << gray_qubits_[g];
+            for (auto t : gray_terms_of_[g]) {
+                energy -= 2 * value[t];
+                value[t] = -value[t];
+            }
+            Record(energy, assign, res);
+        }
+    }
+
+    void Record(double energy, index_t state, ZZSearchResult* res) {
+        if (energy > res->energy + tol_) {
+            return;
+        }
+        if (energy < res->energy - tol_) {
+            res->states.clear();
+            auto best = best_.load(std::memory_order_relaxed);
+            while (energy < best && !best_.compare_exchange_weak(best, energy)) {
+            }
+        }
+        res->energy = std::min(res->energy, energy);
+        if (res->states.size() < max_n_states_) {
+            res->states.push_back(state);
+        }
+    }
+
+    size_t max_n_states_;
+    double const_energy_ = 0.0;
+    double tol_ = 0.0;
+    size_t n_branch_ = 0;
+    VT<qbit_t> branch_qubits_;
+    VT<qbit_t> gray_qubits_;
+    VVT<ZZTerm> terms_at_depth_;
+    VT<double> rest_bound_;
+    VT<ZZTerm> gray_terms_;
+    VVT<size_t> gray_terms_of_;
+    std::atomic<double> best_ = std::numeric_limits<double>::max();
+};
+}  // namespace
+
+std::pair<double, VT<index_t>> GroundStatesOfZZMasks(const VT<index_t> &masks, const VT<double> &coeffs,
+                                                     qbit_t n_qubits, size_t max_n_states) {
+    ZZGroundStateSearch search(masks, coeffs, n_qubits, max_n_states);
+    return search.Solve();
+}
 }  // namespace mindquantum::sim
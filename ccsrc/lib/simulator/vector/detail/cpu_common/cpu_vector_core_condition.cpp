@@ -89,6 +89,22 @@ void CPUVectorPolicyBase<derived_, calc_type_>::QSMulValue(const qs_data_p_t& sr
                                                            index_t dim) {
     derived::template ConditionalBinary<0, 0>(src, des_p, value, 0, dim, std::multiplies<qs_data_t>());
 }
+template <typename derived_, typename calc_type_>
+void CPUVectorPolicyBase<derived_, calc_type_>::QSAxpy(const qs_data_p_t& src, qs_data_p_t* des_p, qs_data_t value,
+                                                       index_t dim) {
+    // des = des + value * src
+    auto& des = *des_p;
+    if (des == nullptr) {
+        des = derived::InitState(dim);
+    }
+    if (src == nullptr) {
+        des[0] += value;
+        return;
+    }
+    THRESHOLD_OMP_FOR(
+        dim, DimTh, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) { des[i] += value * src[i]; })
+}
+
 template <typename derived_, typename calc_type_>
 void CPUVectorPolicyBase<derived_, calc_type_>::ConditionalAdd(const qs_data_p_t& src, qs_data_p_t* des_p, index_t mask,
                                                                index_t condi, qs_data_t succ_coeff,
@@ -122,15 +138,9 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ConditionalCollect(const qs_data
     // collect amplitude with index mask satisfied condition.
     calc_type res_real = 0, res_imag = 0;
     if (qs == nullptr) {
-        if (abs) {
-            if ((0 & mask) == condi) {
-                res_real += qs[0].real() * qs[0].real() + qs[0].imag() * qs[0].imag();
-            }
-        } else {
-            if ((0 & mask) == condi) {
-                res_real += qs[0].real();
-                res_imag += qs[0].imag();
-            }
+        // zero state, only the first amplitude is one.
+        if ((0 & mask) == condi) {
+            res_real = 1.0;
         }
         return qs_data_t(res_real, res_imag);
     }
@@ -131,7 +131,25 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ZeroStateVdot(const qs_data_p_t&
 
 template <typename derived_, typename calc_type_>
 auto CPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
-                                                          const qs_data_p_t& vec_out, index_t dim) -> qs_data_p_t {
+                                                          const qs_data_p_t& vec, index_t dim) -> qs_data_p_t {
+    qs_data_p_t out = nullptr;
+    derived::CsrDotVec(a, vec, &out, dim);
+    return out;
+}
+
+template <typename derived_, typename calc_type_>
+auto CPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
+                                                          const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& b,
+                                                          const qs_data_p_t& vec, index_t dim) -> qs_data_p_t {
+    qs_data_p_t out = nullptr;
+    derived::CsrDotVec(a, b, vec, &out, dim);
+    return out;
+}
+
+template <typename derived_, typename calc_type_>
+void CPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
+                                                          const qs_data_p_t& vec_out, qs_data_p_t* out_p,
+                                                          index_t dim) {
     if (dim != a->dim_) {
         throw std::runtime_error("Sparse hamiltonian size not match with quantum state size.");
     }
@@ -141,17 +159,21 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<
         vec = derived::InitState(dim);
         will_free = true;
     }
-    auto out = sparse::Csr_Dot_Vec<calc_type, calc_type>(a, reinterpret_cast<calc_type*>(vec));
+    auto& out = (*out_p);
+    if (out == nullptr) {
+        out = derived::InitState(dim, false);
+    }
+    sparse::Csr_Dot_Vec<calc_type, calc_type>(a, reinterpret_cast<calc_type*>(vec), reinterpret_cast<calc_type*>(out));
     if (will_free) {
         derived::FreeState(&vec);
     }
-    return reinterpret_cast<qs_data_p_t>(out);
 }
 
 template <typename derived_, typename calc_type_>
-auto CPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
+void CPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
                                                           const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& b,
-                                                          const qs_data_p_t& vec_out, index_t dim) -> qs_data_p_t {
+                                                          const qs_data_p_t& vec_out, qs_data_p_t* out_p,
+                                                          index_t dim) {
     if ((dim != a->dim_) || (dim != b->dim_)) {
         throw std::runtime_error("Sparse hamiltonian size not match with quantum state size.");
     }
@@ -159,12 +181,17 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<
     bool will_free = false;
     if (vec == nullptr) {
         vec = derived::InitState(dim);
+        will_free = true;
+    }
+    auto& out = (*out_p);
+    if (out == nullptr) {
+        out = derived::InitState(dim, false);
     }
-    auto out = sparse::Csr_Dot_Vec<calc_type, calc_type>(a, b, reinterpret_cast<calc_type*>(vec));
+    sparse::Csr_Dot_Vec<calc_type, calc_type>(a, b, reinterpret_cast<calc_type*>(vec),
+                                              reinterpret_cast<calc_type*>(out));
     if (will_free) {
         derived::FreeState(&vec);
     }
-    return reinterpret_cast<qs_data_p_t>(out);
 }
 
 template <typename derived_, typename calc_type_>
@@ -133,11 +133,25 @@ template <typename derived_, typename calc_type_>
 auto CPUVectorPolicyBase<derived_, calc_type_>::ApplyTerms(qs_data_p_t* qs_p,
                                                            const std::vector<PauliTerm<calc_type>>& ham, index_t dim)
     -> qs_data_p_t {
+    qs_data_p_t out = nullptr;
+    derived::ApplyTerms(qs_p, &out, ham, dim);
+    return out;
+}
+
+template <typename derived_, typename calc_type_>
+void CPUVectorPolicyBase<derived_, calc_type_>::ApplyTerms(qs_data_p_t* qs_p, qs_data_p_t* out_p,
+                                                           const std::vector<PauliTerm<calc_type>>& ham, index_t dim) {
     auto& qs = (*qs_p);
     if (qs == nullptr) {
         qs = derived::InitState(dim);
     }
-    qs_data_p_t out = derived::InitState(dim, false);
+    auto& out = (*out_p);
+    if (out == nullptr) {
+        out = derived::InitState(dim, false);
+    } else {
+        THRESHOLD_OMP_FOR(
+            dim, DimTh, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) { out[i] = 0; })
+    }
     for (const auto& [pauli_string, coeff_] : ham) {
         auto mask = GenPauliMask(pauli_string);
         auto mask_f = mask.mask_x | mask.mask_y;
@@ -157,8 +171,7 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ApplyTerms(qs_data_p_t* qs_p,
                 }
             })
     }
-    return out;
-};
+}
 
 template <typename derived_, typename calc_type_>
 auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfTerms(const qs_data_p_t& bra_out,
@@ -212,25 +225,86 @@ auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfTerms(const qs_data
     return out;
 }
 
+template <typename derived_, typename calc_type_>
+void CPUVectorPolicyBase<derived_, calc_type_>::ApplyDiagonal(qs_data_p_t* qs_p,
+                                                              const VT<std::pair<index_t, calc_type>>& terms,
+                                                              const DiagonalEnergy<calc_type>& energy, index_t dim) {
+    auto& qs = (*qs_p);
+    if (qs == nullptr) {
+        qs = derived::InitState(dim);
+    }
+    if (energy.Cached()) {
+        auto e = energy.Table().data();
+        THRESHOLD_OMP_FOR(
+            dim, DimTh, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) { qs[i] *= e[energy.Pack(i)]; })
+        return;
+    }
+    THRESHOLD_OMP_FOR(
+        dim, DimTh, for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) {
+            calc_type e = 0;
+            for (const auto& [mask, coeff] : terms) {
+                e += (CountOne(i & mask) & 1) ? -coeff : coeff;
+            }
+            qs[i] *= e;
+        })
+}
+
+template <typename derived_, typename calc_type_>
+auto CPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfDiagonal(const qs_data_p_t& bra, const qs_data_p_t& ket,
+                                                                      const VT<std::pair<index_t, calc_type>>& terms,
+                                                                      const DiagonalEnergy<calc_type>& energy, index_t dim)
+    -> py_qs_data_t {
+    if (bra == nullptr || ket == nullptr) {
+        // Energy of |0> is the sum of all coefficients.
+        calc_type e0 = 0;
+        for (const auto& term : terms) {
+            e0 += term.second;
+        }
+        py_qs_data_t b0 = bra == nullptr ? 1 : std::conj(bra[0]);
+        py_qs_data_t k0 = ket == nullptr ? 1 : ket[0];
+        return b0 * k0 * e0;
+    }
+    calc_type res_real = 0, res_imag = 0;
+    bool cached = energy.Cached();
+    auto e_ptr = cached ? energy.Table().data() : nullptr;
+    // clang-format off
+    THRESHOLD_OMP(
+        MQ_DO_PRAGMA(omp parallel for reduction(+:res_real, res_imag) schedule(static)), dim, DimTh,
+            for (omp::idx_t i = 0; i < static_cast<omp::idx_t>(dim); i++) {
+                calc_type e = 0;
+                if (cached) {
+                    e = e_ptr[energy.Pack(i)];
+                } else {
+                    for (const auto& [mask, coeff] : terms) {
+                        e += (CountOne(i & mask) & 1) ? -coeff : coeff;
+                    }
+                }
+                auto tmp = std::conj(bra[i]) * ket[i] * e;
+                res_real += std::real(tmp);
+                res_imag += std::imag(tmp);
+            })
+    // clang-format on
+    return {res_real, res_imag};
+}
+
 template <typename derived_, typename calc_type>
 auto CPUVectorPolicyBase<derived_, calc_type>::GroundStateOfZZs(const std::map<index_t, calc_type>& masks_value,
                                                                 qbit_t n_qubits) -> calc_type {
-    calc_type result = std::numeric_limits<calc_type>::max();
-    auto dim = static_cast<uint64_t>(1) << n_qubits;
-    THRESHOLD_OMP(
-        MQ_DO_PRAGMA(omp parallel for reduction(min:result) schedule(static)), dim, DimTh,
-                     for (omp::idx_t i = 0; i < (static_cast<uint64_t>(1) << n_qubits); i++) {
-                         calc_type ith_energy = 0;
-                         for (auto& [mask, coeff] : masks_value) {
-                             if (CountOne(i & mask) & 1) {
-                                 ith_energy -= coeff;
-                             } else {
-                                 ith_energy += coeff;
-                             }
-                         }
-                         result = std::min(result, ith_energy);
-                     });
-    return result;
+    return derived::GroundStatesOfZZs(masks_value, n_qubits, 0).first;
+}
+
+template <typename derived_, typename calc_type>
+auto CPUVectorPolicyBase<derived_, calc_type>::GroundStatesOfZZs(const std::map<index_t, calc_type>& masks_value,
+                                                                 qbit_t n_qubits, size_t max_n_states)
+    -> std::pair<calc_type, VT<index_t>> {
+    VT<index_t> masks;
+    VT<double> coeffs;
+    for (auto& [mask, coeff] : masks_value) {
+        masks.push_back(mask);
+        coeffs.push_back(coeff);
+    }
+    auto [energy, states] = GroundStatesOfZZMasks(masks, coeffs, n_qubits, max_n_states);
+    return {static_cast<calc_type>(energy), states};
 }
 
 #ifdef __x86_64__
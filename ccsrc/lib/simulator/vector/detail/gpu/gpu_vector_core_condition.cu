@@ -123,10 +123,32 @@ void GPUVectorPolicyBase<derived_, calc_type_>::QSMulValue(const qs_data_p_t& sr
     derived::template ConditionalBinary<0, 0>(src, des_p, value, 0, dim, thrust::multiplies<qs_data_t>());
 }
 
+template <typename derived_, typename calc_type_>
+void GPUVectorPolicyBase<derived_, calc_type_>::QSAxpy(const qs_data_p_t& src, qs_data_p_t* des_p, qs_data_t value,
+                                                       index_t dim) {
+    auto& des = *des_p;
+    if (des == nullptr) {
+        des = derived::InitState(dim);
+    }
+    thrust::counting_iterator<size_t> i(0);
+    if (src == nullptr) {
+        thrust::for_each(i, i + 1, [=] __device__(size_t i) { des[i] += value; });
+    } else {
+        thrust::for_each(i, i + dim, [=] __device__(size_t i) { des[i] += value * src[i]; });
+    }
+}
+
 template <typename derived_, typename calc_type_>
 auto GPUVectorPolicyBase<derived_, calc_type_>::ConditionalCollect(const qs_data_p_t& qs, index_t mask, index_t condi,
                                                                    bool abs, index_t dim) -> qs_data_t {
     qs_data_t res = 0;
+    if (qs == nullptr) {
+        // zero state, only the first amplitude is one.
+        if ((0 & mask) == condi) {
+            res = 1.0;
+        }
+        return res;
+    }
     thrust::counting_iterator<size_t> l(0);
     if (abs) {
         res = thrust::transform_reduce(
@@ -143,7 +165,7 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::ConditionalCollect(const qs_data
             l, l + dim,
             [=] __device__(size_t l) {
                 if ((l & mask) == condi) {
-                    return thrust::conj(qs[l]) * qs[l];
+                    return qs[l];
                 }
                 return qs_data_t(0.0, 0.0);
             },
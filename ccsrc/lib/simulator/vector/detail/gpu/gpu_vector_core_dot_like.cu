@@ -133,7 +133,25 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::ZeroStateVdot(const qs_data_p_t&
 
 template <typename derived_, typename calc_type_>
 auto GPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
-                                                          const qs_data_p_t& vec_out, index_t dim) -> qs_data_p_t {
+                                                          const qs_data_p_t& vec, index_t dim) -> qs_data_p_t {
+    qs_data_p_t out = nullptr;
+    derived::CsrDotVec(a, vec, &out, dim);
+    return out;
+}
+
+template <typename derived_, typename calc_type_>
+auto GPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
+                                                          const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& b,
+                                                          const qs_data_p_t& vec, index_t dim) -> qs_data_p_t {
+    qs_data_p_t out = nullptr;
+    derived::CsrDotVec(a, b, vec, &out, dim);
+    return out;
+}
+
+template <typename derived_, typename calc_type_>
+void GPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
+                                                          const qs_data_p_t& vec_out, qs_data_p_t* out_p,
+                                                          index_t dim) {
     if (dim != a->dim_) {
         throw std::runtime_error("Sparse hamiltonian size not match with quantum state size.");
     }
@@ -143,28 +161,28 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<
         vec = derived::InitState(dim);
         will_free = true;
     }
+    auto& out = (*out_p);
+    if (out == nullptr) {
+        out = derived::InitState(dim, false);
+    }
     auto host = reinterpret_cast<std::complex<calc_type>*>(malloc(dim * sizeof(std::complex<calc_type>)));
+    auto host_res = reinterpret_cast<std::complex<calc_type>*>(malloc(dim * sizeof(std::complex<calc_type>)));
     cudaMemcpy(host, vec, sizeof(qs_data_t) * dim, cudaMemcpyDeviceToHost);
-    auto host_res = sparse::Csr_Dot_Vec<calc_type_, calc_type_>(a, reinterpret_cast<calc_type*>(host));
-    auto out = InitState(dim);
-    cudaMemcpy(out, reinterpret_cast<std::complex<calc_type>*>(host_res), sizeof(qs_data_t) * dim,
-               cudaMemcpyHostToDevice);
-    if (host != nullptr) {
-        free(host);
-    }
-    if (host_res != nullptr) {
-        free(host_res);
-    }
+    sparse::Csr_Dot_Vec<calc_type_, calc_type_>(a, reinterpret_cast<calc_type*>(host),
+                                                reinterpret_cast<calc_type*>(host_res));
+    cudaMemcpy(out, host_res, sizeof(qs_data_t) * dim, cudaMemcpyHostToDevice);
+    free(host);
+    free(host_res);
     if (will_free) {
         derived::FreeState(&vec);
     }
-    return out;
 }
 
 template <typename derived_, typename calc_type_>
-auto GPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
+void GPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a,
                                                           const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& b,
-                                                          const qs_data_p_t& vec_out, index_t dim) -> qs_data_p_t {
+                                                          const qs_data_p_t& vec_out, qs_data_p_t* out_p,
+                                                          index_t dim) {
     if ((dim != a->dim_) || (dim != b->dim_)) {
         throw std::runtime_error("Sparse hamiltonian size not match with quantum state size.");
     }
@@ -174,23 +192,23 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::CsrDotVec(const std::shared_ptr<
         vec = derived::InitState(dim);
         will_free = true;
     }
+    auto& out = (*out_p);
+    if (out == nullptr) {
+        out = derived::InitState(dim, false);
+    }
     auto host = reinterpret_cast<std::complex<calc_type>*>(malloc(dim * sizeof(std::complex<calc_type>)));
+    auto host_res = reinterpret_cast<std::complex<calc_type>*>(malloc(dim * sizeof(std::complex<calc_type>)));
     cudaMemcpy(host, vec, sizeof(qs_data_t) * dim, cudaMemcpyDeviceToHost);
-    auto host_res = sparse::Csr_Dot_Vec<calc_type_, calc_type_>(a, b, reinterpret_cast<calc_type*>(host));
-    auto out = InitState(dim);
-    cudaMemcpy(out, reinterpret_cast<std::complex<calc_type>*>(host_res), sizeof(qs_data_t) * dim,
-               cudaMemcpyHostToDevice);
-    if (host != nullptr) {
-        free(host);
-    }
-    if (host_res != nullptr) {
-        free(host_res);
-    }
+    sparse::Csr_Dot_Vec<calc_type_, calc_type_>(a, b, reinterpret_cast<calc_type*>(host),
+                                                reinterpret_cast<calc_type*>(host_res));
+    cudaMemcpy(out, host_res, sizeof(qs_data_t) * dim, cudaMemcpyHostToDevice);
+    free(host);
+    free(host_res);
     if (will_free) {
         derived::FreeState(&vec);
     }
-    return out;
 }
+
 template <typename derived_, typename calc_type_>
 auto GPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfCsr(
     const std::shared_ptr<sparse::CsrHdMatrix<calc_type>>& a, const qs_data_p_t& bra_out, const qs_data_p_t& ket_out,
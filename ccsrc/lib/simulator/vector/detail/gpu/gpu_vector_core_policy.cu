@@ -178,15 +178,109 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfTerms(const qs_data
     return out;
 }
 
+template <typename derived_, typename calc_type_>
+void GPUVectorPolicyBase<derived_, calc_type_>::ApplyDiagonal(qs_data_p_t* qs_p,
+                                                              const VT<std::pair<index_t, calc_type>>& terms,
+                                                              const DiagonalEnergy<calc_type>& energy, index_t dim) {
+    auto& qs = (*qs_p);
+    if (qs == nullptr) {
+        qs = derived::InitState(dim);
+    }
+    auto n_term = terms.size();
+    thrust::device_vector<index_t> mask_device;
+    thrust::device_vector<calc_type> value_device;
+    for (auto& [mask, value] : terms) {
+        mask_device.push_back(mask);
+        value_device.push_back(value);
+    }
+    auto mask_ptr = thrust::raw_pointer_cast(mask_device.data());
+    auto value_ptr = thrust::raw_pointer_cast(value_device.data());
+    thrust::counting_iterator<index_t> l(0);
+    thrust::for_each(l, l + dim, [=] __device__(index_t i) {
+        calc_type e = 0;
+        for (int t = 0; t < n_term; t++) {
+            if (__popcll(i & mask_ptr[t]) & 1) {
+                e -= value_ptr[t];
+            } else {
+                e += value_ptr[t];
+            }
+        }
+        qs[i] *= e;
+    });
+}
+
+template <typename derived_, typename calc_type_>
+auto GPUVectorPolicyBase<derived_, calc_type_>::ExpectationOfDiagonal(const qs_data_p_t& bra_out,
+                                                                      const qs_data_p_t& ket_out,
+                                                                      const VT<std::pair<index_t, calc_type>>& terms,
+                                                                      const DiagonalEnergy<calc_type>& energy, index_t dim)
+    -> py_qs_data_t {
+    auto bra = bra_out;
+    auto ket = ket_out;
+    bool will_free_bra = false, will_free_ket = false;
+    if (bra == nullptr) {
+        bra = derived::InitState(dim);
+        will_free_bra = true;
+    }
+    if (ket == nullptr) {
+        ket = derived::InitState(dim);
+        will_free_ket = true;
+    }
+    auto n_term = terms.size();
+    thrust::device_vector<index_t> mask_device;
+    thrust::device_vector<calc_type> value_device;
+    for (auto& [mask, value] : terms) {
+        mask_device.push_back(mask);
+        value_device.push_back(value);
+    }
+    auto mask_ptr = thrust::raw_pointer_cast(mask_device.data());
+    auto value_ptr = thrust::raw_pointer_cast(value_device.data());
+    thrust::counting_iterator<index_t> l(0);
+    qs_data_t out = thrust::transform_reduce(
+        l, l + dim,
+        [=] __device__(index_t i) {
+            calc_type e = 0;
+            for (int t = 0; t < n_term; t++) {
+                if (__popcll(i & mask_ptr[t]) & 1) {
+                    e -= value_ptr[t];
+                } else {
+                    e += value_ptr[t];
+                }
+            }
+            return thrust::conj(bra[i]) * ket[i] * e;
+        },
+        qs_data_t(0, 0), thrust::plus<qs_data_t>());
+    if (will_free_bra) {
+        derived::FreeState(&bra);
+    }
+    if (will_free_ket) {
+        derived::FreeState(&ket);
+    }
+    return out;
+}
+
 template <typename derived_, typename calc_type_>
 auto GPUVectorPolicyBase<derived_, calc_type_>::ApplyTerms(qs_data_p_t* qs_p,
                                                            const std::vector<PauliTerm<calc_type>>& ham, index_t dim)
     -> qs_data_p_t {
+    qs_data_p_t out = nullptr;
+    derived::ApplyTerms(qs_p, &out, ham, dim);
+    return out;
+}
+
+template <typename derived_, typename calc_type_>
+void GPUVectorPolicyBase<derived_, calc_type_>::ApplyTerms(qs_data_p_t* qs_p, qs_data_p_t* out_p,
+                                                           const std::vector<PauliTerm<calc_type>>& ham, index_t dim) {
     auto& qs = (*qs_p);
     if (qs == nullptr) {
         qs = derived::InitState(dim);
     }
-    qs_data_p_t out = derived::InitState(dim, false);
+    auto& out = (*out_p);
+    if (out == nullptr) {
+        out = derived::InitState(dim, false);
+    } else {
+        cudaMemset(out, 0, sizeof(qs_data_t) * dim);
+    }
     for (const auto& [pauli_string, coeff] : ham) {
         auto mask = GenPauliMask(pauli_string);
         auto mask_f = mask.mask_x | mask.mask_y;
@@ -221,8 +315,7 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::ApplyTerms(qs_data_p_t* qs_p,
                 <<<128, 128>>>(out, qs, coeff, mask.num_y, mask.mask_y, mask.mask_z, mask_f, dim);
         }
     }
-    return out;
-};
+}
 
 template <typename derived_, typename calc_type_>
 auto GPUVectorPolicyBase<derived_, calc_type_>::GroundStateOfZZs(const std::map<index_t, calc_type>& masks_value,
@@ -255,6 +348,21 @@ auto GPUVectorPolicyBase<derived_, calc_type_>::GroundStateOfZZs(const std::map<
     return res;
 }
 
+template <typename derived_, typename calc_type_>
+auto GPUVectorPolicyBase<derived_, calc_type_>::GroundStatesOfZZs(const std::map<index_t, calc_type>& masks_value,
+                                                                  qbit_t n_qubits, size_t max_n_states)
+    -> std::pair<calc_type, VT<index_t>> {
+    // The branch and bound search runs on host, no quantum state is involved.
+    VT<index_t> masks;
+    VT<double> coeffs;
+    for (auto& [mask, coeff] : masks_value) {
+        masks.push_back(mask);
+        coeffs.push_back(coeff);
+    }
+    auto [energy, states] = GroundStatesOfZZMasks(masks, coeffs, n_qubits, max_n_states);
+    return {static_cast<calc_type>(energy), states};
+}
+
 template <typename derived_, typename calc_type_>
 auto GPUVectorPolicyBase<derived_, calc_type_>::Copy(const qs_data_p_t& qs, index_t dim) -> qs_data_p_t {
     qs_data_p_t out = nullptr;
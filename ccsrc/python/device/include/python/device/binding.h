@@ -120,12 +120,20 @@ void BindTopology(py::module &module) {  // NOLINT(runtime/references)
 }  // namespace mindquantum::mapping
 
 void BindQubitMapping(py::module &module) {  // NOLINT(runtime/references)
+    py::class_<mm::TrialResult>(module, "TrialResult")
+        .def_readonly("seed", &mm::TrialResult::seed)
+        .def_readonly("num_swap", &mm::TrialResult::num_swap)
+        .def_readonly("num_gates", &mm::TrialResult::num_gates)
+        .def_readonly("depth", &mm::TrialResult::depth);
     auto saber_m = py::class_<mm::SABRE, std::shared_ptr<mm::SABRE>>(module, "SABRE")
                        .def(py::init<const mindquantum::VT<std::shared_ptr<mindquantum::BasicGate>> &,
                                      const std::shared_ptr<mm::QubitsTopology> &>(),
                             "Initialize saber method.")
                        .def("solve", &mm::SABRE::Solve, "iter_num"_a, "W"_a, "delta1"_a, "delta2"_a,
-                            "Solve qubit mapping problem with saber method.");
+                            "num_trials"_a = 1, "seed"_a = 42, "prefer_depth"_a = false, "layout_time_limit"_a = 0.0,
+                            "Solve qubit mapping problem with saber method.")
+                       .def("get_trial_results", &mm::SABRE::GetTrialResults,
+                            "Get statistics of every trial of last solve.");
     saber_m.doc() = "SABER method to implement qubit mapping task.";
     //------------------------------------------------------------------------------
     auto ha_saber_m = py::class_<mm::MQ_SABRE, std::shared_ptr<mm::MQ_SABRE>>(module, "MQ_SABRE")
@@ -134,7 +142,10 @@ void BindQubitMapping(py::module &module) {  // NOLINT(runtime/references)
                                const std::vector<std::pair<std::pair<int,int>,std::vector<double>>> &>(),
                     "Initialize mq_saber method.")
                     .def("solve", &mm::MQ_SABRE::Solve, "W"_a, "alpha1"_a, "alpha2"_a, "alpha3"_a,
-                         "Solve qubit mapping problem with ha_saber method.");
+                         "num_trials"_a = 1, "seed"_a = 42, "prefer_depth"_a = false, "layout_time_limit"_a = 0.0,
+                         "Solve qubit mapping problem with ha_saber method.")
+                    .def("get_trial_results", &mm::MQ_SABRE::GetTrialResults,
+                         "Get statistics of every trial of last solve.");
  ha_saber_m.doc() = "HA_SABER method to implement qubit mapping task.";
 }
 }  // namespace mindquantum::python
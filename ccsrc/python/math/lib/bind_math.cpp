@@ -31,9 +31,13 @@
 
 #include "core/mq_base_types.h"
 #include "math/operators/fermion_operator_view.h"
+#include "math/operators/grouping.h"
 #include "math/operators/qubit_operator_view.h"
+#include "math/operators/serialization.h"
 #include "math/operators/sparsing.h"
+#include "math/operators/tapering.h"
 #include "math/operators/transform.h"
+#include "math/operators/trotter.h"
 #include "math/pr/parameter_resolver.h"
 #include "math/tensor/csr_matrix.h"
 #include "math/tensor/matrix.h"
@@ -159,8 +163,8 @@ void BindPR(py::module &module) {  // NOLINT(runtime/references)
         .def("dtype", &pr_t::GetDtype)
         .def("encoder_part", &pr_t::EncoderPart)
         .def("get_const", &pr_t::GetConstValue)
-        .def("get_encoder_parameters", [](const pr_t &a) { return a.encoder_parameters_; })
-        .def("get_grad_parameters", [](const pr_t &a) { return a.no_grad_parameters_; })
+        .def("get_encoder_parameters", &pr_t::GetEncoderParameters)
+        .def("get_grad_parameters", &pr_t::GetNoGradParameters)
         .def("get_item", &pr_t::GetItem)
         .def("is_hermitian", &pr_t::IsHermitian)
         .def("is_not_zero", &pr_t::IsNotZero)
@@ -338,6 +342,61 @@ void BindTransform(py::module &module) {  // NOLINT(runtime/references)
     module.def("ternary_tree", &operators::transform::ternary_tree, "ops"_a, "n_qubits"_a);
     module.def("bravyi_kitaev_superfast", &operators::transform::bravyi_kitaev_superfast, "ops"_a);
 }
+
+void BindGrouping(py::module &module) {  // NOLINT(runtime/references)
+    py::class_<operators::BasisGate>(module, "BasisGate")
+        .def_readonly("name", &operators::BasisGate::name)
+        .def_readonly("obj", &operators::BasisGate::obj)
+        .def_readonly("ctrls", &operators::BasisGate::ctrls);
+    py::class_<operators::MeasureGroup>(module, "MeasureGroup")
+        .def_readonly("terms", &operators::MeasureGroup::terms)
+        .def_readonly("rotation", &operators::MeasureGroup::rotation)
+        .def_readonly("z_qubits", &operators::MeasureGroup::z_qubits)
+        .def_readonly("signs", &operators::MeasureGroup::signs);
+    module.def("group_commuting_terms", &operators::GroupCommutingTerms, "ops"_a, "qubit_wise"_a = true);
+}
+
+void BindTapering(py::module &module) {  // NOLINT(runtime/references)
+    py::class_<operators::Z2Symmetries>(module, "Z2Symmetries")
+        .def_readonly("generators", &operators::Z2Symmetries::generators)
+        .def_readonly("rotation", &operators::Z2Symmetries::rotation)
+        .def_readonly("qubits", &operators::Z2Symmetries::qubits)
+        .def_readonly("signs", &operators::Z2Symmetries::signs);
+    module.def("find_z2_symmetries", &operators::FindZ2Symmetries, "ops"_a);
+    module.def("taper_operator", &operators::TaperOperator, "ops"_a, "symmetries"_a, "sector"_a);
+}
+
+void BindTrotter(py::module &module) {  // NOLINT(runtime/references)
+    py::class_<operators::EvolutionGate>(module, "EvolutionGate")
+        .def_readonly("name", &operators::EvolutionGate::name)
+        .def_readonly("objs", &operators::EvolutionGate::objs)
+        .def_readonly("ctrls", &operators::EvolutionGate::ctrls)
+        .def_readonly("coeff", &operators::EvolutionGate::coeff);
+    module.def("trotter_circuit", &operators::TrotterCircuit, "ops"_a, "time"_a, "steps"_a, "order"_a = 1,
+               "native"_a = true);
+    module.def("qdrift_circuit", &operators::QDriftCircuit, "ops"_a, "time"_a, "n_samples"_a, "seed"_a,
+               "native"_a = true);
+}
+
+void BindSerialization(py::module &module) {  // NOLINT(runtime/references)
+    namespace ser = operators::serialization;
+    using qop_t = operators::qubit::QubitOperator;
+    using fop_t = operators::fermion::FermionOperator;
+    module.def("save_operator", py::overload_cast<const qop_t &, const std::string &>(&ser::Save), "ops"_a,
+               "filename"_a);
+    module.def("save_operator", py::overload_cast<const fop_t &, const std::string &>(&ser::Save), "ops"_a,
+               "filename"_a);
+    py::class_<ser::OperatorFile, std::shared_ptr<ser::OperatorFile>>(module, "OperatorFile")
+        .def(py::init<const std::string &>(), "filename"_a)
+        .def("__len__", &ser::OperatorFile::size)
+        .def("dtype", &ser::OperatorFile::GetDtype)
+        .def("parameterized", &ser::OperatorFile::Parameterized)
+        .def("is_fermion", [](const ser::OperatorFile &f) { return f.Kind() == ser::OperatorKind::Fermion; })
+        .def("qubit_term", &ser::OperatorFile::QubitTerm, "idx"_a)
+        .def("fermion_term", &ser::OperatorFile::FermionTerm, "idx"_a)
+        .def("to_qubit_operator", &ser::OperatorFile::ToQubitOperator)
+        .def("to_fermion_operator", &ser::OperatorFile::ToFermionOperator);
+}
 }  // namespace mindquantum::python
 #undef BIND_TENSOR_OPS
 #undef BIND_TENSOR_OPS_REV
@@ -378,4 +437,8 @@ PYBIND11_MODULE(_math, m) {
     py::module ops_module = m.def_submodule("ops", "MindQuantum Operators module.");
     mindquantum::python::BindQubitOperator(ops_module);
     mindquantum::python::BindTransform(ops_module);
+    mindquantum::python::BindGrouping(ops_module);
+    mindquantum::python::BindTapering(ops_module);
+    mindquantum::python::BindTrotter(ops_module);
+    mindquantum::python::BindSerialization(ops_module);
 }
@@ -42,6 +42,7 @@
 #include "ops/gate_id.h"
 #include "ops/gates.h"
 #include "ops/hamiltonian.h"
+#include "ops/projector.h"
 
 #include "python/core/sparse/csrhdmatrix.h"
 #include "python/ops/basic_gate.h"
@@ -288,6 +289,11 @@ PYBIND11_MODULE(mqbackend, m) {
     py::module mqbackend_float = m.def_submodule("float", "MindQuantum-C++ double backend");
     mindquantum::python::BindOther<float>(mqbackend_float);
 
+    py::class_<mindquantum::Projector, std::shared_ptr<mindquantum::Projector>>(m, "projector")
+        .def(py::init<const std::string &>())
+        .def_readonly("n_qubits", &mindquantum::Projector::n_qubits_)
+        .def_readonly("proj_str", &mindquantum::Projector::proj_str_);
+
     py::module c = m.def_submodule("c", "pybind11 c++ env");
     mindquantum::BindPybind11Env(c);
 
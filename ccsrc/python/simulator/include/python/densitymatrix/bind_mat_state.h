@@ -39,12 +39,14 @@
 #    include "simulator/densitymatrix/detail/cpu_densitymatrix_policy.h"
 #endif  // __CUDACC__
 
+#include "ops/projector.h"
 #include "simulator/densitymatrix/densitymatrix_state.h"
 
 template <typename sim_t>
 auto BindSim(pybind11::module& module, const std::string_view& name) {  // NOLINT
     using namespace pybind11::literals;                                 // NOLINT
     using qbit_t = mindquantum::qbit_t;
+    using circuit_t = typename sim_t::circuit_t;
 
     return pybind11::class_<sim_t>(module, name.data())
         .def(pybind11::init<qbit_t, unsigned>(), "n_qubits"_a, "seed"_a = 42)
@@ -63,6 +65,9 @@ auto BindSim(pybind11::module& module, const std::string_view& name) {  // NOLIN
         .def("copy", [](const sim_t& sim) { return sim; })
         .def("sampling", &sim_t::Sampling)
         .def("get_expectation", &sim_t::GetExpectation)
+        .def("get_projector_expectation", &sim_t::GetProjectorExpectation, "proj"_a, "circ"_a = circuit_t(),
+             "pr"_a = parameter::ParameterResolver())
+        .def("post_select", &sim_t::PostSelect)
         .def("get_expectation_with_grad_multi_multi", &sim_t::GetExpectationWithReversibleGradMultiMulti)
         .def("get_expectation_with_noise_grad_multi_multi", &sim_t::GetExpectationWithNoiseGradMultiMulti);
 }
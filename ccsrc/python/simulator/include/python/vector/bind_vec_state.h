@@ -40,6 +40,7 @@
 #endif  // __CUDACC__
 
 #include "ops/hamiltonian.h"
+#include "ops/projector.h"
 #include "simulator/vector/blas.h"
 #include "simulator/vector/vector_state.h"
 
@@ -60,6 +61,10 @@ auto BindSim(pybind11::module& module, const std::string_view& name) {  // NOLIN
         .def("get_qs", &sim_t::GetQS)
         .def("set_qs", &sim_t::SetQS)
         .def("apply_hamiltonian", &sim_t::ApplyHamiltonian)
+        .def("apply_hamiltonian_evolution", &sim_t::ApplyHamiltonianEvolution, "ham"_a, "t"_a, "tol"_a = 1e-8,
+             "max_krylov_dim"_a = 16)
+        .def("solve_lowest_eigenstates", &sim_t::SolveLowestEigenStates, "ham"_a, "k"_a = 1, "tol"_a = 1e-8,
+             "max_krylov_dim"_a = 0, "max_restart"_a = 300)
         .def("copy", [](const sim_t& sim) { return sim; })
         .def("sampling", &sim_t::Sampling)
         .def("get_circuit_matrix", &sim_t::GetCircuitMatrix)
@@ -73,6 +78,9 @@ auto BindSim(pybind11::module& module, const std::string_view& name) {  // NOLIN
         .def("get_expectation",
              pybind11::overload_cast<const mindquantum::Hamiltonian<calc_type>&, const circuit_t&,
                                      const parameter::ParameterResolver&>(&sim_t::GetExpectation, pybind11::const_))
+        .def("get_projector_expectation", &sim_t::GetProjectorExpectation, "proj"_a, "circ"_a = circuit_t(),
+             "pr"_a = parameter::ParameterResolver())
+        .def("post_select", &sim_t::PostSelect)
         .def("qram_expectation_with_grad", &sim_t::QramExpectationWithGrad)
         .def("get_expectation_with_grad_one_one", &sim_t::GetExpectationWithGradOneOne)
         .def("get_expectation_with_grad_one_multi", &sim_t::GetExpectationWithGradOneMulti)
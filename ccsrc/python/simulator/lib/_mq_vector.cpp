@@ -82,4 +82,7 @@ PYBIND11_MODULE(_mq_vector, module) {
     BindBlas<double_vec_sim>(double_blas);
 
     module.def("ground_state_of_zs", &double_policy_t::GroundStateOfZZs, "masks_value"_a, "n_qubits"_a);
+    // _mq_vector_gpu includes this file, its GroundStatesOfZZs runs the same branch and bound on host.
+    module.def("ground_states_of_zs", &double_policy_t::GroundStatesOfZZs, "masks_value"_a, "n_qubits"_a,
+               "max_n_states"_a);
 }
@@ -1,10 +1,19 @@
 """MQ_SABRE algorithm to implement qubit mapping."""
+import numbers
 import typing
 
+import numpy as np
+
 from ...core.circuit import Circuit
 from ...core.gates import SWAP
 from ...device import QubitsTopology
 from ...mqbackend.device import MQ_SABRE as MQ_SABRE_  # pylint: disable=import-error
+from ...utils.type_value_check import (
+    _check_input_type,
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
 from typing import List,Tuple
 
 # pylint: disable=too-few-public-methods
@@ -27,6 +36,7 @@ class MQ_SABRE:
         self.topology = topology
         self.cnoterrorandlength=cnoterrorandlength
         self.cpp_solver = MQ_SABRE_(self.circuit.get_cpp_obj(), self.topology.__get_cpp_obj__(),self.cnoterrorandlength)
+        self.trial_results = []
 
         def check_connected(topology: QubitsTopology) -> bool:
             """Check whether topology graph is connected."""
@@ -57,23 +67,56 @@ class MQ_SABRE:
             )
 
     def solve(
-        self, W: float, alpha1: float, alpha2: float, alpha3: float
+        self,
+        W: float,
+        alpha1: float,
+        alpha2: float,
+        alpha3: float,
+        n_trials: int = 1,
+        seed: int = None,
+        prefer_depth: bool = False,
+        layout_time_limit: float = 0.0,
     ) -> typing.Union[Circuit, typing.List[int], typing.List[int]]:
         """
         Solve qubit mapping problem with SABRE algorithm.
 
         Args:
-            iter_num (int): The iteration number for when solving mapping problem.
-            w (float): The w parameter. For more detail, please refers to the paper.
-            delta1 (float): The delta1 parameter. For more detail, please refers to the paper.
-            delta2 (float): The delta2 parameter. For more detail, please refers to the paper.
+            W (float): The weight of extended layer in heuristic cost.
+            alpha1 (float): The coefficient of distance matrix of coupling graph.
+            alpha2 (float): The coefficient of SWAP error rate matrix.
+            alpha3 (float): The coefficient of SWAP gate length matrix.
+            n_trials (int): The number of independent trials, which run in parallel threads. The first trial starts
+                from the initial mapping of interaction graph, every other trial ``t`` starts from a random mapping
+                seeded with ``seed + t`` and refined by a forward and a backward search. The result of the trial with
+                fewest SWAP gates is returned. Default: ``1``.
+            seed (int): The random seed of initial mapping. If ``None``, a random seed is used. Default: ``None``.
+            prefer_depth (bool): Whether to return the result of the trial with lowest circuit depth instead of fewest
+                SWAP gates. Default: ``False``.
+            layout_time_limit (float): The time budget in seconds of searching an initial mapping that places every
+                pair of interacting qubits on coupled physical qubits. Within this budget all such mappings are
+                searched and the one with lowest total cost ``alpha1 * distance + alpha2 * error rate + alpha3 * gate
+                length`` of its CNOT gates is used without SWAP gate and no trial is run. If none is found, the trials
+                above are used. ``0`` disables the search. Default: ``0.0``.
 
         Returns:
             Tuple[:class:`~.core.circuit.Circuit`, List[int], List[int]], a quantum
                 circuit that can execute on given device, the initial mapping order,
-                and the final mapping order.
+                and the final mapping order. Statistics of every trial are kept in `trial_results`.
         """
-        gate_info, (init_map, final_map) = self.cpp_solver.solve(W, alpha1, alpha2, alpha3)
+        _check_int_type('n_trials', n_trials)
+        _check_value_should_not_less('n_trials', 1, n_trials)
+        _check_input_type('layout_time_limit', numbers.Real, layout_time_limit)
+        _check_value_should_not_less('layout_time_limit', 0, layout_time_limit)
+        if seed is None:
+            seed = np.random.randint(1, 2**23)
+        _check_seed(seed)
+        gate_info, (init_map, final_map) = self.cpp_solver.solve(
+            W, alpha1, alpha2, alpha3, n_trials, seed, prefer_depth, layout_time_limit
+        )
+        self.trial_results = [
+            {'seed': res.seed, 'num_swap': res.num_swap, 'num_gates': res.num_gates, 'depth': res.depth}
+            for res in self.cpp_solver.get_trial_results()
+        ]
         new_circ = Circuit()
         for idx, p1, p2 in gate_info:
             if idx == -1:
@@ -13,12 +13,21 @@
 # limitations under the License.
 # ============================================================================
 """SABRE algorithm to implement qubit mapping."""
+import numbers
 import typing
 
+import numpy as np
+
 from ...core.circuit import Circuit
 from ...core.gates import SWAP
 from ...device import QubitsTopology
 from ...mqbackend.device import SABRE as SABRE_  # pylint: disable=import-error
+from ...utils.type_value_check import (
+    _check_input_type,
+    _check_int_type,
+    _check_seed,
+    _check_value_should_not_less,
+)
 
 
 # pylint: disable=too-few-public-methods
@@ -41,6 +50,7 @@ class SABRE:
         self.circuit = circuit
         self.topology = topology
         self.cpp_solver = SABRE_(self.circuit.get_cpp_obj(), self.topology.__get_cpp_obj__())
+        self.trial_results = []
 
         def check_connected(topology: QubitsTopology) -> bool:
             """Check whether topology graph is connected."""
@@ -71,7 +81,15 @@ class SABRE:
             )
 
     def solve(
-        self, iter_num: int, w: float, delta1: float, delta2: float
+        self,
+        iter_num: int,
+        w: float,
+        delta1: float,
+        delta2: float,
+        n_trials: int = 1,
+        seed: int = None,
+        prefer_depth: bool = False,
+        layout_time_limit: float = 0.0,
     ) -> typing.Union[Circuit, typing.List[int], typing.List[int]]:
         """
         Solve qubit mapping problem with SABRE algorithm.
@@ -81,13 +99,36 @@ class SABRE:
             w (float): The w parameter. For more detail, please refers to the paper.
             delta1 (float): The delta1 parameter. For more detail, please refers to the paper.
             delta2 (float): The delta2 parameter. For more detail, please refers to the paper.
+            n_trials (int): The number of independent trials, which run in parallel threads. The result of the trial
+                with fewest SWAP gates is returned. Default: ``1``.
+            seed (int): The random seed of initial mapping, trial ``t`` is seeded with ``seed + t`` so that it can
+                be reproduced alone. If ``None``, a random seed is used. Default: ``None``.
+            prefer_depth (bool): Whether to return the result of the trial with lowest circuit depth instead of fewest
+                SWAP gates. Default: ``False``.
+            layout_time_limit (float): The time budget in seconds of searching an initial mapping that places every
+                pair of interacting qubits on coupled physical qubits. If such a mapping is found, the circuit is
+                mapped without SWAP gate and no trial is run, otherwise the trials above are used. ``0`` disables the
+                search. Default: ``0.0``.
 
         Returns:
             Tuple[:class:`~.core.circuit.Circuit`, List[int], List[int]], a quantum
                 circuit that can execute on given device, the initial mapping order,
-                and the final mapping order.
+                and the final mapping order. Statistics of every trial are kept in `trial_results`.
         """
-        gate_info, (init_map, final_map) = self.cpp_solver.solve(iter_num, w, delta1, delta2)
+        _check_int_type('n_trials', n_trials)
+        _check_value_should_not_less('n_trials', 1, n_trials)
+        _check_input_type('layout_time_limit', numbers.Real, layout_time_limit)
+        _check_value_should_not_less('layout_time_limit', 0, layout_time_limit)
+        if seed is None:
+            seed = np.random.randint(1, 2**23)
+        _check_seed(seed)
+        gate_info, (init_map, final_map) = self.cpp_solver.solve(
+            iter_num, w, delta1, delta2, n_trials, seed, prefer_depth, layout_time_limit
+        )
+        self.trial_results = [
+            {'seed': res.seed, 'num_swap': res.num_swap, 'num_gates': res.num_gates, 'depth': res.depth}
+            for res in self.cpp_solver.get_trial_results()
+        ]
         new_circ = Circuit()
         for idx, p1, p2 in gate_info:
             if idx == -1:
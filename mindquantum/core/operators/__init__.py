@@ -34,17 +34,20 @@ from .polynomial_tensor import PolynomialTensor
 from .projector import Projector
 from .qubit_excitation_operator import QubitExcitationOperator
 from .qubit_operator import QubitOperator
-from .time_evolution import TimeEvolution
+from .time_evolution import TimeEvolution, trotter_circuit
 from .utils import (
     commutator,
     count_qubits,
     down_index,
+    find_z2_symmetries,
     get_fermion_operator,
     ground_state_of_sum_zz,
+    group_commuting_terms,
     hermitian_conjugated,
     normal_ordered,
     number_operator,
     sz_operator,
+    taper_qubits,
     up_index,
 )
 
@@ -67,6 +70,10 @@ __all__ = [
     "down_index",
     "sz_operator",
     "ground_state_of_sum_zz",
+    "group_commuting_terms",
+    "find_z2_symmetries",
+    "taper_qubits",
+    "trotter_circuit",
 ]
 __all__.append('InteractionOperator')
 __all__.sort()
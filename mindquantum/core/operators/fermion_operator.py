@@ -25,6 +25,8 @@ from scipy.sparse import csr_matrix, kron
 
 import mindquantum as mq
 from mindquantum._math.ops import FermionOperator as FermionOperator_
+from mindquantum._math.ops import OperatorFile as OperatorFile_
+from mindquantum._math.ops import save_operator
 from mindquantum._math.ops import f_term_value
 from mindquantum.core.operators._term_value import TermValue
 from mindquantum.core.parameterresolver import ParameterResolver, PRConvertible
@@ -370,6 +372,55 @@ class FermionOperator(FermionOperator_):
             out += FermionOperator(' '.join([f"{i}{'' if j ==0 else '^'}" for i, j in term]), ParameterResolver(v))
         return out
 
+    @staticmethod
+    def load(filename: str) -> "FermionOperator":
+        """
+        Load a FermionOperator from binary file saved by :meth:`~.core.operators.FermionOperator.save`.
+
+        The file is memory mapped and decoded directly into the underlying C++ operator.
+
+        Args:
+            filename (str): The path of binary operator file.
+
+        Returns:
+            FermionOperator, the FermionOperator loaded from file.
+
+        Examples:
+            >>> from mindquantum.core.operators import FermionOperator
+            >>> f = FermionOperator('0^ 1', 1 + 2j) + FermionOperator('2', 'a')
+            >>> f.save('ops.bin')
+            >>> FermionOperator.load('ops.bin') == f
+            True
+        """
+        return FermionOperator(OperatorFile_(filename).to_fermion_operator(), internal=True)
+
+    @staticmethod
+    def load_terms(filename: str) -> typing.Iterator["FermionOperator"]:
+        """
+        Iterate the terms of a binary file saved by :meth:`~.core.operators.FermionOperator.save` one by one.
+
+        Only the term being yielded is decoded from the memory mapped file, so that a large operator can be processed
+        without loading it as a whole.
+
+        Args:
+            filename (str): The path of binary operator file.
+
+        Returns:
+            Iterator[FermionOperator], every term of the operator as a single term FermionOperator, in the order they were saved.
+
+        Examples:
+            >>> from mindquantum.core.operators import FermionOperator
+            >>> f = FermionOperator('0^ 1', 1 + 2j) + FermionOperator('2', 'a')
+            >>> f.save('ops.bin')
+            >>> terms = list(FermionOperator.load_terms('ops.bin'))
+            >>> len(terms)
+            2
+            >>> terms[0] == FermionOperator('0^ 1', 1 + 2j)
+            True
+        """
+        op_file = OperatorFile_(filename)
+        return (FermionOperator(op_file.fermion_term(idx), internal=True) for idx in range(len(op_file)))
+
     @staticmethod
     def loads(strs: str) -> "FermionOperator":
         """
@@ -619,6 +670,23 @@ class FermionOperator(FermionOperator_):
         terms = [(tuple((logic_qubits[idx], dag) for idx, dag in key), value) for key, value in self.terms.items()]
         return FermionOperator(terms, internal=True)
 
+    def save(self, filename: str):
+        """
+        Save this FermionOperator into a compact binary file.
+
+        Terms are written one by one with their compressed keys and raw coefficients, which is much smaller and
+        faster to load than :meth:`~.core.operators.FermionOperator.dumps` for large operators.
+
+        Args:
+            filename (str): The path of binary operator file.
+
+        Examples:
+            >>> from mindquantum.core.operators import FermionOperator
+            >>> f = FermionOperator('0^ 1', 1 + 2j) + FermionOperator('2', 'a')
+            >>> f.save('ops.bin')
+        """
+        save_operator(self, filename)
+
     def singlet_coeff(self) -> ParameterResolver:
         """
         Get the coefficient of this operator, if the operator has only one term.
@@ -17,6 +17,8 @@
 
 import re
 
+from mindquantum import mqbackend as mb
+
 
 def _check_projector_str(proj):
     if not isinstance(proj, str):
@@ -70,3 +72,7 @@ class Projector:
     def __repr__(self):
         """Return a string representation of the object."""
         return self.__str__()
+
+    def get_cpp_obj(self):
+        """Get the underlying C++ object."""
+        return mb.projector(self.proj)
@@ -24,6 +24,8 @@ from scipy.sparse import csr_matrix
 
 import mindquantum as mq
 from mindquantum._math.ops import QubitOperator as QubitOperator_
+from mindquantum._math.ops import OperatorFile as OperatorFile_
+from mindquantum._math.ops import save_operator
 from mindquantum.core.operators._term_value import TermValue
 from mindquantum.core.parameterresolver import ParameterResolver, PRConvertible
 from mindquantum.dtype.dtype import str_dtype_map
@@ -320,6 +322,55 @@ class QubitOperator(QubitOperator_):
             out += QubitOperator(' '.join([f"{j}{i}" for i, j in term]), ParameterResolver(v))
         return out
 
+    @staticmethod
+    def load(filename: str) -> "QubitOperator":
+        """
+        Load a QubitOperator from binary file saved by :meth:`~.core.operators.QubitOperator.save`.
+
+        The file is memory mapped and decoded directly into the underlying C++ operator.
+
+        Args:
+            filename (str): The path of binary operator file.
+
+        Returns:
+            QubitOperator, the QubitOperator loaded from file.
+
+        Examples:
+            >>> from mindquantum.core.operators import QubitOperator
+            >>> f = QubitOperator('X0 Y1', 1 + 2j) + QubitOperator('Z2', 'a')
+            >>> f.save('ops.bin')
+            >>> QubitOperator.load('ops.bin') == f
+            True
+        """
+        return QubitOperator(OperatorFile_(filename).to_qubit_operator(), internal=True)
+
+    @staticmethod
+    def load_terms(filename: str) -> typing.Iterator["QubitOperator"]:
+        """
+        Iterate the terms of a binary file saved by :meth:`~.core.operators.QubitOperator.save` one by one.
+
+        Only the term being yielded is decoded from the memory mapped file, so that a large operator can be processed
+        without loading it as a whole.
+
+        Args:
+            filename (str): The path of binary operator file.
+
+        Returns:
+            Iterator[QubitOperator], every term of the operator as a single term QubitOperator, in the order they were saved.
+
+        Examples:
+            >>> from mindquantum.core.operators import QubitOperator
+            >>> f = QubitOperator('X0 Y1', 1 + 2j) + QubitOperator('Z2', 'a')
+            >>> f.save('ops.bin')
+            >>> terms = list(QubitOperator.load_terms('ops.bin'))
+            >>> len(terms)
+            2
+            >>> terms[0] == QubitOperator('X0 Y1', 1 + 2j)
+            True
+        """
+        op_file = OperatorFile_(filename)
+        return (QubitOperator(op_file.qubit_term(idx), internal=True) for idx in range(len(op_file)))
+
     @staticmethod
     def loads(strs: str) -> "QubitOperator":
         """
@@ -531,6 +582,23 @@ class QubitOperator(QubitOperator_):
         terms = [(tuple((logic_qubits[idx], dag) for idx, dag in key), value) for key, value in self.terms.items()]
         return QubitOperator(terms, internal=True)
 
+    def save(self, filename: str):
+        """
+        Save this QubitOperator into a compact binary file.
+
+        Terms are written one by one with their compressed keys and raw coefficients, which is much smaller and
+        faster to load than :meth:`~.core.operators.QubitOperator.dumps` for large operators.
+
+        Args:
+            filename (str): The path of binary operator file.
+
+        Examples:
+            >>> from mindquantum.core.operators import QubitOperator
+            >>> f = QubitOperator('X0 Y1', 1 + 2j) + QubitOperator('Z2', 'a')
+            >>> f.save('ops.bin')
+        """
+        save_operator(self, filename)
+
     def singlet(self) -> typing.List["QubitOperator"]:
         """
         Split the single string operator into every word.
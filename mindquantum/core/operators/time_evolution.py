@@ -14,6 +14,11 @@
 # ============================================================================
 """Circuit for time evolution."""
 
+import numbers
+import typing
+
+import numpy as np
+
 from ..circuit.utils import decompose_single_term_time_evolution
 from ..parameterresolver import ParameterResolver
 from .qubit_operator import QubitOperator
@@ -84,3 +89,80 @@ class TimeEvolution:  # pylint: disable=too-few-public-methods
             tmp_circ = decompose_single_term_time_evolution(k, pr_tmp)
             circ += tmp_circ
         return circ
+
+
+def trotter_circuit(
+    ops: QubitOperator,
+    time: numbers.Number = 1,
+    steps: int = 1,
+    order: typing.Union[int, str] = 1,
+    seed: int = None,
+    native: bool = True,
+):
+    r"""
+    Generate the product formula circuit of time evolution :math:`e^{-iHt}` natively.
+
+    Terms of the hamiltonian are sorted in reflected gray code order of their pauli strings, so that adjacent terms
+    share as many basis changes as possible, and only basis changes that differ between adjacent terms are emitted.
+    Terms on one or two qubits are emitted as native rotation gates, like :class:`~.core.gates.RX` or
+    :class:`~.core.gates.Rxy`, and longer terms as CNOT ladders around :class:`~.core.gates.RZ`. The constant term
+    only adds a global phase and is dropped.
+
+    Args:
+        ops (QubitOperator): The hermitian qubit operator hamiltonian with constant coefficients.
+        time (numbers.Number): The evolution time. Default: ``1``.
+        steps (int): The number of trotter steps, or the number of sampled rotations for qDRIFT. Default: ``1``.
+        order (Union[int, str]): The order of Suzuki product formula, ``1``, ``2`` or ``4``, or ``'qdrift'`` for
+            randomized qDRIFT, where every rotation samples a term with probability proportional to its absolute
+            coefficient. Default: ``1``.
+        seed (int): The random seed of qDRIFT. If ``None``, a random seed is used. Default: ``None``.
+        native (bool): Whether to emit terms on one or two qubits as native rotation gates. Default: ``True``.
+
+    Returns:
+        Circuit, the time evolution circuit.
+
+    Examples:
+        >>> from mindquantum.core.operators import QubitOperator, trotter_circuit
+        >>> ops = QubitOperator('X0 X1', 0.5) + QubitOperator('Z0 Z1 Z2', 0.2)
+        >>> circ = trotter_circuit(ops, 1.0, steps=2)
+        >>> len(circ)
+        12
+        >>> circ[0].name
+        'Rxx'
+    """
+    # pylint: disable=import-outside-toplevel
+    from mindquantum._math.ops import qdrift_circuit, trotter_circuit as trotter_circuit_
+    from mindquantum.utils.type_value_check import (
+        _check_int_type,
+        _check_seed,
+        _check_value_should_not_less,
+    )
+
+    from ..circuit import Circuit
+    from ..gates import CNOT, RX, RY, RZ, H, Rxx, Rxy, Rxz, Ryy, Ryz, Rzz
+
+    if not isinstance(ops, QubitOperator):
+        raise TypeError(f"ops requires a QubitOperator, but get {type(ops)}.")
+    if not isinstance(time, numbers.Real):
+        raise TypeError(f"time requires a real number, but get {type(time)}.")
+    _check_int_type('steps', steps)
+    _check_value_should_not_less('steps', 1, steps)
+    if order == 'qdrift':
+        if seed is None:
+            seed = np.random.randint(1, 2**23)
+        _check_seed(seed)
+        gates = qdrift_circuit(ops, time, steps, seed, native)
+    elif order in (1, 2, 4):
+        gates = trotter_circuit_(ops, time, steps, order, native)
+    else:
+        raise ValueError(f"order should be 1, 2, 4 or 'qdrift', but get {order}.")
+    rotations = {'RX': RX, 'RY': RY, 'RZ': RZ, 'Rxx': Rxx, 'Ryy': Ryy, 'Rzz': Rzz, 'Rxy': Rxy, 'Rxz': Rxz, 'Ryz': Ryz}
+    circ = Circuit()
+    for gate in gates:
+        if gate.name == 'H':
+            circ += H.on(gate.objs)
+        elif gate.name == 'CNOT':
+            circ += CNOT.on(gate.objs, gate.ctrls)
+        else:
+            circ += rotations[gate.name](gate.coeff).on(gate.objs)
+    return circ
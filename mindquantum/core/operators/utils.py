@@ -14,6 +14,10 @@
 #   limitations under the License.
 """This module provide some useful function related to operators."""
 
+import typing
+
+import numpy as np
+
 from ...simulator.available_simulator import SUPPORTED_SIMULATOR
 from ..operators.fermion_operator import FermionOperator
 from ..operators.polynomial_tensor import PolynomialTensor
@@ -287,17 +291,25 @@ def sz_operator(n_spatial_orbitals):
     return sz_up - sz_down
 
 
-def ground_state_of_sum_zz(ops: QubitOperator, sim='mqvector') -> float:
+def ground_state_of_sum_zz(ops: QubitOperator, sim='mqvector', return_states: bool = False):
     """
     Find the ground state energy of qubit operator that only has pauli :math:`Z` term.
 
+    The search is exact. Qubits are enumerated in Gray-code order, so that only the terms that touch the flipped qubit
+    are updated, and for large operators the leading qubits are searched with parallel branch and bound.
+
     Args:
         ops (QubitOperator): qubit operator that only has pauli :math:`Z` term.
         sim (str): use which simulator to do calculation. Currently, we support
             ``'mqvector'`` and ``'mqvector_gpu'``. Default: ``'mqvector'``.
+        return_states (bool): whether to return the computational basis states that reach the ground state energy.
+            At most 1024 degenerate states are returned. For ``'mqvector_gpu'`` the states are searched on host.
+            Default: ``False``.
 
     Returns:
-        float, the ground state energy of given qubit operator.
+        Union[float, Tuple[float, numpy.ndarray]], the ground state energy of given qubit operator. If
+        `return_states` is ``True``, the sorted integer indices of ground states are also returned, where bit
+        :math:`i` of an index is the value of qubit :math:`i`.
 
     Examples:
         >>> from mindquantum.core.operators import ground_state_of_sum_zz, QubitOperator
@@ -307,12 +319,13 @@ def ground_state_of_sum_zz(ops: QubitOperator, sim='mqvector') -> float:
         >>> import numpy as np
         >>> np.min(np.diag(h.matrix().toarray()))
         (-2.5+0j)
+        >>> ground_state_of_sum_zz(h, return_states=True)
+        (-2.5, array([2, 5]))
     """
     # pylint: disable=import-outside-toplevel
     if sim.startswith('mqmatrix'):
         raise ValueError("mqmatrix simulator not support this method yet.")
     c_module = SUPPORTED_SIMULATOR.c_module(sim)
-    ground_state_of_zs = getattr(c_module, "ground_state_of_zs")
     masks_value = {}
     terms = ops.terms
     for k, v in terms.items():
@@ -322,4 +335,152 @@ def ground_state_of_sum_zz(ops: QubitOperator, sim='mqvector') -> float:
                 raise ValueError("ops should contains only pauli z operator.")
             mask += 1 << idx
         masks_value[mask] = v.const.real
-    return ground_state_of_zs(masks_value, ops.count_qubits())
+    if return_states:
+        if not hasattr(c_module, "ground_states_of_zs"):
+            raise ValueError(f"{sim} simulator does not support return_states.")
+        energy, states = getattr(c_module, "ground_states_of_zs")(masks_value, ops.count_qubits(), 1024)
+        return energy, np.array(states)
+    return getattr(c_module, "ground_state_of_zs")(masks_value, ops.count_qubits())
+
+
+def group_commuting_terms(ops: QubitOperator, qubit_wise: bool = True):
+    """
+    Partition the terms of a qubit operator into groups that can be measured simultaneously.
+
+    Terms are packed into pauli bit masks and the conflict graph of terms is coloured natively. For every group, a
+    basis rotation circuit of Clifford gates is also constructed, after which every term of the group is a product of
+    pauli :math:`Z` operators, so that the expectation of all terms can be estimated from the same sampling result.
+
+    Args:
+        ops (QubitOperator): the qubit operator to partition.
+        qubit_wise (bool): If ``True``, terms of a group act with the same pauli operator on every qubit they share,
+            and the rotation only has single qubit gates. Otherwise, terms of a group only need to commute, which
+            gives fewer groups but the rotation may contain two qubit gates. Default: ``True``.
+
+    Returns:
+        List[Tuple[QubitOperator, Circuit, List[Tuple[int, List[int]]]]], every group as a qubit operator, its basis
+        rotation circuit, and for every term of the group in order of `terms`, the sign and the qubits whose
+        :math:`Z` parity the term becomes after rotation.
+
+    Examples:
+        >>> from mindquantum.core.operators import QubitOperator, group_commuting_terms
+        >>> ops = QubitOperator('X0 X1') + QubitOperator('Y0 Y1') + QubitOperator('Z0 Z1') + QubitOperator('X0')
+        >>> len(group_commuting_terms(ops))
+        3
+        >>> groups = group_commuting_terms(ops, qubit_wise=False)
+        >>> [len(group) for group, _, _ in groups]
+        [2, 2]
+        >>> groups[0][2]
+        [(1, [0, 1]), (1, [0])]
+    """
+    # pylint: disable=import-outside-toplevel
+    from mindquantum._math.ops import group_commuting_terms as group_commuting_terms_
+
+    if not isinstance(ops, QubitOperator):
+        raise TypeError(f"ops requires a QubitOperator, but get {type(ops)}.")
+    terms = list(ops.terms.items())
+    out = []
+    for group in group_commuting_terms_(ops, qubit_wise):
+        sub_ops = QubitOperator()
+        for idx in group.terms:
+            sub_ops += QubitOperator(' '.join(f'{term}{qubit}' for qubit, term in terms[idx][0]), terms[idx][1])
+        out.append((sub_ops, _basis_rotation_circuit(group.rotation), list(zip(group.signs, group.z_qubits))))
+    return out
+
+
+def _basis_rotation_circuit(rotation):
+    """Convert the native basis rotation gates into a circuit."""
+    # pylint: disable=import-outside-toplevel
+    from ..circuit import Circuit
+    from ..gates import CNOT, H, S, Z
+
+    circ = Circuit()
+    for gate in rotation:
+        if gate.name == 'H':
+            circ += H.on(gate.obj)
+        elif gate.name == 'Sdag':
+            circ += S.on(gate.obj).hermitian()
+        elif gate.name == 'CNOT':
+            circ += CNOT.on(gate.obj, gate.ctrls)
+        else:
+            circ += Z.on(gate.obj, gate.ctrls)
+    return circ
+
+
+def find_z2_symmetries(ops: QubitOperator):
+    """
+    Find the Z2 symmetries of a qubit operator that can be tapered off.
+
+    Terms are packed into pauli bit masks, and the pauli strings that commute with every term are found as the kernel
+    of these masks by Gaussian elimination over GF(2). Among them, a largest set of independent strings that also
+    commute with each other is kept. A Clifford rotation circuit is built, after which every symmetry generator acts
+    as a single pauli :math:`Z` on its own qubit, so that this qubit can be removed by
+    :func:`~.core.operators.taper_qubits`.
+
+    Args:
+        ops (QubitOperator): the qubit operator to analyze, usually a Hamiltonian.
+
+    Returns:
+        Tuple[List[QubitOperator], Circuit, List[int]], the symmetry generators, the Clifford rotation circuit, and
+        the qubit that every generator is mapped to.
+
+    Examples:
+        >>> from mindquantum.core.operators import QubitOperator, find_z2_symmetries
+        >>> ops = QubitOperator('Z0 Z1') + QubitOperator('X0 X1')
+        >>> generators, circ, qubits = find_z2_symmetries(ops)
+        >>> generators
+        [1 [X1 X0], 1 [Z1 Z0]]
+        >>> qubits
+        [0, 1]
+    """
+    # pylint: disable=import-outside-toplevel
+    from mindquantum._math.ops import find_z2_symmetries as find_z2_symmetries_
+
+    if not isinstance(ops, QubitOperator):
+        raise TypeError(f"ops requires a QubitOperator, but get {type(ops)}.")
+    symmetries = find_z2_symmetries_(ops)
+    generators = [QubitOperator(generator) for generator in symmetries.generators]
+    return generators, _basis_rotation_circuit(symmetries.rotation), list(symmetries.qubits)
+
+
+def taper_qubits(ops: QubitOperator, sector: typing.List[int], others: typing.List[QubitOperator] = None):
+    """
+    Remove the qubits of Z2 symmetries from a qubit operator in a given symmetry sector.
+
+    The symmetries are found by :func:`~.core.operators.find_z2_symmetries`. Every term is conjugated by the Clifford
+    rotation of symmetries, every symmetry qubit is replaced by the eigenvalue of its generator in `sector`, and the
+    remaining qubits are relabeled in order. Every tapered qubit halves the dimension of state space.
+
+    Args:
+        ops (QubitOperator): the qubit operator to taper, usually a Hamiltonian.
+        sector (List[int]): the eigenvalue, ``1`` or ``-1``, of every symmetry generator in order of
+            :func:`~.core.operators.find_z2_symmetries`.
+        others (List[QubitOperator]): other operators that commute with the symmetry generators, for example
+            observables, to be tapered in the same way. Default: ``None``.
+
+    Returns:
+        QubitOperator, the tapered operator. If `others` is not ``None``, also returns the list of tapered `others`.
+
+    Examples:
+        >>> from mindquantum.core.operators import QubitOperator, taper_qubits
+        >>> ops = QubitOperator('Z0 Z1') + QubitOperator('X0 X1')
+        >>> taper_qubits(ops, [1, 1])
+        2 []
+    """
+    # pylint: disable=import-outside-toplevel
+    from mindquantum._math.ops import find_z2_symmetries as find_z2_symmetries_
+    from mindquantum._math.ops import taper_operator
+
+    if not isinstance(ops, QubitOperator):
+        raise TypeError(f"ops requires a QubitOperator, but get {type(ops)}.")
+    symmetries = find_z2_symmetries_(ops)
+    sector = list(sector)
+    out = QubitOperator(taper_operator(ops, symmetries, sector))
+    if others is None:
+        return out
+    tapered_others = []
+    for other in others:
+        if not isinstance(other, QubitOperator):
+            raise TypeError(f"others requires a list of QubitOperator, but get {type(other)}.")
+        tapered_others.append(QubitOperator(taper_operator(other, symmetries, sector)))
+    return out, tapered_others
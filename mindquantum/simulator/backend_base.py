@@ -59,6 +59,14 @@ class BackendBase:
         """Apply a hamiltonian."""
         raise NotImplementedError(f"apply_hamiltonian not implemented for {self.device_name()}")
 
+    def apply_hamiltonian_evolution(self, hamiltonian: Hamiltonian, time: float, tol: float = 1e-8):
+        """Evolve the quantum state under a hamiltonian."""
+        raise NotImplementedError(f"apply_hamiltonian_evolution not implemented for {self.device_name()}")
+
+    def solve_lowest_eigenstates(self, hamiltonian: Hamiltonian, k: int = 1, tol: float = 1e-8):
+        """Solve the lowest eigenvalues and eigenstates of a hamiltonian."""
+        raise NotImplementedError(f"solve_lowest_eigenstates not implemented for {self.device_name()}")
+
     def astype(self, dtype, seed):
         """Convert simulator to other data type."""
         raise NotImplementedError(f"astype not implement for {self.device_name()}")
@@ -101,6 +109,10 @@ class BackendBase:
         """Get quantum state."""
         raise NotImplementedError(f"get_qs not implemented for {self.device_name()}")
 
+    def post_select(self, projector):
+        """Project the quantum state with given projector and renormalize it."""
+        raise NotImplementedError(f"post_select not implemented for {self.device_name()}")
+
     def reset(self):
         """Reset backend to quantum zero state."""
         raise NotImplementedError(f"reset not implemented for {self.device_name()}")
@@ -13,6 +13,7 @@
 # limitations under the License.
 # ============================================================================
 """Mindquantum simulator."""
+import numbers
 from typing import Dict, Iterable, List, Union
 
 import numpy as np
@@ -21,7 +22,7 @@ from scipy.linalg import eigvals
 import mindquantum as mq
 from mindquantum.core.circuit import Circuit
 from mindquantum.core.gates import BarrierGate, BasicGate, Measure, MeasureResult
-from mindquantum.core.operators import Hamiltonian
+from mindquantum.core.operators import Hamiltonian, Projector
 from mindquantum.core.parameterresolver import ParameterResolver
 from mindquantum.dtype import complex128
 from mindquantum.dtype.dtype import mq_complex_number_type
@@ -34,6 +35,7 @@ from mindquantum.utils.type_value_check import (
     _check_input_type,
     _check_int_type,
     _check_mq_type,
+    _check_projector_qubits_number,
     _check_seed,
     _check_value_should_not_less,
 )
@@ -135,6 +137,46 @@ class MQSim(BackendBase):
         _check_hamiltonian_qubits_number(hamiltonian, self.n_qubits)
         self.sim.apply_hamiltonian(hamiltonian.get_cpp_obj())
 
+    def apply_hamiltonian_evolution(self, hamiltonian: Hamiltonian, time: float, tol: float = 1e-8):
+        """Evolve the quantum state under a hamiltonian."""
+        if not self.name.startswith('mqvector'):
+            raise NotImplementedError(f"apply_hamiltonian_evolution not implemented for {self.device_name()}")
+        if not mq.is_same_precision(self.dtype, hamiltonian.dtype):
+            raise TypeError(
+                f"Data type of {self.name} simulator is {mq.precision_str(self.dtype)} ({self.dtype}), "
+                f"but given hamiltonian is {mq.precision_str(hamiltonian.dtype)} ({hamiltonian.dtype}). "
+                f"Please convert given hamiltonian to {mq.precision_str(self.dtype)} "
+                f"({mq.to_precision_like(hamiltonian.dtype, self.dtype)})."
+            )
+        _check_input_type('hamiltonian', Hamiltonian, hamiltonian)
+        _check_hamiltonian_qubits_number(hamiltonian, self.n_qubits)
+        _check_input_type('time', numbers.Real, time)
+        _check_input_type('tol', numbers.Real, tol)
+        if tol <= 0:
+            raise ValueError(f"tol must be greater than 0, but get {tol}.")
+        self.sim.apply_hamiltonian_evolution(hamiltonian.get_cpp_obj(), time, tol)
+
+    def solve_lowest_eigenstates(self, hamiltonian: Hamiltonian, k: int = 1, tol: float = 1e-8):
+        """Solve the lowest eigenvalues and eigenstates of a hamiltonian."""
+        if not self.name.startswith('mqvector'):
+            raise NotImplementedError(f"solve_lowest_eigenstates not implemented for {self.device_name()}")
+        if not mq.is_same_precision(self.dtype, hamiltonian.dtype):
+            raise TypeError(
+                f"Data type of {self.name} simulator is {mq.precision_str(self.dtype)} ({self.dtype}), "
+                f"but given hamiltonian is {mq.precision_str(hamiltonian.dtype)} ({hamiltonian.dtype}). "
+                f"Please convert given hamiltonian to {mq.precision_str(self.dtype)} "
+                f"({mq.to_precision_like(hamiltonian.dtype, self.dtype)})."
+            )
+        _check_input_type('hamiltonian', Hamiltonian, hamiltonian)
+        _check_hamiltonian_qubits_number(hamiltonian, self.n_qubits)
+        _check_int_type('k', k)
+        _check_value_should_not_less('k', 1, k)
+        _check_input_type('tol', numbers.Real, tol)
+        if tol <= 0:
+            raise ValueError(f"tol must be greater than 0, but get {tol}.")
+        eigvals, eigstates = self.sim.solve_lowest_eigenstates(hamiltonian.get_cpp_obj(), k, tol)
+        return np.array(eigvals), np.array(eigstates).T
+
     def astype(self, dtype, seed):
         """Convert simulator to other type."""
         _check_mq_type(dtype)
@@ -168,6 +210,8 @@ class MQSim(BackendBase):
         self, hamiltonian: Hamiltonian, circ_right=None, circ_left=None, simulator_left=None, pr=None
     ) -> np.ndarray:
         """Get expectation of a hamiltonian."""
+        if isinstance(hamiltonian, Projector):
+            return self._get_projector_expectation(hamiltonian, circ_right, circ_left, simulator_left, pr)
         if not isinstance(hamiltonian, Hamiltonian):
             raise TypeError(f"hamiltonian requires a Hamiltonian, but got {type(hamiltonian)}")
         _check_hamiltonian_qubits_number(hamiltonian, self.n_qubits)
@@ -215,6 +259,20 @@ class MQSim(BackendBase):
             hamiltonian.get_cpp_obj(), circ_right.get_cpp_obj(), circ_left.get_cpp_obj(), simulator_left.backend.sim, pr
         )
 
+    # pylint: disable=too-many-arguments
+    def _get_projector_expectation(self, projector: Projector, circ_right, circ_left, simulator_left, pr) -> float:
+        """Get the probability of current quantum state survives the given projector."""
+        _check_projector_qubits_number(projector, self.n_qubits)
+        if circ_left is not None or simulator_left is not None:
+            raise ValueError("Expectation of projector only supports circ_right.")
+        if circ_right is None:
+            circ_right = Circuit()
+        if pr is None:
+            pr = ParameterResolver()
+        else:
+            pr = ParameterResolver(pr)
+        return self.sim.get_projector_expectation(projector.get_cpp_obj(), circ_right.get_cpp_obj(), pr)
+
     def get_expectation_with_grad(  # pylint: disable=R0912,R0913,R0914,R0915
         self,
         hams: List[Hamiltonian],
@@ -410,6 +468,12 @@ class MQSim(BackendBase):
             return '\n'.join(ket_string(state))
         return state
 
+    def post_select(self, projector: Projector) -> float:
+        """Project the quantum state with given projector and renormalize it."""
+        _check_input_type('projector', Projector, projector)
+        _check_projector_qubits_number(projector, self.n_qubits)
+        return self.sim.post_select(projector.get_cpp_obj())
+
     def reset(self):
         """Reset mindquantum simulator to quantum zero state."""
         return self.sim.reset()
@@ -211,6 +211,33 @@ class Simulator:
         """
         self.backend.apply_hamiltonian(hamiltonian)
 
+    def apply_hamiltonian_evolution(self, hamiltonian: Hamiltonian, time: float, tol: float = 1e-8):
+        r"""
+        Evolve the quantum state under a hermitian hamiltonian.
+
+        .. math::
+
+            \left|\psi\right>\to\exp(-iHt)\left|\psi\right>
+
+        The evolution is done with adaptive short-iterative Lanczos method, so that the matrix exponential is never
+        constructed. Only the `mqvector` and `mqvector_gpu` simulators support this method.
+
+        Args:
+            hamiltonian (Hamiltonian): the hermitian hamiltonian that drives the evolution.
+            time (numbers.Real): the evolution time.
+            tol (numbers.Real): the error tolerance of every Lanczos step, should be positive. Default: ``1e-8``.
+
+        Examples:
+            >>> from mindquantum.core.operators import QubitOperator, Hamiltonian
+            >>> from mindquantum.simulator import Simulator
+            >>> import numpy as np
+            >>> sim = Simulator('mqvector', 1)
+            >>> sim.apply_hamiltonian_evolution(Hamiltonian(QubitOperator('X0')), np.pi / 4)
+            >>> sim.get_qs()
+            array([0.70710678+0.j        , 0.        -0.70710678j])
+        """
+        self.backend.apply_hamiltonian_evolution(hamiltonian, time, tol)
+
     def astype(self, dtype, seed=None):
         """
         Convert simulator to other data type.
@@ -264,8 +291,11 @@ class Simulator:
         and :math:`\left|\psi\right>` is the current quantum state of this simulator,
         and :math:`\left|\varphi\right>` is the quantum state of `simulator_left`.
 
+        If `hamiltonian` is a :class:`~.core.operators.Projector`, the probability that the quantum state evolved
+        by `circ_right` survives this projector is returned, and `circ_left` and `simulator_left` should be ``None``.
+
         Args:
-            hamiltonian (Hamiltonian): The hamiltonian you want to get expectation.
+            hamiltonian (Union[Hamiltonian, Projector]): The hamiltonian you want to get expectation.
             circ_right (Circuit): The :math:`U_r` circuit described above. If it is ``None``,
                 we will use empty circuit. Default: ``None``.
             circ_left (Circuit): The :math:`U_l` circuit described above. If it is ``None``,
@@ -401,6 +431,33 @@ class Simulator:
         """
         return self.backend.get_qs(ket)
 
+    def post_select(self, projector):
+        r"""
+        Project the quantum state of this simulator with given projector and renormalize it.
+
+        The quantum state will become :math:`\Pi\left|\psi\right>/\sqrt{p}`, where :math:`\Pi` is the projector and
+        :math:`p=\left<\psi\right|\Pi\left|\psi\right>` is the success probability of this post selection.
+
+        Args:
+            projector (Projector): The projector that select the quantum state. The lower index qubit is at the
+                right end of string format of projector, and qubits not covered by projector are not selected.
+
+        Returns:
+            float, the success probability of this post selection.
+
+        Examples:
+            >>> from mindquantum.core.circuit import Circuit
+            >>> from mindquantum.core.operators import Projector
+            >>> from mindquantum.simulator import Simulator
+            >>> sim = Simulator('mqvector', 2)
+            >>> sim.apply_circuit(Circuit().h(0).x(1, 0))
+            >>> round(sim.post_select(Projector('I1')), 6)
+            0.5
+            >>> sim.get_qs()
+            array([0.+0.j, 0.+0.j, 0.+0.j, 1.+0.j])
+        """
+        return self.backend.post_select(projector)
+
     def reset(self):
         """
         Reset simulator to zero state.
@@ -488,6 +545,38 @@ class Simulator:
         """
         return self.backend.set_threads_number(number)
 
+    def solve_lowest_eigenstates(self, hamiltonian: Hamiltonian, k: int = 1, tol: float = 1e-8):
+        """
+        Solve the lowest k eigenvalues and eigenstates of a hermitian hamiltonian with thick-restart Lanczos method.
+
+        The Lanczos iteration starts from the current quantum state of this simulator, so only eigenstates that
+        overlap with the current state can be found. For example, starting from a Hartree-Fock state restricts the
+        search to the corresponding particle number sector. After solving, the quantum state of this simulator is set
+        to the ground state. Only the `mqvector` and `mqvector_gpu` simulators support this method.
+
+        Args:
+            hamiltonian (Hamiltonian): the hermitian hamiltonian.
+            k (int): the number of eigenpairs to solve. Default: ``1``.
+            tol (numbers.Real): the tolerance of residual norm of every eigenpair, should be positive.
+                Default: ``1e-8``.
+
+        Returns:
+            Tuple[numpy.ndarray, numpy.ndarray], the eigenvalues in ascending order, and the eigenstates where the
+            column ``i`` is the eigenstate of the ``i``-th eigenvalue.
+
+        Examples:
+            >>> from mindquantum.core.circuit import Circuit
+            >>> from mindquantum.core.operators import QubitOperator, Hamiltonian
+            >>> from mindquantum.simulator import Simulator
+            >>> sim = Simulator('mqvector', 2)
+            >>> sim.apply_circuit(Circuit().h(0).h(1))
+            >>> ham = Hamiltonian(QubitOperator('Z0 Z1') + QubitOperator('X0', 0.5))
+            >>> eigvals, _ = sim.solve_lowest_eigenstates(ham)
+            >>> eigvals
+            array([-1.11803399])
+        """
+        return self.backend.solve_lowest_eigenstates(hamiltonian, k, tol)
+
     def get_partial_trace(self, obj_qubits):
         """
         Calculate the partial trace of current density matrix.
@@ -63,6 +63,12 @@ def _check_hamiltonian_qubits_number(hamiltonian, sim_qubits):
             raise ValueError(f"Hamiltonian qubits is {hamiltonian.n_qubits}, which is bigger than simulator qubits.")
 
 
+def _check_projector_qubits_number(projector, sim_qubits):
+    """Check projector qubits number."""
+    if projector.n_qubits > sim_qubits:
+        raise ValueError(f"Projector qubits is {projector.n_qubits}, which is bigger than simulator qubits.")
+
+
 def _check_np_dtype(dtype):
     """Check dtype is a valid numpy dtype."""
     np.array([0], dtype=dtype)
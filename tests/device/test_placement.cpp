@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "device/placement.h"
+#include "device/topology.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+namespace mm = mindquantum::mapping;
+
+using interactions_t = mm::VT<std::pair<int, int>>;
+
+static bool IsPermutation(const mm::VT<int>& layout, int n) {
+    auto sorted = layout;
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < n; i++) {
+        if (sorted[i] != i) {
+            return false;
+        }
+    }
+    return static_cast<int>(layout.size()) == n;
+}
+
+TEST_CASE("PerfectLayout embeds a chain into a grid", "[placement]") {
+    mm::GridQubits grid(2, 3);
+    auto topology = grid.Compile();
+    interactions_t chain = {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {1, 2}};
+    auto layout = mm::PerfectLayout(5, chain, *topology, 1.0);
+    REQUIRE(IsPermutation(layout, 6));
+    for (auto [a, b] : chain) {
+        CHECK(topology->IsCoupled(layout[a], layout[b]));
+    }
+    CHECK(mm::PerfectLayout(5, chain, *topology, 0.0).empty());
+}
+
+TEST_CASE("PerfectLayout gives up on circuits that can not be embedded", "[placement]") {
+    mm::GridQubits grid(3, 3);
+    auto topology = grid.Compile();
+    interactions_t triangle = {{0, 1}, {1, 2}, {2, 0}};
+    CHECK(mm::PerfectLayout(3, triangle, *topology, 1.0).empty());
+}
+
+TEST_CASE("PerfectLayout takes the layout with lowest cost", "[placement]") {
+    mm::LinearQubits line(4);
+    auto topology = line.Compile();
+    mm::DistanceMatrix<double> cost(4, 1.0);
+    cost[2][3] = cost[3][2] = 0.1;
+    interactions_t pair = {{0, 1}, {0, 1}};
+    auto layout = mm::PerfectLayout(2, pair, *topology, 1.0, &cost);
+    REQUIRE(IsPermutation(layout, 4));
+    CHECK(std::min(layout[0], layout[1]) == 2);
+    CHECK(std::max(layout[0], layout[1]) == 3);
+}
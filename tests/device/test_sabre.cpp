@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "core/mq_base_types.h"
+#include "device/mapping.h"
+#include "device/topology.h"
+#include "ops/basic_gate.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+namespace mm = mindquantum::mapping;
+
+using circuit_t = mm::VT<std::shared_ptr<mindquantum::BasicGate>>;
+
+namespace {
+std::shared_ptr<mindquantum::BasicGate> CNOT(mindquantum::qbit_t obj, mindquantum::qbit_t ctrl) {
+    return std::make_shared<mindquantum::XGate>(mindquantum::qbits_t{obj}, mindquantum::qbits_t{ctrl});
+}
+
+// Every two qubit gate and SWAP of a routed circuit acts on coupled physical qubits.
+void CheckRouted(const mm::VT<mm::VT<int>>& gates, const mm::TopologyCSR& topology) {
+    for (const auto& g : gates) {
+        if (g[1] != g[2]) {
+            CHECK(topology.IsCoupled(g[1], g[2]));
+        }
+    }
+}
+}  // namespace
+
+// Expected outputs below were produced by the SABRE that scored every candidate SWAP by summing distances over the
+// whole front layer and extended set. Scoring by the change of distance must route to exactly the same circuit.
+
+TEST_CASE("SABRE routes a small circuit to a fixed output", "[sabre]") {
+    circuit_t circ = {std::make_shared<mindquantum::HGate>(mindquantum::qbits_t{0})};
+    mm::VT<std::pair<int, int>> cnots = {{0, 5}, {1, 4}, {2, 3}, {0, 3}, {5, 2},
+                                         {4, 0}, {1, 5}, {3, 4}, {2, 0}, {5, 1}};
+    for (auto [obj, ctrl] : cnots) {
+        circ.push_back(CNOT(obj, ctrl));
+    }
+    circ.push_back(std::make_shared<mindquantum::HGate>(mindquantum::qbits_t{3}));
+    auto topology = std::make_shared<mm::GridQubits>(2, 3);
+
+    mm::SABRE sabre(circ, topology);
+    auto [gates, mappings] = sabre.Solve(3, 0.5, 0.3, 0.2);
+    // Gate index (-1 for SWAP) and the physical qubits it acts on.
+    mm::VT<mm::VT<int>> expected = {{0, 3, 3}, {2, 2, 5},  {3, 1, 4},  {1, 3, 0}, {4, 3, 4}, {5, 0, 1}, {-1, 0, 1},
+                                    {7, 2, 1}, {10, 1, 2}, {-1, 4, 5}, {6, 4, 3}, {8, 5, 4}, {9, 0, 3}, {11, 5, 5}};
+    CHECK(gates == expected);
+    CHECK(mappings.first == mm::VT<int>{3, 2, 1, 4, 5, 0});
+    CHECK(mappings.second == mm::VT<int>{3, 2, 0, 5, 4, 1});
+    CheckRouted(gates, *topology->Compile());
+}
+
+TEST_CASE("SABRE routes a random circuit to a fixed output", "[sabre]") {
+    circuit_t circ;
+    uint64_t state = 12345;
+    for (int i = 0; i < 200; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        auto obj = static_cast<int>((state >> 33) % 16);
+        auto ctrl = static_cast<int>((state >> 17) % 15);
+        if (ctrl >= obj) {
+            ctrl++;
+        }
+        circ.push_back(CNOT(obj, ctrl));
+    }
+    auto topology = std::make_shared<mm::GridQubits>(4, 4);
+
+    mm::SABRE sabre(circ, topology);
+    auto [gates, mappings] = sabre.Solve(3, 0.5, 0.3, 0.2);
+    CheckRouted(gates, *topology->Compile());
+    CHECK(mappings.first == mm::VT<int>{2, 8, 7, 11, 4, 1, 0, 14, 9, 10, 5, 3, 13, 12, 15, 6});
+
+    // The routed circuit is too long to spell out, compare its SWAP count and a FNV-1a hash of all gates.
+    int n_swap = 0;
+    uint64_t hash = 1469598103934665603ULL;
+    for (const auto& g : gates) {
+        n_swap += g[0] < 0 ? 1 : 0;
+        for (auto v : g) {
+            hash ^= static_cast<uint64_t>(static_cast<int64_t>(v));
+            hash *= 1099511628211ULL;
+        }
+    }
+    CHECK(gates.size() == 423);
+    CHECK(n_swap == 223);
+    CHECK(hash == 18188955994544173768ULL);
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "math/pr/parameter_resolver.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+using parameter::ParameterResolver;
+
+namespace {
+double Value(const parameter::tn::Tensor& t) {
+    return tensor::ops::cpu::to_vector<double>(t)[0];
+}
+}  // namespace
+
+TEST_CASE("ParameterResolver equality compares coefficients of both sides", "[parameter_resolver]") {
+    auto a = ParameterResolver(1.0, std::map<std::string, double>{{"pr_eq_a", 1.0}, {"pr_eq_b", 2.0}});
+    auto same = ParameterResolver(1.0, std::map<std::string, double>{{"pr_eq_b", 2.0}, {"pr_eq_a", 1.0}});
+    auto other_coeff = ParameterResolver(1.0, std::map<std::string, double>{{"pr_eq_a", 1.0}, {"pr_eq_b", 3.0}});
+    auto other_name = ParameterResolver(1.0, std::map<std::string, double>{{"pr_eq_a", 1.0}, {"pr_eq_c", 2.0}});
+    auto other_const = ParameterResolver(0.5, std::map<std::string, double>{{"pr_eq_a", 1.0}, {"pr_eq_b", 2.0}});
+    // operator== is not const, so compare before handing the result to Catch.
+    bool eq_same = a == same;
+    bool ne_same = a != same;
+    bool eq_other_coeff = a == other_coeff;
+    bool eq_other_coeff_rev = other_coeff == a;
+    bool eq_other_name = a == other_name;
+    bool eq_other_const = a == other_const;
+    CHECK(eq_same);
+    CHECK_FALSE(ne_same);
+    CHECK_FALSE(eq_other_coeff);
+    CHECK_FALSE(eq_other_coeff_rev);
+    CHECK_FALSE(eq_other_name);
+    CHECK_FALSE(eq_other_const);
+}
+
+TEST_CASE("ParameterResolver keeps parameter flags when a constant is multiplied in place", "[parameter_resolver]") {
+    auto rhs = ParameterResolver(1.0, std::map<std::string, double>{{"pr_mul_x", 2.0}, {"pr_mul_y", 3.0}},
+                                 std::set<std::string>{"pr_mul_x"}, std::set<std::string>{"pr_mul_y"});
+    auto lhs = ParameterResolver(2.0);
+    lhs *= rhs;
+    CHECK(lhs.GetAllParameters() == std::set<std::string>{"pr_mul_x", "pr_mul_y"});
+    CHECK(lhs.GetNoGradParameters() == std::set<std::string>{"pr_mul_x"});
+    CHECK(lhs.GetEncoderParameters() == std::set<std::string>{"pr_mul_y"});
+    CHECK(Value(lhs.GetItem("pr_mul_x")) == 4.0);
+    CHECK(Value(lhs.GetItem("pr_mul_y")) == 6.0);
+    CHECK(Value(lhs.const_value) == 2.0);
+
+    auto product = ParameterResolver(2.0) * rhs;
+    bool eq_product = product == lhs;
+    CHECK(eq_product);
+    CHECK(product.GetNoGradParameters() == std::set<std::string>{"pr_mul_x"});
+    CHECK(product.GetEncoderParameters() == std::set<std::string>{"pr_mul_y"});
+}
+
+TEST_CASE("ParameterResolver returns parameter names sorted by name", "[parameter_resolver]") {
+    // Interned in an order different from the order of names.
+    auto pr = ParameterResolver(0.0, std::map<std::string, double>{{"pr_order_zeta", 1.0}});
+    pr.SetItem("pr_order_alpha", 2.0);
+    pr.SetItem("pr_order_mid", 3.0);
+    CHECK(pr.ParamsName() == std::vector<std::string>{"pr_order_alpha", "pr_order_mid", "pr_order_zeta"});
+    auto values = pr.ParaValue();
+    REQUIRE(values.size() == 3);
+    CHECK(Value(values[0]) == 2.0);
+    CHECK(Value(values[1]) == 3.0);
+    CHECK(Value(values[2]) == 1.0);
+}
@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "math/operators/utils.h"
+#include "math/pr/parameter_resolver.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+using term_key_t = operators::key_t;
+using operators::QTerm_t;
+using parameter::ParameterResolver;
+
+namespace {
+double Coeff(const ParameterResolver& pr) {
+    return tensor::ops::cpu::to_vector<std::complex<double>>(pr.const_value)[0].real();
+}
+
+// Keys of one and two words, so that equal hashes of different lengths are compared too.
+term_key_t Key(uint64_t i) {
+    if (i % 3 == 0) {
+        return {i, i * 7 + 1};
+    }
+    return {i};
+}
+
+// Reference terms in insertion order, an inserted key that already exists moves to the end.
+class Model {
+ public:
+    void insert(const term_key_t& key, double value) {
+        erase(key);
+        terms.emplace_back(key, value);
+    }
+    void set(const term_key_t& key, double value) {
+        auto it = std::find_if(terms.begin(), terms.end(), [&](const auto& t) { return t.first == key; });
+        if (it == terms.end()) {
+            terms.emplace_back(key, value);
+        } else {
+            it->second = value;
+        }
+    }
+    void erase(const term_key_t& key) {
+        terms.erase(std::remove_if(terms.begin(), terms.end(), [&](const auto& t) { return t.first == key; }),
+                    terms.end());
+    }
+    std::vector<std::pair<term_key_t, double>> terms;
+};
+
+void CheckSame(const QTerm_t& qterm, const Model& model, uint64_t n_keys) {
+    REQUIRE(qterm.size() == model.terms.size());
+    auto it = model.terms.begin();
+    for (const auto& [key, value] : qterm) {
+        CHECK(key == it->first);
+        CHECK(Coeff(value) == it->second);
+        ++it;
+    }
+    for (uint64_t i = 0; i < n_keys; i++) {
+        auto key = Key(i);
+        auto found = std::find_if(model.terms.begin(), model.terms.end(),
+                                  [&](const auto& t) { return t.first == key; });
+        if (found == model.terms.end()) {
+            CHECK_FALSE(qterm.contains(key));
+            CHECK_THROWS_AS(qterm.at(key), std::out_of_range);
+        } else {
+            REQUIRE(qterm.contains(key));
+            CHECK(Coeff(qterm.at(key)) == found->second);
+        }
+    }
+}
+}  // namespace
+
+TEST_CASE("QTerm_t finds every term after the table grows", "[qterm]") {
+    QTerm_t qterm;
+    Model model;
+    uint64_t n_keys = 200;
+    for (uint64_t i = 0; i < n_keys; i++) {
+        qterm.insert(Key(i), ParameterResolver(static_cast<double>(i)));
+        model.insert(Key(i), static_cast<double>(i));
+        // The table doubles at 12, 24, 48, ... terms, check that the terms before are still found after each.
+        CheckSame(qterm, model, n_keys);
+    }
+
+    qterm.reserve(5000);
+    CheckSame(qterm, model, n_keys);
+    qterm.set(Key(n_keys), ParameterResolver(-1.0));
+    model.set(Key(n_keys), -1.0);
+    CheckSame(qterm, model, n_keys + 1);
+    // Setting an existing key keeps its position.
+    qterm.set(Key(3), ParameterResolver(-3.0));
+    model.set(Key(3), -3.0);
+    CheckSame(qterm, model, n_keys + 1);
+}
+
+TEST_CASE("QTerm_t keeps insertion order through erase heavy sequences", "[qterm]") {
+    std::mt19937 engine(42);
+    QTerm_t qterm;
+    Model model;
+    uint64_t n_keys = 600;
+    std::vector<uint64_t> order(n_keys);
+    for (uint64_t i = 0; i < n_keys; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), engine);
+    for (auto i : order) {
+        qterm.insert(Key(i), ParameterResolver(static_cast<double>(i)));
+        model.insert(Key(i), static_cast<double>(i));
+    }
+
+    // Erase most of the terms, dead terms outnumber live ones many times and the storage is compacted on the way.
+    std::shuffle(order.begin(), order.end(), engine);
+    for (uint64_t n = 0; n < n_keys - 20; n++) {
+        qterm.erase(Key(order[n]));
+        model.erase(Key(order[n]));
+        if (n % 50 == 0) {
+            CheckSame(qterm, model, n_keys);
+        }
+    }
+    CheckSame(qterm, model, n_keys);
+    // Erasing a missing key changes nothing.
+    qterm.erase(Key(order[0]));
+    CheckSame(qterm, model, n_keys);
+
+    // Erased keys come back at the end, after the survivors.
+    for (uint64_t n = 0; n < 100; n++) {
+        qterm.insert(Key(order[n]), ParameterResolver(-static_cast<double>(n)));
+        model.insert(Key(order[n]), -static_cast<double>(n));
+    }
+    CheckSame(qterm, model, n_keys);
+}
+
+TEST_CASE("QTerm_t moves replaced terms to the end", "[qterm]") {
+    std::mt19937 engine(7);
+    QTerm_t qterm;
+    Model model;
+    uint64_t n_keys = 64;
+    for (uint64_t i = 0; i < n_keys; i++) {
+        qterm.insert(Key(i), ParameterResolver(static_cast<double>(i)));
+        model.insert(Key(i), static_cast<double>(i));
+    }
+    // Every replacement leaves a dead term behind, so appends compact the storage many times over.
+    for (int n = 0; n < 2000; n++) {
+        auto i = engine() % n_keys;
+        auto value = static_cast<double>(n);
+        if (engine() % 4 == 0) {
+            qterm.erase(Key(i));
+            model.erase(Key(i));
+        } else {
+            qterm.insert(Key(i), ParameterResolver(value));
+            model.insert(Key(i), value);
+        }
+        if (n % 100 == 0) {
+            CheckSame(qterm, model, n_keys);
+        }
+    }
+    CheckSame(qterm, model, n_keys);
+
+    qterm.clear();
+    model.terms.clear();
+    CheckSame(qterm, model, n_keys);
+    qterm.insert(Key(1), ParameterResolver(1.0));
+    model.insert(Key(1), 1.0);
+    CheckSame(qterm, model, n_keys);
+}
+
+TEST_CASE("QTerm_t keeps numeric coefficients until a symbolic one is stored", "[qterm]") {
+    QTerm_t qterm;
+    qterm.insert(Key(0), ParameterResolver(tensor::Tensor(1.5, tensor::TDtype::Float32)));
+    qterm.insert(Key(1), ParameterResolver(tensor::Tensor(std::complex<double>(1, 2))));
+    qterm.accumulate(Key(2), ParameterResolver(0.25), tensor::TDtype::Float64, true);
+    CHECK(qterm.numeric());
+    CHECK(qterm.upper_dtype(tensor::TDtype::Float32) == tensor::TDtype::Complex128);
+
+    // Accumulating keeps the term in place at the given dtype, a real dtype only takes the real part.
+    qterm.accumulate(Key(1), ParameterResolver(tensor::Tensor(std::complex<double>(0.5, 7))), tensor::TDtype::Complex128);
+    qterm.accumulate(Key(0), ParameterResolver(tensor::Tensor(std::complex<double>(1, 9))), tensor::TDtype::Float64);
+    std::vector<std::complex<double>> values;
+    std::vector<tensor::TDtype> dtypes;
+    for (const auto& [key, value] : qterm) {
+        values.push_back(tensor::ops::cpu::to_vector<std::complex<double>>(value.const_value)[0]);
+        dtypes.push_back(value.GetDtype());
+    }
+    CHECK(values == std::vector<std::complex<double>>{{2.5, 0}, {1.5, 9}, {-0.25, 0}});
+    CHECK(dtypes == std::vector<tensor::TDtype>{tensor::TDtype::Float64, tensor::TDtype::Complex128,
+                                                tensor::TDtype::Float64});
+    qterm.accumulate(Key(2), ParameterResolver(0.25), tensor::TDtype::Float64);
+    CHECK_FALSE(qterm.contains(Key(2)));
+
+    // A parameter with zero coefficient is still a parameter.
+    auto zero_a = ParameterResolver(std::string("a")) * ParameterResolver(0.0);
+    qterm.set(Key(5), zero_a);
+    CHECK_FALSE(qterm.numeric());
+    CHECK(qterm.at(Key(5)).Contains("a"));
+    CHECK(qterm.at(Key(0)).GetDtype() == tensor::TDtype::Float64);
+    CHECK(Coeff(qterm.at(Key(0))) == 2.5);
+    CHECK(tensor::ops::cpu::to_vector<std::complex<double>>(qterm.at(Key(1)).const_value)[0]
+          == std::complex<double>(1.5, 9));
+    std::vector<term_key_t> keys;
+    for (const auto& [key, value] : qterm) {
+        keys.push_back(key);
+    }
+    CHECK(keys == std::vector<term_key_t>{Key(0), Key(1), Key(5)});
+
+    qterm.clear();
+    qterm.insert(Key(1), ParameterResolver(1.0));
+    CHECK(qterm.numeric());
+}
+
+TEST_CASE("QTerm_t accumulates numeric and symbolic tables alike", "[qterm]") {
+    std::mt19937 engine(3);
+    for (bool symbolic : {false, true}) {
+        QTerm_t lhs;
+        QTerm_t rhs;
+        QTerm_t expected;
+        for (int n = 0; n < 300; n++) {
+            auto key = Key(engine() % 80);
+            auto value = ParameterResolver(static_cast<double>(engine() % 7) - 3);
+            auto& target = n % 2 == 0 ? lhs : rhs;
+            target.accumulate(key, value, tensor::TDtype::Float64);
+            if (n % 2 == 0) {
+                expected.accumulate(key, value, tensor::TDtype::Float64);
+            }
+        }
+        if (symbolic) {
+            rhs.set(Key(1000), ParameterResolver(std::string("a")));
+        }
+        for (const auto& [key, value] : rhs) {
+            expected.accumulate(key, value, tensor::TDtype::Float64, true);
+        }
+        lhs.accumulate(rhs, tensor::TDtype::Float64, true);
+        CHECK(lhs.numeric() == !symbolic);
+        REQUIRE(lhs.size() == expected.size());
+        auto it = expected.begin();
+        for (const auto& [key, value] : lhs) {
+            CHECK(key == it->first);
+            // ParameterResolver::operator== is not const.
+            auto got = value;
+            bool same = got == it->second;
+            CHECK(same);
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <string>
+
+#include "math/operators/qubit_operator_view.h"
+#include "math/operators/utils.h"
+#include "math/pr/parameter_resolver.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+using operators::qubit::QubitOperator;
+using operators::qubit::SinglePauliStr;
+using operators::qubit::TermValue;
+using parameter::ParameterResolver;
+
+namespace {
+std::complex<double> Coeff(const ParameterResolver& pr) {
+    return tensor::ops::cpu::to_vector<std::complex<double>>(pr.const_value)[0];
+}
+
+// Product by the serial path of parameterized operators.
+QubitOperator SerialProduct(const QubitOperator& lhs, const QubitOperator& rhs) {
+    QubitOperator out;
+    out.dtype = lhs.dtype;
+    for (const auto& l_term : lhs.terms) {
+        for (const auto& r_term : rhs.terms) {
+            auto new_term = SinglePauliStr::Mul(l_term, r_term);
+            operators::AccumulateTerm(&out, new_term.first, new_term.second);
+        }
+    }
+    return out;
+}
+
+void CheckSameProduct(const QubitOperator& lhs, const QubitOperator& rhs) {
+    auto fast = lhs * rhs;
+    auto serial = SerialProduct(lhs, rhs);
+    REQUIRE(fast.size() == serial.size());
+    CHECK(fast.dtype == serial.dtype);
+    auto it = serial.terms.begin();
+    for (const auto& [key, value] : fast.terms) {
+        CHECK(key == it->first);
+        CHECK(std::abs(Coeff(value) - Coeff(it->second)) < 1e-12);
+        ++it;
+    }
+}
+}  // namespace
+
+TEST_CASE("Numeric product of qubit operators matches serial product", "[qubit_operator]") {
+    std::mt19937 engine(42);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    const char* paulis = "IXYZ";
+    auto random_op = [&](int n_terms) {
+        QubitOperator op;
+        for (int t = 0; t < n_terms; t++) {
+            std::string str;
+            for (int q = 0; q < 5; q++) {
+                auto p = paulis[engine() % 4];
+                if (p != 'I') {
+                    str += std::string(1, p) + std::to_string(q) + " ";
+                }
+            }
+            op += QubitOperator(str, ParameterResolver(dist(engine)));
+        }
+        return op;
+    };
+    auto lhs = random_op(40);
+    auto rhs = random_op(30);
+    CheckSameProduct(lhs, rhs);
+    CheckSameProduct(lhs, lhs);
+}
+
+TEST_CASE("Numeric product of qubit operators drops only exact zeros", "[qubit_operator]") {
+    // (X0 + Y0)^2 = 2, the products X0 Y0 = iZ0 and Y0 X0 = -iZ0 cancel exactly.
+    auto op = QubitOperator("X0", ParameterResolver(1.0)) + QubitOperator("Y0", ParameterResolver(1.0));
+    CheckSameProduct(op, op);
+    auto square = op * op;
+    CHECK(square.size() == 1);
+    CHECK(Coeff(square.get_coeff({})) == std::complex<double>(2, 0));
+
+    // (X0 + Y0)(X0 + (1 + eps) Y0) leaves i eps Z0, which is small but not round off.
+    double eps = std::ldexp(1.0, -50);
+    auto other = QubitOperator("X0", ParameterResolver(1.0)) + QubitOperator("Y0", ParameterResolver(1.0 + eps));
+    CheckSameProduct(op, other);
+    auto product = op * other;
+    CHECK(product.size() == 2);
+    auto z0 = product.get_coeff({{0, TermValue::Z}});
+    CHECK(Coeff(z0) == std::complex<double>(0, eps));
+}
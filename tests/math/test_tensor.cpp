@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "math/tensor/tensor.h"
+#include "math/tensor/traits.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+using cmplx_t = std::complex<double>;
+using tensor::TDtype;
+using tensor::Tensor;
+
+namespace {
+Tensor Make(size_t len, TDtype dtype, double shift = 0) {
+    if (dtype == TDtype::Float32 || dtype == TDtype::Float64) {
+        std::vector<double> values;
+        for (size_t i = 0; i < len; i++) {
+            values.push_back(shift + static_cast<double>(i) + 1);
+        }
+        return Tensor(values).astype(dtype);
+    }
+    std::vector<cmplx_t> values;
+    for (size_t i = 0; i < len; i++) {
+        values.emplace_back(shift + static_cast<double>(i) + 1, -static_cast<double>(i));
+    }
+    return Tensor(values).astype(dtype);
+}
+
+void CheckValues(const Tensor& t, const Tensor& expected) {
+    REQUIRE(t.dtype == expected.dtype);
+    REQUIRE(t.dim == expected.dim);
+    CHECK(tensor::ops::cpu::to_vector<cmplx_t>(t) == tensor::ops::cpu::to_vector<cmplx_t>(expected));
+}
+
+void CheckStorage(const Tensor& t) {
+    CHECK(t.is_inline() == Tensor::fits_inline(t.dim, t.dtype));
+    if (!t.is_inline()) {
+        CHECK(t.data != nullptr);
+    }
+}
+}  // namespace
+
+TEST_CASE("Tensor copy and move keep values across the inline storage boundary", "[tensor]") {
+    for (auto dtype : {TDtype::Float32, TDtype::Float64, TDtype::Complex64, TDtype::Complex128}) {
+        // Largest length that fits inline, and lengths around it.
+        size_t n_inline = Tensor::inline_capacity / tensor::bit_size(dtype);
+        for (size_t len : {size_t(1), n_inline - 1, n_inline, n_inline + 1, 2 * n_inline + 3}) {
+            auto src = Make(len, dtype);
+            auto ref = Make(len, dtype);
+            CheckStorage(src);
+            CHECK(src.is_inline() == (len <= n_inline));
+
+            Tensor copied(src);
+            CheckStorage(copied);
+            CHECK(copied.data != src.data);
+            CheckValues(copied, ref);
+
+            Tensor moved(std::move(copied));
+            CheckStorage(moved);
+            CHECK(copied.data == nullptr);
+            CheckValues(moved, ref);
+
+            // Assign over a tensor on the other side of the boundary, in both directions.
+            for (size_t other_len : {size_t(1), 2 * n_inline + 3}) {
+                auto copy_assigned = Make(other_len, dtype, 10);
+                copy_assigned = src;
+                CheckStorage(copy_assigned);
+                CHECK(copy_assigned.data != src.data);
+                CheckValues(copy_assigned, ref);
+
+                auto move_assigned = Make(other_len, dtype, 10);
+                auto tmp = src;
+                move_assigned = std::move(tmp);
+                CheckStorage(move_assigned);
+                CHECK(tmp.data == nullptr);
+                CheckValues(move_assigned, ref);
+            }
+
+            auto& alias = src;
+            src = alias;
+            CheckValues(src, ref);
+            src = std::move(alias);
+            CheckValues(src, ref);
+
+            // Writing through a copy must not reach the source.
+            auto written = src;
+            tensor::ops::cpu::set(&written, Tensor(cmplx_t(-7, 0)).astype(dtype), 0);
+            CheckValues(src, ref);
+        }
+    }
+}
+
+TEST_CASE("Tensor in a growing vector keeps inline values", "[tensor]") {
+    // Reallocation relocates every tensor, inline data must follow the object.
+    std::vector<Tensor> tensors;
+    std::vector<Tensor> refs;
+    for (size_t i = 0; i < 100; i++) {
+        auto len = i % 5 + 1;
+        auto dtype = i % 2 == 0 ? TDtype::Complex128 : TDtype::Float64;
+        tensors.push_back(Make(len, dtype, static_cast<double>(i)));
+        refs.push_back(Make(len, dtype, static_cast<double>(i)));
+    }
+    for (size_t i = 0; i < tensors.size(); i++) {
+        CheckStorage(tensors[i]);
+        CheckValues(tensors[i], refs[i]);
+    }
+    auto copies = tensors;
+    tensors.clear();
+    for (size_t i = 0; i < copies.size(); i++) {
+        CheckValues(copies[i], refs[i]);
+    }
+}
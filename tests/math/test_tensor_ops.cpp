@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "math/tensor/ops/advance_math.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "math/tensor/ops_cpu/utils.h"
+#include "math/tensor/tensor.h"
+#include "math/tensor/traits.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+using cmplx_t = std::complex<double>;
+using tensor::TDtype;
+using tensor::Tensor;
+
+namespace {
+constexpr TDtype all_dtypes[] = {TDtype::Float32, TDtype::Float64, TDtype::Complex64, TDtype::Complex128};
+
+// Odd lengths leave a remainder after every vector width, the last one also takes the parallel branch.
+const std::vector<size_t> lengths = {1, 3, 7, 17, 33, tensor::omp_threshold + 3};
+
+bool IsReal(TDtype dtype) {
+    return dtype == TDtype::Float32 || dtype == TDtype::Float64;
+}
+
+bool IsSingle(TDtype dtype) {
+    return dtype == TDtype::Float32 || dtype == TDtype::Complex64;
+}
+
+// Values are exact in single precision and never zero, so that division is defined.
+std::vector<cmplx_t> Values(size_t len, TDtype dtype, int seed) {
+    std::vector<cmplx_t> out;
+    for (size_t i = 0; i < len; i++) {
+        auto k = static_cast<double>((i * 7 + seed * 3) % 23);
+        auto re = 0.25 * k + 0.5 * seed + 1;
+        out.emplace_back(re, IsReal(dtype) ? 0.0 : 0.125 * k - 1);
+    }
+    return out;
+}
+
+Tensor Make(const std::vector<cmplx_t>& values, TDtype dtype) {
+    if (IsReal(dtype)) {
+        std::vector<double> re;
+        for (auto v : values) {
+            re.push_back(v.real());
+        }
+        return Tensor(re).astype(dtype);
+    }
+    return Tensor(values).astype(dtype);
+}
+
+void CheckClose(const Tensor& got, const std::vector<cmplx_t>& expected, TDtype dtype, bool single) {
+    REQUIRE(got.dtype == dtype);
+    REQUIRE(got.dim == expected.size());
+    auto values = tensor::ops::cpu::to_vector<cmplx_t>(got);
+    double tol = single ? 1e-5 : 1e-12;
+    size_t n_bad = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (std::abs(values[i] - expected[i]) > tol * std::max(1.0, std::abs(expected[i]))) {
+            if (n_bad == 0) {
+                UNSCOPED_INFO("first mismatch at " << i << ": " << values[i] << " vs " << expected[i]);
+            }
+            ++n_bad;
+        }
+    }
+    CHECK(n_bad == 0);
+}
+
+template <typename F>
+std::vector<cmplx_t> Map(const std::vector<cmplx_t>& a, const std::vector<cmplx_t>& b, F&& f) {
+    std::vector<cmplx_t> out;
+    for (size_t i = 0; i < a.size(); i++) {
+        out.push_back(f(a[i], b[b.size() == 1 ? 0 : i]));
+    }
+    return out;
+}
+}  // namespace
+
+TEST_CASE("Binary tensor kernels on odd lengths and mixed dtypes", "[tensor]") {
+    for (auto len : lengths) {
+        for (auto lhs_t : all_dtypes) {
+            auto a = Values(len, lhs_t, 1);
+            auto lhs = Make(a, lhs_t);
+            for (auto rhs_t : all_dtypes) {
+                auto upper_t = tensor::upper_type_v(lhs_t, rhs_t);
+                bool single = IsSingle(lhs_t) || IsSingle(rhs_t);
+                // Element by element, and a one element tensor broadcast over lhs.
+                for (size_t rhs_len : {len, size_t(1)}) {
+                    INFO("len " << len << " lhs " << int(lhs_t) << " rhs " << int(rhs_t) << " rhs_len " << rhs_len);
+                    auto b = Values(rhs_len, rhs_t, 2);
+                    auto rhs = Make(b, rhs_t);
+                    CheckClose(lhs + rhs, Map(a, b, std::plus<>()), upper_t, single);
+                    CheckClose(lhs - rhs, Map(a, b, std::minus<>()), upper_t, single);
+                    CheckClose(lhs * rhs, Map(a, b, std::multiplies<>()), upper_t, single);
+                    CheckClose(lhs / rhs, Map(a, b, std::divides<>()), upper_t, single);
+
+                    // In place kernels keep the dtype of lhs, a real lhs only takes the real part of rhs.
+                    auto cast_b = Map(b, b, [&](cmplx_t x, cmplx_t) { return IsReal(lhs_t) ? cmplx_t(x.real()) : x; });
+                    auto inplace = lhs;
+                    inplace *= rhs;
+                    inplace -= rhs;
+                    auto expected = Map(Map(a, cast_b, std::multiplies<>()), cast_b, std::minus<>());
+                    CheckClose(inplace, expected, lhs_t, single);
+                }
+                auto cast_a = Map(a, a, [&](cmplx_t x, cmplx_t) { return IsReal(rhs_t) ? cmplx_t(x.real()) : x; });
+                CheckClose(lhs.astype(rhs_t), cast_a, rhs_t, single);
+            }
+        }
+    }
+}
+
+TEST_CASE("Scalar tensor kernels on odd lengths", "[tensor]") {
+    for (auto len : lengths) {
+        for (auto dtype : all_dtypes) {
+            auto a = Values(len, dtype, 1);
+            auto t = Make(a, dtype);
+            bool single = IsSingle(dtype);
+            // A scalar operand takes part in type promotion with the dtype of its C++ type.
+            auto complex_t = tensor::upper_type_v(dtype, TDtype::Complex128);
+            auto double_t = tensor::upper_type_v(dtype, TDtype::Float64);
+            cmplx_t c(0.5, -1.5);
+            CheckClose(t * c, Map(a, {c}, std::multiplies<>()), complex_t, single);
+            CheckClose(c * t, Map(a, {c}, std::multiplies<>()), complex_t, single);
+            CheckClose(2.5 - t, Map(a, {2.5}, [](cmplx_t x, cmplx_t y) { return y - x; }), double_t, single);
+            CheckClose(3.0 / t, Map(a, {3.0}, [](cmplx_t x, cmplx_t y) { return y / x; }), double_t, single);
+            auto inplace = t;
+            inplace += 1.25;
+            CheckClose(inplace, Map(a, {1.25}, std::plus<>()), dtype, single);
+        }
+    }
+}
+
+TEST_CASE("Unary tensor kernels and vdot on odd lengths", "[tensor]") {
+    for (auto len : lengths) {
+        for (auto dtype : all_dtypes) {
+            auto a = Values(len, dtype, 1);
+            auto t = Make(a, dtype);
+            bool single = IsSingle(dtype);
+            auto real_t = tensor::ToRealType(dtype);
+            CheckClose(tensor::ops::real(t), Map(a, a, [](cmplx_t x, cmplx_t) { return cmplx_t(x.real()); }), real_t,
+                       single);
+            CheckClose(tensor::ops::imag(t), Map(a, a, [](cmplx_t x, cmplx_t) { return cmplx_t(x.imag()); }), real_t,
+                       single);
+            CheckClose(tensor::ops::conj(t), Map(a, a, [](cmplx_t x, cmplx_t) { return std::conj(x); }), dtype,
+                       single);
+            for (auto other_t : all_dtypes) {
+                auto b = Values(len, other_t, 2);
+                cmplx_t expected = 0;
+                for (size_t i = 0; i < len; i++) {
+                    expected += std::conj(a[i]) * b[i];
+                }
+                auto got = tensor::ops::vdot(t, Make(b, other_t));
+                CheckClose(got, {expected}, tensor::upper_type_v(dtype, other_t), single || IsSingle(other_t));
+            }
+        }
+    }
+}
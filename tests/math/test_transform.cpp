@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <complex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#    include <omp.h>
+#endif  // _OPENMP
+
+#include "math/operators/fermion_operator_view.h"
+#include "math/operators/qubit_operator_view.h"
+#include "math/operators/transform.h"
+#include "math/pr/parameter_resolver.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+using operators::fermion::FermionOperator;
+using operators::qubit::QubitOperator;
+using parameter::ParameterResolver;
+using ladder_t = FermionOperator::term_t;
+
+namespace {
+std::complex<double> Coeff(const ParameterResolver& pr) {
+    return tensor::ops::cpu::to_vector<std::complex<double>>(pr.const_value)[0];
+}
+
+QubitOperator JordanWignerLadder(const ladder_t& ladder) {
+    const auto& [idx, value] = ladder;
+    std::vector<size_t> z(idx);
+    std::iota(z.begin(), z.end(), static_cast<size_t>(0));
+    return operators::transform::transform_ladder_operator(value, {idx}, {}, z, {}, {idx}, z);
+}
+
+FermionOperator RandomOperator(size_t n_draw, int n_modes, unsigned seed) {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    FermionOperator out;
+    for (size_t i = 0; i < n_draw; i++) {
+        auto mode = [&]() { return std::to_string(engine() % n_modes); };
+        auto str = mode() + "^ " + mode() + "^ " + mode() + " " + mode();
+        out += FermionOperator(str, ParameterResolver(dist(engine)));
+    }
+    return out;
+}
+
+// Transform term by term without blocks, threads or cache.
+QubitOperator SerialTransform(const FermionOperator& ops) {
+    QubitOperator out;
+    for (const auto& [term, coeff] : ops.get_terms()) {
+        auto transformed_term = QubitOperator("", coeff);
+        for (const auto& ladder : term) {
+            transformed_term *= JordanWignerLadder(ladder);
+        }
+        out += transformed_term;
+    }
+    return out;
+}
+
+void CheckSame(const QubitOperator& lhs, const QubitOperator& rhs) {
+    REQUIRE(lhs.size() == rhs.size());
+    auto it = rhs.terms.begin();
+    size_t n_bad = 0;
+    for (const auto& [key, value] : lhs.terms) {
+        auto expected = Coeff(it->second);
+        if (key != it->first || std::abs(Coeff(value) - expected) > 1e-12 * std::max(1.0, std::abs(expected))) {
+            ++n_bad;
+        }
+        ++it;
+    }
+    CHECK(n_bad == 0);
+}
+
+// Number of misses of a least recently used cache of given capacity, when ladders are looked up in term order.
+size_t LruMisses(const FermionOperator& ops, size_t capacity) {
+    std::vector<ladder_t> recent;
+    size_t misses = 0;
+    for (const auto& [term, coeff] : ops.get_terms()) {
+        for (const auto& ladder : term) {
+            if (auto it = std::find(recent.begin(), recent.end(), ladder); it != recent.end()) {
+                recent.erase(it);
+            } else {
+                ++misses;
+                if (recent.size() == capacity) {
+                    recent.pop_back();
+                }
+            }
+            recent.insert(recent.begin(), ladder);
+        }
+    }
+    return misses;
+}
+}  // namespace
+
+TEST_CASE("Parallel fermion transform keeps serial term order", "[transform]") {
+    // Enough terms for the parallel path and several blocks.
+    auto ops = RandomOperator(6000, 16, 42);
+    REQUIRE(ops.size() > 3000);
+    auto expected = SerialTransform(ops);
+    CheckSame(operators::transform::jordan_wigner(ops), expected);
+#ifdef _OPENMP
+    auto n_threads = omp_get_max_threads();
+    for (int n : {1, 3, 8}) {
+        omp_set_num_threads(n);
+        CheckSame(operators::transform::jordan_wigner(ops), expected);
+    }
+    omp_set_num_threads(n_threads);
+#endif  // _OPENMP
+}
+
+TEST_CASE("Fermion transform evicts least recently used ladder images", "[transform]") {
+    size_t n_calls = 0;
+    auto image = [&](const ladder_t& ladder) {
+        ++n_calls;
+        return JordanWignerLadder(ladder);
+    };
+
+    // 0^ stays in use, so a capacity of two evicts 1 when 2 comes in and 0^ is computed once.
+    auto ops = FermionOperator("0^ 1") + FermionOperator("0^ 2") + FermionOperator("0^");
+    auto out = operators::transform::transform_fermion_operator(ops, image, 2);
+    CHECK(n_calls == 3);
+    CheckSame(out, SerialTransform(ops));
+
+    // Below the parallel threshold a single cache sees every lookup in term order.
+    auto random_ops = RandomOperator(300, 6, 7);
+    auto expected = SerialTransform(random_ops);
+    for (size_t capacity : {1, 2, 3, 5, 8, 1000}) {
+        n_calls = 0;
+        out = operators::transform::transform_fermion_operator(random_ops, image, capacity);
+        CHECK(n_calls == LruMisses(random_ops, capacity));
+        CheckSame(out, expected);
+    }
+
+    CHECK_THROWS_AS(operators::transform::transform_fermion_operator(ops, image, 0), std::runtime_error);
+}
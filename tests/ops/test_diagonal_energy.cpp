@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdexcept>
+#include <utility>
+
+#include "core/mq_base_types.h"
+#include "core/utils.h"
+#include "ops/diagonal_energy.h"
+#include "ops/hamiltonian.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+using mindquantum::DiagonalEnergy;
+using mindquantum::Hamiltonian;
+using mindquantum::Index;
+using mindquantum::PauliTerm;
+using mindquantum::VT;
+
+namespace {
+double Energy(const VT<std::pair<Index, double>>& terms, Index i) {
+    double e = 0;
+    for (const auto& [mask, coeff] : terms) {
+        e += (mindquantum::CountOne(i & mask) & 1) ? -coeff : coeff;
+    }
+    return e;
+}
+}  // namespace
+
+TEST_CASE("DiagonalEnergy packs used qubits", "[diagonal_energy]") {
+    // Qubits 1, 9 and 40 are used, so the table has 8 entries.
+    Index q1 = Index(1) << 1, q9 = Index(1) << 9, q40 = Index(1) << 40;
+    VT<std::pair<Index, double>> terms = {{q1 | q9, 0.7}, {q40, -1.2}, {q1 | q40, 0.3}, {0, 0.5}};
+    DiagonalEnergy<double> energy(terms);
+    CHECK(energy.UsedQubits() == 3);
+    CHECK(energy.Pack(q1) == 1);
+    CHECK(energy.Pack(q9) == 2);
+    CHECK(energy.Pack(q40) == 4);
+    CHECK(energy.Pack(~Index(0)) == 7);
+    REQUIRE(energy.Cached());
+    const auto& table = energy.Table();
+    CHECK(table.size() == 8);
+    for (Index i : {Index(0), q1, q9 | Index(1) << 5, q1 | q9 | q40, q40 | Index(1) << 63, ~Index(0)}) {
+        CHECK(table[energy.Pack(i)] == Energy(terms, i));
+    }
+}
+
+TEST_CASE("DiagonalEnergy builds table lazily", "[diagonal_energy]") {
+    VT<PauliTerm<double>> ham;
+    for (Index q = 0; q < 24; q++) {
+        ham.push_back({{{q, 'Z'}}, 1.0});
+    }
+    Hamiltonian<double> large(ham);
+    CHECK(large.is_diagonal_);
+    CHECK(large.diag_energy_.UsedQubits() == 24);
+    CHECK_FALSE(large.diag_energy_.Cached());
+    CHECK_THROWS_AS(large.diag_energy_.Table(), std::runtime_error);
+
+    // Copies share the table built by any of them.
+    Hamiltonian<double> small({{{{3, 'Z'}, {12, 'Z'}}, 2.0}});
+    auto copy = small;
+    const auto& table = copy.diag_energy_.Table();
+    CHECK(table.size() == 4);
+    CHECK(&small.diag_energy_.Table() == &table);
+    CHECK(table[small.diag_energy_.Pack(Index(1) << 12)] == -2.0);
+}
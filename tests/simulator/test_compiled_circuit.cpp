@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) Huawei Technologies Co., Ltd. 2023. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <complex>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/mq_base_types.h"
+#include "math/pr/parameter_resolver.h"
+#include "math/tensor/ops_cpu/memory_operator.h"
+#include "ops/basic_gate.h"
+#include "ops/gates.h"
+#include "simulator/compiled_circuit.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+// =============================================================================
+
+using mindquantum::VS;
+using mindquantum::VT;
+using mindquantum::sim::CompiledCircuit;
+using mindquantum::sim::CompiledJacobian;
+using mindquantum::sim::GateParameters;
+using parameter::ParameterResolver;
+using circuit_t = std::vector<std::shared_ptr<mindquantum::BasicGate>>;
+
+namespace {
+ParameterResolver PR(double const_value, const std::map<std::string, double>& data) {
+    return ParameterResolver(const_value, data);
+}
+
+// Gradient of circuit parameters from intrinsic gradients of gates by the jacobian matrix of every gate.
+VT<std::complex<double>> UncompiledGrad(const circuit_t& circ, const mindquantum::MST<size_t>& p_map,
+                                        const VT<VT<std::complex<double>>>& intrin_grads) {
+    VT<std::complex<double>> grad(p_map.size());
+    for (size_t k = 0; k < circ.size(); k++) {
+        if (!mindquantum::sim::IsParameterizable(circ[k]->id_) || !circ[k]->GradRequired()) {
+            continue;
+        }
+        const auto& [title, jacobi] = static_cast<mindquantum::Parameterizable*>(circ[k].get())->jacobi;
+        auto m = tensor::ops::cpu::to_vector<std::complex<double>>(jacobi);
+        for (size_t row = 0; row < jacobi.n_row; row++) {
+            for (const auto& [name, col] : title) {
+                grad[p_map.at(name)] += intrin_grads[k][row] * m[row][col];
+            }
+        }
+    }
+    return grad;
+}
+
+// A circuit that mixes gates without parameter, constant gates, shared parameters and a no grad parameter.
+circuit_t Circuit() {
+    auto rz_pr = PR(0.0, {{"b", 1.0}, {"c", -0.5}});
+    rz_pr.NoGradPart({"b"});
+    return {
+        std::make_shared<mindquantum::HGate>(mindquantum::qbits_t{0}),
+        std::make_shared<mindquantum::RXGate>(PR(0.5, {{"a", 2.0}}), mindquantum::qbits_t{0}),
+        std::make_shared<mindquantum::U3>(PR(0.0, {{"a", 1.0}, {"b", -1.0}}), PR(0.0, {{"c", 3.0}}), PR(0.7, {}),
+                                          mindquantum::qbits_t{1}, mindquantum::qbits_t{}),
+        std::make_shared<mindquantum::RZGate>(rz_pr, mindquantum::qbits_t{1}, mindquantum::qbits_t{0}),
+        std::make_shared<mindquantum::FSim>(PR(0.0, {{"b", 2.0}}), PR(-0.1, {{"c", 1.0}, {"a", 1.0}}),
+                                            mindquantum::qbits_t{0, 1}, mindquantum::qbits_t{}),
+        std::make_shared<mindquantum::XGate>(mindquantum::qbits_t{1}),
+        std::make_shared<mindquantum::RYGate>(PR(0.3, {}), mindquantum::qbits_t{1}),
+    };
+}
+}  // namespace
+
+TEST_CASE("Compiled circuit binds the same gate parameters as parameter resolver", "[compiled_circuit]") {
+    auto circ = Circuit();
+    CompiledCircuit compiled(circ, {"c"});
+    // Given names lead, the others follow in order of appearance.
+    CHECK(compiled.names_ == VS{"c", "a", "b"});
+    CHECK(compiled.gate_rows_ == VT<size_t>{CompiledCircuit::npos, 0, 1, 4, 5, CompiledCircuit::npos, 7});
+    CHECK(compiled.offset_.size() == 8);
+    CHECK(compiled.row_ptr_.size() == 9);
+
+    auto pr = PR(0.0, {{"a", 0.3}, {"b", -1.2}, {"c", 0.8}});
+    auto x = compiled.Values(pr);
+    CHECK(x == VT<double>{0.8, 0.3, -1.2});
+    auto bound = compiled.Bind(x);
+    REQUIRE(bound.size() == 8);
+    for (size_t k = 0; k < circ.size(); k++) {
+        if (compiled.gate_rows_[k] == CompiledCircuit::npos) {
+            continue;
+        }
+        auto expected = GateParameters(circ[k], pr);
+        for (size_t j = 0; j < expected.size(); j++) {
+            CHECK(std::abs(bound[compiled.gate_rows_[k] + j] - expected[j]) < 1e-12);
+        }
+    }
+
+    CHECK_THROWS_AS(compiled.Bind({0.1, 0.2}), std::invalid_argument);
+}
+
+TEST_CASE("Compiled jacobian accumulates the same gradient as gate jacobians", "[compiled_circuit]") {
+    auto circ = Circuit();
+    mindquantum::MST<size_t> p_map{{"c", 0}, {"a", 1}, {"b", 2}};
+    CompiledJacobian jacobian(circ, p_map);
+    VT<bool> has_grad;
+    for (size_t k = 0; k < circ.size(); k++) {
+        has_grad.push_back(jacobian.HasGrad(k));
+    }
+    CHECK(has_grad == VT<bool>{false, true, true, true, true, false, false});
+
+    VT<VT<std::complex<double>>> intrin_grads;
+    for (size_t k = 0; k < circ.size(); k++) {
+        VT<std::complex<double>> g;
+        if (mindquantum::sim::IsParameterizable(circ[k]->id_)) {
+            auto n_pr = static_cast<mindquantum::Parameterizable*>(circ[k].get())->prs_.size();
+            for (size_t row = 0; row < n_pr; row++) {
+                g.emplace_back(0.1 * static_cast<double>(k + 1), -0.3 * static_cast<double>(row + 1));
+            }
+        }
+        intrin_grads.push_back(g);
+    }
+
+    VT<std::complex<double>> grad(p_map.size());
+    VT<std::complex<double>> real_grad(p_map.size());
+    for (size_t k = 0; k < circ.size(); k++) {
+        if (jacobian.HasGrad(k)) {
+            jacobian.AddGrad(k, intrin_grads[k].data(), grad.data());
+            jacobian.AddRealGrad(k, intrin_grads[k].data(), real_grad.data());
+        }
+    }
+    auto expected = UncompiledGrad(circ, p_map, intrin_grads);
+    for (size_t i = 0; i < p_map.size(); i++) {
+        CHECK(std::abs(grad[i] - expected[i]) < 1e-12);
+        CHECK(std::abs(real_grad[i] - 2 * std::real(expected[i])) < 1e-12);
+    }
+    // The no grad parameter of the controlled RZ must not reach b, which only comes from U3 and FSim.
+    auto b = intrin_grads[2][0] * -1.0 + intrin_grads[4][0] * 2.0;
+    CHECK(std::abs(grad[2] - b) < 1e-12);
+
+    CHECK_THROWS_AS(CompiledJacobian(circ, {{"a", 0}, {"b", 1}}), std::out_of_range);
+}
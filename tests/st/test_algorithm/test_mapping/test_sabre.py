@@ -0,0 +1,176 @@
+# Copyright 2023 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""Test SABRE and MQ_SABRE qubit mapping."""
+
+import numpy as np
+import pytest
+
+from mindquantum.algorithm.mapping import MQ_SABRE, SABRE
+from mindquantum.core.circuit import Circuit
+from mindquantum.core.gates import SWAP, X
+from mindquantum.device import GridQubits
+
+
+def cnot_chain(n_qubits):
+    """Linear chain of CNOT gates."""
+    circ = Circuit()
+    for i in range(n_qubits - 1):
+        circ += X.on(i + 1, i)
+    return circ
+
+
+def cnot_triangle():
+    """CNOT gates between every pair of three qubits, which can not be embedded in a grid."""
+    return Circuit([X.on(1, 0), X.on(2, 1), X.on(0, 2), X.on(1, 0)])
+
+
+def cnot_random(n_qubits, n_gates, seed):
+    """Random CNOT gates, which need SWAP gates on a grid."""
+    rng = np.random.default_rng(seed)
+    circ = Circuit()
+    for _ in range(n_gates):
+        ctrl, obj = rng.choice(n_qubits, 2, replace=False)
+        circ += X.on(int(obj), int(ctrl))
+    return circ
+
+
+def cnot_info_of(topology):
+    """Error rate and gate length of CNOT gate on every coupled physical qubits."""
+    cnot_info = []
+    for x, y in topology.edges_with_id():
+        error = 0.001 * (x + y + 1)
+        cnot_info.extend([((x, y), [error, 1.0 + x]), ((y, x), [error, 1.0 + y])])
+    return cnot_info
+
+
+def assert_executable(circ, topology):
+    """Check that every two qubits gate acts on coupled physical qubits."""
+    edges = topology.edges_with_id()
+    for gate in circ:
+        qubits = gate.obj_qubits + gate.ctrl_qubits
+        if len(qubits) == 2:
+            assert tuple(qubits) in edges or tuple(reversed(qubits)) in edges
+
+
+def n_swap(circ):
+    """Number of SWAP gates in circuit."""
+    return sum(isinstance(gate, SWAP.__class__) for gate in circ)
+
+
+def test_sabre_perfect_layout():
+    """
+    Description: Test SABRE with layout search.
+    Expectation: a linear CNOT chain is placed on a grid without SWAP gate.
+    """
+    topology = GridQubits(3, 3)
+    solver = SABRE(cnot_chain(6), topology)
+    new_circ, init_map, _ = solver.solve(5, 0.5, 0.3, 0.2, n_trials=3, seed=42, layout_time_limit=1.0)
+    assert n_swap(new_circ) == 0
+    assert_executable(new_circ, topology)
+    assert len(set(init_map)) == len(init_map)
+    assert len(solver.trial_results) == 1
+    assert solver.trial_results[0]['num_swap'] == 0
+
+
+def test_sabre_perfect_layout_fallback():
+    """
+    Description: Test SABRE with layout search on a circuit that can not be embedded.
+    Expectation: the randomized trials are run.
+    """
+    topology = GridQubits(3, 3)
+    solver = SABRE(cnot_triangle(), topology)
+    new_circ, _, _ = solver.solve(5, 0.5, 0.3, 0.2, n_trials=3, seed=42, layout_time_limit=1.0)
+    assert n_swap(new_circ) > 0
+    assert_executable(new_circ, topology)
+    assert len(solver.trial_results) == 3
+
+
+def test_mq_sabre_perfect_layout():
+    """
+    Description: Test MQ_SABRE with layout search.
+    Expectation: a linear CNOT chain is placed on a grid without SWAP gate.
+    """
+    topology = GridQubits(3, 3)
+    solver = MQ_SABRE(cnot_chain(6), topology, cnot_info_of(topology))
+    new_circ, init_map, _ = solver.solve(0.5, 0.3, 0.2, 0.1, n_trials=2, seed=42, layout_time_limit=1.0)
+    assert n_swap(new_circ) == 0
+    assert_executable(new_circ, topology)
+    assert len(set(init_map[:6])) == 6
+    assert len(solver.trial_results) == 1
+
+
+def test_sabre_layout_time_limit_check():
+    """
+    Description: Test invalid layout_time_limit.
+    Expectation: raise error.
+    """
+    solver = SABRE(cnot_chain(3), GridQubits(2, 2))
+    with pytest.raises(ValueError):
+        solver.solve(5, 0.5, 0.3, 0.2, layout_time_limit=-1.0)
+    with pytest.raises(TypeError):
+        solver.solve(5, 0.5, 0.3, 0.2, layout_time_limit='1')
+
+
+def test_mq_sabre_multi_trial():
+    """
+    Description: Test MQ_SABRE with several trials.
+    Expectation: every trial is reported, the returned result is the one with fewest SWAP gates.
+    """
+    topology = GridQubits(3, 3)
+    solver = MQ_SABRE(cnot_random(7, 30, 42), topology, cnot_info_of(topology))
+    new_circ, init_map, _ = solver.solve(0.5, 0.3, 0.2, 0.1, n_trials=4, seed=42)
+    assert_executable(new_circ, topology)
+    assert len(set(init_map[:7])) == 7
+    assert len(solver.trial_results) == 4
+    assert [res['seed'] for res in solver.trial_results] == [42, 43, 44, 45]
+    assert n_swap(new_circ) == min(res['num_swap'] for res in solver.trial_results)
+
+
+def test_mq_sabre_multi_trial_reproducible():
+    """
+    Description: Test reproducibility of MQ_SABRE trials.
+    Expectation: the same seed gives the same result, and every trial can be run again alone.
+    """
+    topology = GridQubits(3, 3)
+    circ = cnot_random(7, 30, 42)
+    cnot_info = cnot_info_of(topology)
+    solver = MQ_SABRE(circ, topology, cnot_info)
+    new_circ, init_map, final_map = solver.solve(0.5, 0.3, 0.2, 0.1, n_trials=4, seed=42)
+    trial_results = solver.trial_results
+    other = MQ_SABRE(circ, topology, cnot_info)
+    assert other.solve(0.5, 0.3, 0.2, 0.1, n_trials=4, seed=42) == (new_circ, init_map, final_map)
+    assert other.trial_results == trial_results
+
+    # The first trial starts from the interaction graph and does not depend on seed.
+    other.solve(0.5, 0.3, 0.2, 0.1, n_trials=1, seed=7)
+    assert other.trial_results[0]['num_swap'] == trial_results[0]['num_swap']
+    assert other.trial_results[0]['depth'] == trial_results[0]['depth']
+    # Every other trial t is the random trial seeded with seed + t, which is trial 1 of a run with seed + t - 1.
+    for t in range(1, 4):
+        other.solve(0.5, 0.3, 0.2, 0.1, n_trials=2, seed=42 + t - 1)
+        assert other.trial_results[1] == trial_results[t]
+
+
+def test_mq_sabre_n_trials_check():
+    """
+    Description: Test invalid n_trials of MQ_SABRE.
+    Expectation: raise error.
+    """
+    topology = GridQubits(2, 2)
+    solver = MQ_SABRE(cnot_chain(3), topology, cnot_info_of(topology))
+    with pytest.raises(ValueError):
+        solver.solve(0.5, 0.3, 0.2, 0.1, n_trials=0)
+    with pytest.raises(TypeError):
+        solver.solve(0.5, 0.3, 0.2, 0.1, n_trials=1.5)
@@ -20,7 +20,7 @@ import pickle
 
 import pytest
 
-from mindquantum.core.operators import FermionOperator
+from mindquantum.core.operators import FermionOperator, QubitOperator
 
 _HAS_OPENFERMION = True
 try:
@@ -81,6 +81,15 @@ def test_normal_order():
 
     assert origin.normal_ordered() == normal_order
 
+    origin = FermionOperator('30 30^ 2 2^', 'a')
+    normal_order = (
+        FermionOperator('', 'a')
+        - FermionOperator('30^ 30', 'a')
+        - FermionOperator('2^ 2', 'a')
+        + FermionOperator('30^ 30 2^ 2', 'a')
+    )
+    assert origin.normal_ordered() == normal_order
+
 
 @pytest.mark.level0
 @pytest.mark.platform_x86_cpu
@@ -208,6 +217,25 @@ def test_dumps_and_loads():
     assert obj == f
 
 
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+def test_save_and_load(tmp_path):
+    """
+    Description: Test fermion operator save to binary file and load back
+    Expectation: loaded operator equals to the saved one, and wrong operator kind raises error.
+    """
+    f = FermionOperator('0', 1 + 2j) + FermionOperator('0^ 3 70^', 'a')
+    filename = str(tmp_path / 'ops.bin')
+    f.save(filename)
+    obj = FermionOperator.load(filename)
+    assert obj == f
+    assert sum(FermionOperator.load_terms(filename), FermionOperator()) == f
+    with pytest.raises(RuntimeError):
+        QubitOperator.load(filename)
+    with pytest.raises(RuntimeError):
+        next(QubitOperator.load_terms(filename))
+
+
 @pytest.mark.level0
 @pytest.mark.platform_x86_cpu
 @pytest.mark.skipif(not _HAS_OPENFERMION or not _FORCE_TEST, reason='OpenFermion is not installed')
@@ -20,7 +20,15 @@ import pickle
 import numpy as np
 import pytest
 
-from mindquantum.core.operators import QubitOperator, ground_state_of_sum_zz
+from mindquantum.core.gates import I
+from mindquantum.core.operators import (
+    QubitOperator,
+    commutator,
+    find_z2_symmetries,
+    ground_state_of_sum_zz,
+    group_commuting_terms,
+    taper_qubits,
+)
 from mindquantum.core.parameterresolver import ParameterResolver
 from mindquantum.simulator.available_simulator import SUPPORTED_SIMULATOR
 from mindquantum.utils.error import DeviceNotSupportedError
@@ -195,6 +203,24 @@ def test_qubit_ops_dumps_and_loads():
     assert obj == ops
 
 
+def test_qubit_ops_save_and_load(tmp_path):
+    """
+    Description: Test qubit operator save to binary file and load back
+    Expectation: loaded operator equals to the saved one, including parameters and empty operator.
+    """
+    ops = QubitOperator('X0 Y1', 1.2 + 0.3j) + QubitOperator('Z0 X100', {'a': 2.1}) + QubitOperator('', 'b')
+    filename = str(tmp_path / 'ops.bin')
+    ops.save(filename)
+    obj = QubitOperator.load(filename)
+    assert obj == ops
+    assert list(obj.terms) == list(ops.terms)
+    terms = list(QubitOperator.load_terms(filename))
+    assert [len(term) for term in terms] == [1, 1, 1]
+    assert sum(terms, QubitOperator()) == ops
+    QubitOperator().save(filename)
+    assert len(QubitOperator.load(filename)) == 0
+
+
 @pytest.mark.skipif(not _HAS_OPENFERMION, reason='OpenFermion is not installed')
 @pytest.mark.skipif(not _FORCE_TEST, reason='set not force test')
 def test_qubit_ops_trans():
@@ -221,10 +247,76 @@ def test_ground_state_of_sum_zz_cpu():
         e1 = ground_state_of_sum_zz(ops)
         e2 = np.min(ops.matrix().data)
         assert np.allclose(e1, e2)
+        e3, states = ground_state_of_sum_zz(ops, return_states=True)
+        diag = ops.matrix().diagonal().real
+        assert np.allclose(e3, e2)
+        assert np.all(states == np.where(np.isclose(diag, e2))[0])
     except DeviceNotSupportedError:
         pass
 
 
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+def test_group_commuting_terms():
+    """
+    Description: Test group_commuting_terms.
+    Expectation: every term is in one group, and is rotated to the reported Z string.
+    """
+    ops = (
+        QubitOperator('X0 X1', 0.3)
+        + QubitOperator('Y0 Y1', 0.4)
+        + QubitOperator('Z0 Z1 X2', 0.5)
+        + QubitOperator('X0', 0.6)
+        + QubitOperator('Y1 Z2', 0.7)
+        + QubitOperator('', 0.2)
+    )
+    n_qubits = 3
+    for qubit_wise in (True, False):
+        groups = group_commuting_terms(ops, qubit_wise)
+        total = QubitOperator()
+        for group, circ, diag in groups:
+            total += group
+            rot = (circ + I.on(n_qubits - 1)).matrix()
+            assert len(diag) == len(group)
+            for term, (sign, qubits) in zip(group.terms, diag):
+                term_ops = QubitOperator(' '.join(f'{p}{q}' for q, p in term))
+                z_ops = QubitOperator(' '.join(f'Z{q}' for q in qubits))
+                rotated = rot @ term_ops.matrix(n_qubits).toarray() @ rot.conj().T
+                assert np.allclose(rotated, sign * z_ops.matrix(n_qubits).toarray())
+        assert total == ops
+    assert len(group_commuting_terms(ops, True)) >= len(group_commuting_terms(ops, False))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+def test_taper_qubits():
+    """
+    Description: Test find_z2_symmetries and taper_qubits.
+    Expectation: spectrum of all tapered sectors together equals to spectrum of origin operator.
+    """
+    ops = (
+        QubitOperator('Z0 Z1', 0.3)
+        + QubitOperator('X0 X1', 0.4)
+        + QubitOperator('Z0', 0.5)
+        + QubitOperator('Z1', 0.6)
+        + QubitOperator('Y2 Z3', 0.7)
+        + QubitOperator('X3', 0.2)
+    )
+    generators, circ, qubits = find_z2_symmetries(ops)
+    assert len(generators) == len(qubits) == len(set(qubits))
+    assert circ.n_qubits <= 4
+    for generator in generators:
+        assert len(commutator(ops, generator).compress()) == 0
+    n_sym = len(generators)
+    energies = []
+    for idx in range(2**n_sym):
+        sector = [-1 if (idx >> i) & 1 else 1 for i in range(n_sym)]
+        tapered, (tapered_x3,) = taper_qubits(ops, sector, [QubitOperator('X3')])
+        assert tapered_x3.count_qubits() <= 4 - n_sym
+        energies.extend(np.linalg.eigvalsh(tapered.matrix(4 - n_sym).toarray()))
+    assert np.allclose(np.sort(energies), np.linalg.eigvalsh(ops.matrix(4).toarray()))
+
+
 tmp_sim = ['mqvector']
 if 'mqvector_gpu' in SUPPORTED_SIMULATOR.sims:
     tmp_sim.append('mqvector_gpu')
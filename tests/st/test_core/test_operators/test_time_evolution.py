@@ -13,11 +13,13 @@
 # limitations under the License.
 # ============================================================================
 """Test TimeEvolution."""
+import numpy as np
 import pytest
+from scipy.linalg import expm
 
 from mindquantum.core import gates as G
 from mindquantum.core.circuit import Circuit
-from mindquantum.core.operators import QubitOperator, TimeEvolution
+from mindquantum.core.operators import QubitOperator, TimeEvolution, trotter_circuit
 
 
 @pytest.mark.level0
@@ -31,3 +33,37 @@ def test_time_evolution():
     circ = TimeEvolution(hamiltonian).circuit
     circ_exp = Circuit([G.X.on(1, 0), G.RZ({'p': 2}).on(1), G.X.on(1, 0), G.RX({'q': 2}).on(0)])
     assert repr(circ) == repr(circ_exp)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+def test_trotter_circuit():
+    """
+    Description: Test native product formula circuit of time evolution.
+    Expectation: success.
+    """
+    hamiltonian = (
+        QubitOperator('X0 Y1', 0.3)
+        + QubitOperator('Z0 Z1 Z2', -0.4)
+        + QubitOperator('Y2', 0.2)
+        + QubitOperator('Z1 X2 Y3', 0.5)
+        + QubitOperator('X0 X3', 0.1)
+        + QubitOperator('', 0.7)
+    )
+    exact = expm(-1j * 0.5 * hamiltonian.matrix(4).toarray())
+
+    def phase_error(circ):
+        mat = circ.matrix()
+        phase = np.trace(exact.conj().T @ mat)
+        return np.linalg.norm(mat * np.conj(phase) / np.abs(phase) - exact)
+
+    errors = [phase_error(trotter_circuit(hamiltonian, 0.5, steps=4, order=order)) for order in (1, 2, 4)]
+    assert errors[0] > errors[1] > errors[2]
+    assert errors[2] < 1e-5
+    assert np.allclose(
+        trotter_circuit(hamiltonian, 0.5, steps=2, native=False).matrix(),
+        trotter_circuit(hamiltonian, 0.5, steps=2).matrix(),
+    )
+    assert phase_error(trotter_circuit(hamiltonian, 0.5, steps=4000, order='qdrift', seed=42)) < 0.1
+    with pytest.raises(ValueError):
+        trotter_circuit(hamiltonian, 0.5, order=3)
@@ -20,6 +20,7 @@ import subprocess
 
 import numpy as np
 import pytest
+from scipy.linalg import expm
 from scipy.sparse import csr_matrix
 
 import mindquantum as mq
@@ -33,7 +34,7 @@ from mindquantum.core.circuit import (
     MeasureAccepter,
     MixerAdder,
 )
-from mindquantum.core.operators import Hamiltonian, QubitOperator
+from mindquantum.core.operators import Hamiltonian, Projector, QubitOperator
 from mindquantum.core.parameterresolver import ParameterResolver as PR
 from mindquantum.simulator import NoiseBackend, Simulator, inner_product
 from mindquantum.simulator.available_simulator import SUPPORTED_SIMULATOR
@@ -440,6 +441,132 @@ def test_csr_ham(config):
         assert np.allclose(qs, qs_exp)
 
 
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("config", list(SUPPORTED_SIMULATOR))
+def test_hamiltonian_evolution(config):
+    """
+    Description: test time evolution of quantum state under hamiltonian.
+    Expectation: success.
+    """
+    virtual_qc, dtype = config
+    if not virtual_qc.startswith('mqvector'):
+        return
+    ham_op = QubitOperator('X0 Y1', 0.3) + QubitOperator('Z0 Z2', -0.7) + QubitOperator('Y2', 1.1)
+    ham_op += QubitOperator('Z1', 0.4)
+    init = random_circuit(3, 10, seed=42)
+    ham_mat = ham_op.matrix(3).toarray()
+    qs_exp = expm(-1j * 2.5 * ham_mat) @ init.get_qs()
+    atol = 1e-8 if dtype == mq.complex128 else 1e-4
+    for ham in [Hamiltonian(ham_op, dtype=dtype), Hamiltonian(ham_op.matrix(3), dtype=dtype)]:
+        sim = Simulator(virtual_qc, 3, dtype=dtype)
+        sim.apply_circuit(init)
+        sim.apply_hamiltonian_evolution(ham, 2.5)
+        assert np.allclose(sim.get_qs(), qs_exp, atol=atol)
+        sim.apply_hamiltonian_evolution(ham, -2.5)
+        assert np.allclose(sim.get_qs(), init.get_qs(), atol=atol)
+    with pytest.raises(ValueError):
+        sim.apply_hamiltonian_evolution(ham, 2.5, tol=0)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("config", list(SUPPORTED_SIMULATOR))
+def test_solve_lowest_eigenstates(config):
+    """
+    Description: test lowest eigenpairs solved by Lanczos method.
+    Expectation: success.
+    """
+    virtual_qc, dtype = config
+    if not virtual_qc.startswith('mqvector'):
+        return
+    ham_op = QubitOperator('X0 Y1', 0.3) + QubitOperator('Z0 Z2', -0.7) + QubitOperator('Y2 X3', 1.1)
+    ham_op += QubitOperator('Z1', 0.4) + QubitOperator('X1 X2 Z3', -0.5)
+    ham_mat = ham_op.matrix(4).toarray()
+    eigvals_exp = np.linalg.eigvalsh(ham_mat)
+    atol = 1e-6 if dtype == mq.complex128 else 1e-3
+    sim = Simulator(virtual_qc, 4, dtype=dtype)
+    sim.set_qs(np.random.default_rng(42).normal(size=16) + 0j)
+    eigvals, eigstates = sim.solve_lowest_eigenstates(Hamiltonian(ham_op, dtype=dtype), k=3)
+    assert np.allclose(eigvals, eigvals_exp[:3], atol=atol)
+    for i in range(3):
+        assert np.allclose(ham_mat @ eigstates[:, i], eigvals[i] * eigstates[:, i], atol=atol)
+    assert np.allclose(np.abs(np.vdot(sim.get_qs(), eigstates[:, 0])), 1, atol=atol)
+    with pytest.raises(ValueError):
+        sim.solve_lowest_eigenstates(Hamiltonian(ham_op, dtype=dtype), k=3, tol=0)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("config", list(SUPPORTED_SIMULATOR))
+def test_diagonal_hamiltonian(config):
+    """
+    Description: test expectation, gradient and application of hamiltonian with only pauli Z terms.
+    Expectation: success.
+    """
+    virtual_qc, dtype = config
+    ham_op = QubitOperator('Z0 Z1', 0.7) + QubitOperator('Z1 Z2', -1.2) + QubitOperator('Z0', 0.3) + 0.5
+    circ = Circuit([G.H.on(0), G.H.on(1), G.H.on(2), G.RZZ('a').on([0, 1]), G.RX('b').on(1), G.RY('c').on(2)])
+    p0 = np.array([0.4, 1.1, -0.6])
+    ham_mat = ham_op.matrix(3).toarray()
+    qs = circ.get_qs(pr=p0)
+    sim = Simulator(virtual_qc, 3, dtype=dtype)
+    f, g = sim.get_expectation_with_grad(Hamiltonian(ham_op, dtype=dtype), circ)(p0)
+    assert np.allclose(f[0, 0], np.vdot(qs, ham_mat @ qs), atol=1e-5)
+    step = 1e-4
+    for i in range(3):
+        shift = np.zeros(3)
+        shift[i] = step
+        qs_p = circ.get_qs(pr=p0 + shift)
+        qs_n = circ.get_qs(pr=p0 - shift)
+        g_exp = (np.vdot(qs_p, ham_mat @ qs_p) - np.vdot(qs_n, ham_mat @ qs_n)) / (2 * step)
+        assert np.allclose(g[0, 0, i], g_exp, atol=1e-3)
+    if virtual_qc.startswith('mqvector'):
+        sim.apply_circuit(circ, p0)
+        sim.apply_hamiltonian(Hamiltonian(ham_op, dtype=dtype))
+        assert np.allclose(sim.get_qs(), ham_mat @ qs, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.parametrize("config", list(SUPPORTED_SIMULATOR))
+def test_projector_expectation_and_post_select(config):
+    """
+    Description: test probability of projector and post selection.
+    Expectation: success.
+    """
+    virtual_qc, dtype = config
+    circ = Circuit([G.H.on(0), G.RX('a').on(1, 0), G.RY(0.8).on(2), G.X.on(0, 2)])
+    pr = {'a': 1.3}
+    qs = circ.get_qs(pr=pr)
+    proj = Projector('1I0')
+    idx = [i for i in range(8) if (i & 0b101) == 0b100]
+    prob = np.sum(np.abs(qs[idx]) ** 2)
+    sim = Simulator(virtual_qc, 3, dtype=dtype)
+    assert np.allclose(sim.get_expectation(Projector('000')), 1)
+    assert np.allclose(sim.get_expectation(proj, circ, pr=pr), prob, atol=1e-5)
+    sim.apply_circuit(circ, pr)
+    assert np.allclose(sim.get_expectation(proj), prob, atol=1e-5)
+    assert np.allclose(sim.get_expectation(Projector('1')), np.sum(np.abs(qs[1::2]) ** 2), atol=1e-5)
+    assert np.allclose(sim.post_select(proj), prob, atol=1e-5)
+    exp_qs = np.zeros_like(qs)
+    exp_qs[idx] = qs[idx] / np.sqrt(prob)
+    if virtual_qc.startswith('mqmatrix'):
+        assert np.allclose(sim.get_qs(), np.outer(exp_qs, exp_qs.conj()), atol=1e-5)
+    else:
+        assert np.allclose(sim.get_qs(), exp_qs, atol=1e-5)
+    with pytest.raises(RuntimeError):
+        sim.post_select(Projector('0I0'))
+
+
 @pytest.mark.level0
 @pytest.mark.platform_x86_gpu_training
 @pytest.mark.platform_x86_cpu